@@ -0,0 +1,681 @@
+//============================================================================
+/// \file   DockingBenchmarks.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockingBenchmarks
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingBenchmarks.h"
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QLabel>
+#include <QMainWindow>
+#include <QtTest>
+
+#include <cmath>
+#include <memory>
+
+#include "DockAreaWidget.h"
+#include "DockComponentsFactory.h"
+#include "DockContainerWidget.h"
+#include "DockSplitter.h"
+#include "DockWidget.h"
+#include "ElidingLabel.h"
+
+using namespace ads;
+
+namespace
+{
+/**
+ * Main window with a dock manager that is shown on the offscreen platform
+ */
+struct BenchmarkWindow
+{
+    std::unique_ptr<QMainWindow> MainWindow;
+    CDockManager* DockManager = nullptr;
+
+    BenchmarkWindow() : MainWindow(new QMainWindow())
+    {
+        DockManager = new CDockManager(MainWindow.get());
+        MainWindow->resize(1600, 1000);
+        MainWindow->show();
+    }
+};
+
+/**
+ * Gives access to the protected CDockContainerWidget::dropWidget() function
+ * that is used by the drag and drop implementation
+ */
+struct DropWidgetAccess : public CDockContainerWidget
+{
+    using CDockContainerWidget::dropWidget;
+};
+
+//============================================================================
+CDockWidget* createDockWidget(int Index)
+{
+    auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(Index));
+    DockWidget->setWidget(new QLabel(QString("Content %1").arg(Index)));
+    return DockWidget;
+}
+
+//============================================================================
+/**
+ * Adds Count docked dock widgets that are grouped into roughly sqrt(Count)
+ * tabbed dock areas and FloatingCount floating dock widgets
+ */
+QVector<CDockWidget*> populate(CDockManager* DockManager, int Count,
+                               int FloatingCount = 0)
+{
+    QVector<CDockWidget*> DockWidgets;
+    DockWidgets.reserve(Count + FloatingCount);
+    const int TabsPerArea = qMax(1, int(std::lround(std::sqrt(double(Count)))));
+    CDockAreaWidget* DockArea = nullptr;
+    for (int i = 0; i < Count; ++i)
+    {
+        auto DockWidget = createDockWidget(i);
+        if (i % TabsPerArea == 0)
+        {
+            auto Area = ((i / TabsPerArea) % 2) ? RightDockWidgetArea
+                                                : BottomDockWidgetArea;
+            DockArea = DockManager->addDockWidget(Area, DockWidget);
+        }
+        else
+        {
+            DockManager->addDockWidgetTabToArea(DockWidget, DockArea);
+        }
+        DockWidgets.append(DockWidget);
+    }
+
+    for (int i = 0; i < FloatingCount; ++i)
+    {
+        auto DockWidget = createDockWidget(Count + i);
+        DockManager->addDockWidgetFloating(DockWidget);
+        DockWidgets.append(DockWidget);
+    }
+
+    return DockWidgets;
+}
+
+//============================================================================
+/**
+ * Measures AddDockWidgets with a fresh window in each iteration. The window
+ * is created and destroyed outside of the measured time, so the windows of
+ * previous iterations do not accumulate and slow down later iterations
+ */
+template <class Function>
+void benchmarkInFreshWindow(Function AddDockWidgets)
+{
+    const int Iterations = 5;
+    qint64 Elapsed = 0;
+    for (int i = 0; i < Iterations; ++i)
+    {
+        BenchmarkWindow Window;
+        QElapsedTimer Timer;
+        Timer.start();
+        AddDockWidgets(Window.DockManager);
+        Elapsed += Timer.nsecsElapsed();
+    }
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QTest::setBenchmarkResult(double(Elapsed) / Iterations / 1000000.0,
+                              QTest::WalltimeMilliseconds);
+}
+
+//============================================================================
+void addCountRows()
+{
+    QTest::addColumn<int>("Count");
+    for (int Count : {10, 100, 1000, 5000})
+    {
+        QTest::newRow(QByteArray::number(Count).constData()) << Count;
+    }
+}
+
+//============================================================================
+void addLayoutRows()
+{
+    QTest::addColumn<int>("Count");
+    QTest::addColumn<int>("FloatingCount");
+    for (int Count : {10, 100, 1000, 5000})
+    {
+        QTest::newRow(QByteArray::number(Count).constData()) << Count << 0;
+    }
+    QTest::newRow("100+50 floating") << 100 << 50;
+    QTest::newRow("1000+200 floating") << 1000 << 200;
+}
+}  // namespace
+
+//============================================================================
+void CDockingBenchmarks::addMetric(const QString& Metric, double Value)
+{
+    QJsonObject Result;
+    Result["benchmark"] = QString(QTest::currentTestFunction());
+    Result["tag"] = QString(QTest::currentDataTag());
+    Result["metric"] = Metric;
+    Result["value"] = Value;
+    Result["iterations"] = 1;
+    Metrics.append(Result);
+}
+
+//============================================================================
+void CDockingBenchmarks::init()
+{
+    ConfigFlags = CDockManager::configFlags();
+    PerformanceFlags = CDockManager::performanceConfigFlags();
+}
+
+//============================================================================
+void CDockingBenchmarks::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setConfigFlags(ConfigFlags);
+    CDockManager::setPerformanceConfigFlags(PerformanceFlags);
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidget_data()
+{
+    addCountRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidget()
+{
+    QFETCH(int, Count);
+    benchmarkInFreshWindow([Count](CDockManager* DockManager)
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            auto Area = (i % 2) ? RightDockWidgetArea : BottomDockWidgetArea;
+            DockManager->addDockWidget(Area, createDockWidget(i));
+        }
+    });
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidgetTab_data()
+{
+    addCountRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidgetTab()
+{
+    QFETCH(int, Count);
+    benchmarkInFreshWindow([Count](CDockManager* DockManager)
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            DockManager->addDockWidgetTab(CenterDockWidgetArea,
+                                          createDockWidget(i));
+        }
+    });
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidgetInLayoutUpdate_data()
+{
+    addCountRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidgetInLayoutUpdate()
+{
+    QFETCH(int, Count);
+    benchmarkInFreshWindow([Count](CDockManager* DockManager)
+    {
+        CDockLayoutUpdateGuard LayoutUpdate(DockManager);
+        populate(DockManager, Count);
+    });
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidgetFloating_data()
+{
+    QTest::addColumn<int>("Count");
+    for (int Count : {10, 50, 200})
+    {
+        QTest::newRow(QByteArray::number(Count).constData()) << Count;
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::addDockWidgetFloating()
+{
+    QFETCH(int, Count);
+    benchmarkInFreshWindow([Count](CDockManager* DockManager)
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            DockManager->addDockWidgetFloating(createDockWidget(i));
+        }
+    });
+}
+
+//============================================================================
+void CDockingBenchmarks::removeDockWidget_data()
+{
+    addCountRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::removeDockWidget()
+{
+    QFETCH(int, Count);
+    BenchmarkWindow Window;
+    auto DockWidgets = populate(Window.DockManager, Count);
+    QBENCHMARK_ONCE
+    {
+        for (auto DockWidget : DockWidgets)
+        {
+            Window.DockManager->removeDockWidget(DockWidget);
+        }
+    }
+    qDeleteAll(DockWidgets);
+}
+
+//============================================================================
+void CDockingBenchmarks::saveState_data()
+{
+    addLayoutRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::saveState()
+{
+    QFETCH(int, Count);
+    QFETCH(int, FloatingCount);
+    BenchmarkWindow Window;
+    populate(Window.DockManager, Count, FloatingCount);
+    QBENCHMARK
+    {
+        Window.DockManager->saveState();
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::restoreState_data()
+{
+    addLayoutRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::restoreState()
+{
+    QFETCH(int, Count);
+    QFETCH(int, FloatingCount);
+    BenchmarkWindow Window;
+    populate(Window.DockManager, Count, FloatingCount);
+    const auto State = Window.DockManager->saveState();
+    QBENCHMARK
+    {
+        QVERIFY(Window.DockManager->restoreState(State));
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::saveStateAsync_data()
+{
+    addLayoutRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::saveStateAsync()
+{
+    QFETCH(int, Count);
+    QFETCH(int, FloatingCount);
+    BenchmarkWindow Window;
+    populate(Window.DockManager, Count, FloatingCount);
+    // Only the snapshot on the GUI thread is measured - the serialization
+    // runs on the worker thread
+    int Requested = 0;
+    int Finished = 0;
+    QBENCHMARK
+    {
+        Window.DockManager->saveStateAsync(
+            [&Finished](const QByteArray&) { ++Finished; });
+        ++Requested;
+    }
+    QTRY_COMPARE(Finished, Requested);
+}
+
+//============================================================================
+void CDockingBenchmarks::openPerspective_data()
+{
+    addLayoutRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::openPerspective()
+{
+    QFETCH(int, Count);
+    QFETCH(int, FloatingCount);
+    BenchmarkWindow Window;
+    auto DockWidgets = populate(Window.DockManager, Count, FloatingCount);
+    Window.DockManager->addPerspective("Layout");
+
+    // The second perspective has all dock widgets in a single dock area
+    auto DockArea = DockWidgets.first()->dockAreaWidget();
+    for (auto DockWidget : DockWidgets)
+    {
+        if (DockWidget->dockAreaWidget() != DockArea)
+        {
+            Window.DockManager->addDockWidgetTabToArea(DockWidget, DockArea);
+        }
+    }
+    Window.DockManager->addPerspective("Tabbed");
+
+    QBENCHMARK
+    {
+        Window.DockManager->openPerspective("Layout");
+        Window.DockManager->openPerspective("Tabbed");
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::toggleView_data()
+{
+    addCountRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::toggleView()
+{
+    QFETCH(int, Count);
+    BenchmarkWindow Window;
+    auto DockWidgets = populate(Window.DockManager, Count);
+    QBENCHMARK
+    {
+        for (auto DockWidget : DockWidgets)
+        {
+            DockWidget->toggleView(false);
+        }
+        for (auto DockWidget : DockWidgets)
+        {
+            DockWidget->toggleView(true);
+        }
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::queryDockWidgets_data()
+{
+    addCountRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::queryDockWidgets()
+{
+    QFETCH(int, Count);
+    BenchmarkWindow Window;
+    populate(Window.DockManager, Count);
+
+    // The queries that the drag, focus and restore code issues for each
+    // event
+    int Result = 0;
+    QBENCHMARK
+    {
+        Result += Window.DockManager->openedDockAreas().count();
+        Result += Window.DockManager->openedDockWidgets().count();
+        Result += Window.DockManager->dockWidgets().count();
+        Result += Window.DockManager->hasTopLevelDockWidget() ? 1 : 0;
+        Result += Window.DockManager->visibleDockAreaCount();
+    }
+    QVERIFY(Result > 0);
+}
+
+//============================================================================
+void CDockingBenchmarks::dropWidget_data()
+{
+    addCountRows();
+}
+
+//============================================================================
+void CDockingBenchmarks::dropWidget()
+{
+    QFETCH(int, Count);
+    BenchmarkWindow Window;
+    auto DockWidgets = populate(Window.DockManager, Count);
+    auto DockManager = static_cast<CDockContainerWidget*>(Window.DockManager);
+    auto DropWidget = &DropWidgetAccess::dropWidget;
+
+    // The first dock area always contains more than one dock widget, so it
+    // survives if the dragged dock widget leaves it
+    auto DockWidget = DockWidgets.first();
+    auto SourceArea = DockWidget->dockAreaWidget();
+    auto TargetArea = DockWidgets.last()->dockAreaWidget();
+    QVERIFY(SourceArea != TargetArea);
+    QVERIFY(SourceArea->dockWidgetsCount() > 1);
+    QBENCHMARK
+    {
+        // Drop as tab into the target area, then split the target area and
+        // finally move the dock widget back into the source area
+        (DockManager->*DropWidget)(DockWidget, CenterDockWidgetArea,
+                                   TargetArea, -1);
+        (DockManager->*DropWidget)(DockWidget, RightDockWidgetArea,
+                                   TargetArea, -1);
+        (DockManager->*DropWidget)(DockWidget, CenterDockWidgetArea,
+                                   SourceArea, -1);
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::focusStylePolishCount_data()
+{
+    QTest::addColumn<bool>("Batched");
+    QTest::addColumn<int>("HopsPerEventLoop");
+    QTest::newRow("immediate, 1 hop") << false << 1;
+    QTest::newRow("batched, 1 hop") << true << 1;
+    QTest::newRow("immediate, 5 hops") << false << 5;
+    QTest::newRow("batched, 5 hops") << true << 5;
+}
+
+//============================================================================
+void CDockingBenchmarks::focusStylePolishCount()
+{
+    QFETCH(bool, Batched);
+    QFETCH(int, HopsPerEventLoop);
+    CDockManager::setConfigFlag(CDockManager::FocusHighlighting, true);
+    CDockManager::setPerformanceConfigFlag(
+        CDockManager::BatchedFocusStyleUpdates, Batched);
+    BenchmarkWindow Window;
+    auto DockWidgets = populate(Window.DockManager, 100);
+    QCoreApplication::processEvents();
+
+    // Reports the number of repolish operations per focus change. With
+    // several hops per event loop iteration, the focus moves over multiple
+    // dock widgets before the application processes events again, like
+    // during fast keyboard navigation
+    Window.DockManager->resetFocusStylePolishCount();
+    int Hops = 0;
+    for (auto DockWidget : DockWidgets)
+    {
+        Window.DockManager->setDockWidgetFocused(DockWidget);
+        if (++Hops % HopsPerEventLoop == 0)
+        {
+            QCoreApplication::processEvents();
+        }
+    }
+    QCoreApplication::processEvents();
+    QTest::setBenchmarkResult(
+        qreal(Window.DockManager->focusStylePolishCount()) / Hops,
+        QTest::Events);
+}
+
+//============================================================================
+void CDockingBenchmarks::switchTabs_data()
+{
+    QTest::addColumn<bool>("Virtualized");
+    QTest::addColumn<int>("Count");
+    for (int Count : {10, 100, 500})
+    {
+        QTest::newRow(QByteArray::number(Count).constData()) << false << Count;
+        QTest::newRow((QByteArray::number(Count) + " virtualized").constData())
+            << true << Count;
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::switchTabs()
+{
+    QFETCH(bool, Virtualized);
+    QFETCH(int, Count);
+    CDockManager::setPerformanceConfigFlag(CDockManager::VirtualizedTabBar,
+                                           Virtualized);
+    BenchmarkWindow Window;
+    CDockAreaWidget* DockArea = nullptr;
+    for (int i = 0; i < Count; ++i)
+    {
+        DockArea = Window.DockManager->addDockWidgetTab(CenterDockWidgetArea,
+                                                        createDockWidget(i));
+    }
+    QCoreApplication::processEvents();
+
+    // Activates tabs from both ends of the tab strip, so the strip needs to
+    // scroll for each tab change
+    QBENCHMARK
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            DockArea->setCurrentIndex((i % 2) ? i : Count - 1 - i);
+            QCoreApplication::processEvents();
+        }
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::paintedTabs_data()
+{
+    QTest::addColumn<bool>("Painted");
+    QTest::addColumn<int>("Count");
+    for (int Count : {100, 1000})
+    {
+        QTest::newRow(QByteArray::number(Count).constData()) << false << Count;
+        QTest::newRow((QByteArray::number(Count) + " painted").constData())
+            << true << Count;
+    }
+}
+
+//============================================================================
+void CDockingBenchmarks::paintedTabs()
+{
+    QFETCH(bool, Painted);
+    QFETCH(int, Count);
+    if (Painted)
+    {
+        CDockComponentsFactory::setFactory(new CFlyweightDockComponentsFactory());
+    }
+
+    // Reports the time for creating and laying out the layout. The number of
+    // widgets per dock widget is added to the JSON report
+    int WidgetCount = 0;
+    QBENCHMARK_ONCE
+    {
+        BenchmarkWindow Window;
+        populate(Window.DockManager, Count);
+        QCoreApplication::processEvents();
+        WidgetCount = Window.MainWindow->findChildren<QWidget*>().count();
+    }
+    CDockComponentsFactory::resetDefaultFactory();
+    addMetric("WidgetsPerDockWidget", double(WidgetCount) / Count);
+}
+
+//============================================================================
+void CDockingBenchmarks::resizeElidedTabs_data()
+{
+    QTest::addColumn<bool>("Painted");
+    QTest::newRow("widget tabs") << false;
+    QTest::newRow("painted tabs") << true;
+}
+
+//============================================================================
+void CDockingBenchmarks::resizeElidedTabs()
+{
+    QFETCH(bool, Painted);
+    if (Painted)
+    {
+        CDockComponentsFactory::setFactory(new CFlyweightDockComponentsFactory());
+    }
+    BenchmarkWindow Window;
+    populate(Window.DockManager, 400);
+    QCoreApplication::processEvents();
+
+    // Shrinks and grows the window, like a splitter or window drag, so that
+    // the tab titles are elided to the same widths again and again
+    CElidingLabel::clearElidedTextCache();
+    CElidingLabel::resetElidedTextCacheCounters();
+    QBENCHMARK
+    {
+        for (int Width = 1600; Width >= 800; Width -= 40)
+        {
+            Window.MainWindow->resize(Width, 1000);
+            QCoreApplication::processEvents();
+        }
+        Window.MainWindow->resize(1600, 1000);
+        QCoreApplication::processEvents();
+    }
+    CDockComponentsFactory::resetDefaultFactory();
+
+    auto Hits = CElidingLabel::elidedTextCacheHitCount();
+    auto Misses = CElidingLabel::elidedTextCacheMissCount();
+    addMetric("ElidedTextCacheHitRate",
+              double(Hits) / qMax<quint64>(1, Hits + Misses));
+    addMetric("SkippedSetTextCalls",
+              double(CElidingLabel::skippedSetTextCount()));
+}
+
+//============================================================================
+void CDockingBenchmarks::dragSplitterHandle_data()
+{
+    QTest::addColumn<bool>("Frozen");
+    QTest::newRow("opaque") << false;
+    QTest::newRow("frozen") << true;
+}
+
+//============================================================================
+void CDockingBenchmarks::dragSplitterHandle()
+{
+    QFETCH(bool, Frozen);
+    CDockManager::setConfigFlag(CDockManager::OpaqueSplitterResize, true);
+    CDockManager::setPerformanceConfigFlag(CDockManager::FrozenLiveResize,
+                                           Frozen);
+    BenchmarkWindow Window;
+    populate(Window.DockManager, 400);
+    QCoreApplication::processEvents();
+
+    CDockSplitter* Splitter = nullptr;
+    for (auto s : Window.DockManager->findChildren<CDockSplitter*>())
+    {
+        if (s->count() > 1 && s->handle(1)->isVisible())
+        {
+            Splitter = s;
+            break;
+        }
+    }
+    QVERIFY(Splitter);
+
+    // Drags the first handle over 100 pixels and back, like a user who
+    // explores the layout, and releases it at the start position
+    auto Handle = Splitter->handle(1);
+    auto Center = Handle->rect().center();
+    auto Step = (Splitter->orientation() == Qt::Horizontal) ? QPoint(4, 0)
+                                                            : QPoint(0, 4);
+    QBENCHMARK
+    {
+        QTest::mousePress(Handle, Qt::LeftButton, Qt::NoModifier, Center);
+        for (int i = -25; i < 25; ++i)
+        {
+            QTest::mouseMove(Handle, Center + Step * (25 - qAbs(i)));
+            QCoreApplication::processEvents();
+        }
+        QTest::mouseRelease(Handle, Qt::LeftButton, Qt::NoModifier, Center);
+        QCoreApplication::processEvents();
+    }
+}
+
+//---------------------------------------------------------------------------
+// EOF DockingBenchmarks.cpp
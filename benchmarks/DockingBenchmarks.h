@@ -0,0 +1,86 @@
+#ifndef DockingBenchmarksH
+#define DockingBenchmarksH
+//============================================================================
+/// \file   DockingBenchmarks.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockingBenchmarks
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QJsonArray>
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest benchmarks for the docking operations of the dock manager at
+ * scale. Each benchmark is data driven with the number of dock widgets in
+ * the layout.
+ */
+class CDockingBenchmarks : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::ConfigFlags ConfigFlags;
+    ads::CDockManager::PerformanceFlags PerformanceFlags;
+    QJsonArray Metrics;
+
+    /**
+     * Records an additional metric of the current benchmark and data row
+     * that is not measured by QBENCHMARK
+     */
+    void addMetric(const QString& Metric, double Value);
+
+public:
+    /**
+     * Returns the additional metrics that the benchmarks recorded.
+     * Each entry has the same fields as the benchmark results of the
+     * JSON report
+     */
+    const QJsonArray& metrics() const { return Metrics; }
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void addDockWidget_data();
+    void addDockWidget();
+    void addDockWidgetTab_data();
+    void addDockWidgetTab();
+    void addDockWidgetInLayoutUpdate_data();
+    void addDockWidgetInLayoutUpdate();
+    void addDockWidgetFloating_data();
+    void addDockWidgetFloating();
+    void removeDockWidget_data();
+    void removeDockWidget();
+    void saveState_data();
+    void saveState();
+    void restoreState_data();
+    void restoreState();
+    void saveStateAsync_data();
+    void saveStateAsync();
+    void openPerspective_data();
+    void openPerspective();
+    void toggleView_data();
+    void toggleView();
+    void queryDockWidgets_data();
+    void queryDockWidgets();
+    void dropWidget_data();
+    void dropWidget();
+    void focusStylePolishCount_data();
+    void focusStylePolishCount();
+    void switchTabs_data();
+    void switchTabs();
+    void paintedTabs_data();
+    void paintedTabs();
+    void resizeElidedTabs_data();
+    void resizeElidedTabs();
+    void dragSplitterHandle_data();
+    void dragSplitterHandle();
+};
+
+//---------------------------------------------------------------------------
+#endif  // DockingBenchmarksH
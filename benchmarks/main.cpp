@@ -0,0 +1,164 @@
+//============================================================================
+/// \file   main.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Runs the docking benchmarks and writes the results as JSON
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryFile>
+#include <QXmlStreamReader>
+#include <QtTest>
+
+#include "DockingBenchmarks.h"
+
+//============================================================================
+/**
+ * Converts the benchmark results of the QtTest XML log into a JSON report
+ * and appends the additional Metrics of the benchmarks to the results.
+ * If JsonFileName is "-", the report is written to stdout
+ */
+static bool writeJsonReport(const QString& XmlFileName,
+                            const QString& JsonFileName, int ExitCode,
+                            const QJsonArray& Metrics)
+{
+    QFile XmlFile(XmlFileName);
+    if (!XmlFile.open(QIODevice::ReadOnly))
+    {
+        qCritical() << "Failed to read benchmark log" << XmlFileName;
+        return false;
+    }
+
+    QJsonArray Results;
+    QString Benchmark;
+    QXmlStreamReader Xml(&XmlFile);
+    while (!Xml.atEnd())
+    {
+        Xml.readNext();
+        if (!Xml.isStartElement())
+        {
+            continue;
+        }
+
+        const auto Attributes = Xml.attributes();
+        if (Xml.name() == QLatin1String("TestFunction"))
+        {
+            Benchmark = Attributes.value("name").toString();
+        }
+        else if (Xml.name() == QLatin1String("BenchmarkResult"))
+        {
+            QJsonObject Result;
+            Result["benchmark"] = Benchmark;
+            Result["tag"] = Attributes.value("tag").toString();
+            Result["metric"] = Attributes.value("metric").toString();
+            Result["value"] = Attributes.value("value").toDouble();
+            Result["iterations"] = Attributes.value("iterations").toInt();
+            Results.append(Result);
+        }
+    }
+
+    if (Xml.hasError())
+    {
+        qCritical() << "Failed to parse benchmark log:" << Xml.errorString();
+        return false;
+    }
+
+    for (const auto& Metric : Metrics)
+    {
+        Results.append(Metric);
+    }
+
+    QJsonObject Report;
+    Report["qtVersion"] = QString(qVersion());
+    Report["platform"] = QGuiApplication::platformName();
+    Report["timestamp"] =
+        QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    Report["exitCode"] = ExitCode;
+    Report["results"] = Results;
+    const auto Json = QJsonDocument(Report).toJson(QJsonDocument::Indented);
+
+    QFile JsonFile;
+    bool Opened = false;
+    if (JsonFileName == "-")
+    {
+        Opened = JsonFile.open(stdout, QIODevice::WriteOnly);
+    }
+    else
+    {
+        JsonFile.setFileName(JsonFileName);
+        Opened = JsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!Opened)
+    {
+        qCritical() << "Failed to write benchmark report" << JsonFileName;
+        return false;
+    }
+
+    JsonFile.write(Json);
+    return true;
+}
+
+//============================================================================
+/**
+ * Usage: ads_benchmarks [--json <file>|-] [QtTest options] [functions]
+ * The JSON report is written to ads_benchmarks.json by default.
+ */
+int main(int argc, char* argv[])
+{
+    // Run headless by default, so the benchmarks also run on CI machines
+    // without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication App(argc, argv);
+
+    QStringList Arguments = App.arguments();
+    QString JsonFileName = "ads_benchmarks.json";
+    const int JsonIndex = Arguments.indexOf("--json");
+    if (JsonIndex >= 0)
+    {
+        if (JsonIndex + 1 >= Arguments.count())
+        {
+            qCritical() << "Missing file name for --json";
+            return 1;
+        }
+        JsonFileName = Arguments.at(JsonIndex + 1);
+        Arguments.removeAt(JsonIndex + 1);
+        Arguments.removeAt(JsonIndex);
+    }
+
+    QTemporaryFile XmlFile;
+    if (!XmlFile.open())
+    {
+        qCritical() << "Failed to create the benchmark log file";
+        return 1;
+    }
+    XmlFile.close();
+
+    Arguments << "-o" << XmlFile.fileName() + ",xml";
+    if (JsonFileName != "-")
+    {
+        Arguments << "-o" << "-,txt";
+    }
+
+    CDockingBenchmarks Benchmarks;
+    const int ExitCode = QTest::qExec(&Benchmarks, Arguments);
+    if (!writeJsonReport(XmlFile.fileName(), JsonFileName, ExitCode,
+                         Benchmarks.metrics()))
+    {
+        return ExitCode ? ExitCode : 1;
+    }
+    return ExitCode;
+}
+
+//---------------------------------------------------------------------------
+// EOF main.cpp
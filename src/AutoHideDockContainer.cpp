@@ -34,7 +34,6 @@
 #include <QPainter>
 #include <QPointer>
 #include <QSplitter>
-#include <QXmlStreamWriter>
 
 #include <iostream>
 
@@ -42,8 +41,11 @@
 #include "AutoHideTab.h"
 #include "DockAreaWidget.h"
 #include "DockComponentsFactory.h"
+#include "DockInputDispatcher.h"
 #include "DockManager.h"
 #include "DockSplitter.h"
+#include "DockingStateReader.h"
+#include "DockingStateWriter.h"
 #include "ResizeHandle.h"
 
 namespace ads
@@ -111,6 +113,7 @@ struct AutoHideDockContainerPrivate
     QSize Size;  // creates invalid size
     QPointer<CAutoHideTab> SideTab;
     QSize SizeCache;
+    QPointer<CDockInputDispatcher> InputDispatcher;
 
     /**
      * Private data constructor
@@ -146,6 +149,43 @@ struct AutoHideDockContainerPrivate
         ResizeHandle->setMaxResizeSize(maxResizeHandleSize - ResizeMargin);
     }
 
+    /**
+     * Registers the container and its resize handle at the input dispatcher
+     * of the dock manager, to receive the application wide input events
+     * while the container is visible
+     */
+    void registerInputClients()
+    {
+        auto DockManager = DockWidget->dockManager();
+        if (!DockManager)
+        {
+            return;
+        }
+
+        InputDispatcher = DockManager->dockInputDispatcher();
+        InputDispatcher->registerClient(_this,
+            CDockInputDispatcher::MouseButtonPressEvents
+                | CDockInputDispatcher::ScopeResizeEvents
+                | CDockInputDispatcher::DragStartEvents,
+            _this->dockContainer());
+        InputDispatcher->registerClient(ResizeHandle,
+            CDockInputDispatcher::MouseMoveEvents);
+    }
+
+    /**
+     * Removes the container and its resize handle from the input dispatcher
+     */
+    void unregisterInputClients()
+    {
+        if (!InputDispatcher)
+        {
+            return;
+        }
+
+        InputDispatcher->unregisterClient(_this);
+        InputDispatcher->unregisterClient(ResizeHandle);
+    }
+
     /**
      * Convenience function to check, if this is an horizontal area
      */
@@ -206,6 +246,8 @@ CAutoHideDockContainer::CAutoHideDockContainer(CDockWidget* DockWidget,
     bool OpaqueResize =
         CDockManager::testConfigFlag(CDockManager::OpaqueSplitterResize);
     d->ResizeHandle->setOpaqueResize(OpaqueResize);
+    d->ResizeHandle->setFreezeContent(OpaqueResize
+        && CDockManager::testPerformanceConfigFlag(CDockManager::FrozenLiveResize));
     d->Size = d->DockArea->size();
     d->SizeCache = DockWidget->size();
 
@@ -280,8 +322,9 @@ CAutoHideDockContainer::~CAutoHideDockContainer()
 {
     ADS_PRINT("~CAutoHideDockContainer");
 
-    // Remove event filter in case there are any queued messages
-    qApp->removeEventFilter(this);
+    // Unregister from the input dispatcher in case there are any queued
+    // messages
+    d->unregisterInputClients();
     if (dockContainer())
     {
         dockContainer()->removeAutoHideWidget(this);
@@ -475,14 +518,16 @@ void CAutoHideDockContainer::cleanupAndDelete()
 //============================================================================
 void CAutoHideDockContainer::saveState(QXmlStreamWriter& s)
 {
-    s.writeStartElement("Widget");
-    s.writeAttribute("Name", d->DockWidget->objectName());
-    s.writeAttribute("Closed",
-                     QString::number(d->DockWidget->isClosed() ? 1 : 0));
-    s.writeAttribute(
-        "Size",
-        QString::number(d->isHorizontal() ? d->Size.height() : d->Size.width()));
-    s.writeEndElement();
+    DockWidgetState State;
+    saveState(State);
+    CDockingStateWriter::writeDockWidget(s, State, true);
+}
+
+//============================================================================
+void CAutoHideDockContainer::saveState(DockWidgetState& State)
+{
+    d->DockWidget->saveState(State);
+    State.Size = d->isHorizontal() ? d->Size.height() : d->Size.width();
 }
 
 //============================================================================
@@ -502,7 +547,7 @@ void CAutoHideDockContainer::toggleView(bool Enable)
             d->SideTab->hide();
         }
         hide();
-        qApp->removeEventFilter(this);
+        d->unregisterInputClients();
     }
 }
 
@@ -512,7 +557,7 @@ void CAutoHideDockContainer::collapseView(bool Enable)
     if (Enable)
     {
         hide();
-        qApp->removeEventFilter(this);
+        d->unregisterInputClients();
     }
     else
     {
@@ -521,7 +566,7 @@ void CAutoHideDockContainer::collapseView(bool Enable)
         raise();
         show();
         d->DockWidget->dockManager()->setDockWidgetFocused(d->DockWidget);
-        qApp->installEventFilter(this);
+        d->registerInputClients();
     }
 
     ADS_PRINT("CAutoHideDockContainer::collapseView " << Enable);
@@ -44,6 +44,7 @@ class CDockContainerWidget;
 class CAutoHideSideBar;
 class CDockAreaWidget;
 class CDockingStateReader;
+struct DockWidgetState;
 struct SideTabBarPrivate;
 
 /**
@@ -75,6 +76,11 @@ protected:
      */
     void saveState(QXmlStreamWriter& Stream);
 
+    /*
+     * Saves the state and size into the given in-memory dock widget state
+     */
+    void saveState(DockWidgetState& State);
+
 public:
     using Super = QFrame;
 
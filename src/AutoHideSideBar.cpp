@@ -33,7 +33,6 @@
 #include <QPainter>
 #include <QScrollBar>
 #include <QStyleOption>
-#include <QXmlStreamWriter>
 
 #include "AutoHideDockContainer.h"
 #include "AutoHideTab.h"
@@ -42,6 +41,7 @@
 #include "DockFocusController.h"
 #include "DockWidgetTab.h"
 #include "DockingStateReader.h"
+#include "DockingStateWriter.h"
 
 namespace ads
 {
@@ -207,6 +207,11 @@ void CAutoHideSideBar::insertTab(int Index, CAutoHideTab* SideTab)
         d->TabsLayout->insertWidget(Index, SideTab);
     }
 	show();
+    auto DockManager = d->ContainerWidget->dockManager();
+    if (DockManager)
+    {
+        DockManager->notifyLayoutMutation(d->ContainerWidget);
+    }
 }
 
 //============================================================================
@@ -277,6 +282,11 @@ void CAutoHideSideBar::removeTab(CAutoHideTab* SideTab)
     {
         hide();
     }
+    auto DockManager = d->ContainerWidget->dockManager();
+    if (DockManager)
+    {
+        DockManager->notifyLayoutMutation(d->ContainerWidget);
+    }
 }
 
 void CAutoHideSideBar::wheelEvent(QWheelEvent* Event)
@@ -387,15 +397,15 @@ SideBarLocation CAutoHideSideBar::sideBarLocation() const
 //============================================================================
 void CAutoHideSideBar::saveState(QXmlStreamWriter& s) const
 {
-    if (!count())
-    {
-        return;
-    }
-
-    s.writeStartElement("SideBar");
-    s.writeAttribute("Area", QString::number(sideBarLocation()));
-    s.writeAttribute("Tabs", QString::number(count()));
+    SideBarState State;
+    saveState(State);
+    CDockingStateWriter::writeSideBar(s, State);
+}
 
+//============================================================================
+void CAutoHideSideBar::saveState(SideBarState& State) const
+{
+    State.Area = sideBarLocation();
     for (auto i = 0; i < count(); ++i)
     {
         auto Tab = tab(i);
@@ -404,10 +414,10 @@ void CAutoHideSideBar::saveState(QXmlStreamWriter& s) const
             continue;
         }
 
-        Tab->dockWidget()->autoHideDockContainer()->saveState(s);
+        DockWidgetState WidgetState;
+        Tab->dockWidget()->autoHideDockContainer()->saveState(WidgetState);
+        State.DockWidgets.append(WidgetState);
     }
-
-    s.writeEndElement();
 }
 
 //===========================================================================
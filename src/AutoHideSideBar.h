@@ -43,6 +43,7 @@ class CDockContainerWidget;
 class CAutoHideTab;
 class CAutoHideDockContainer;
 class CDockingStateReader;
+struct SideBarState;
 
 /**
  * Side tab bar widget that is shown at the edges of a dock container.
@@ -78,6 +79,11 @@ protected:
      */
     void saveState(QXmlStreamWriter& Stream) const;
 
+    /**
+     * Saves the state into the given in-memory side bar state
+     */
+    void saveState(SideBarState& State) const;
+
     /**
      * Inserts the given dock widget tab at the given position.
      * An Index value of -1 appends the side tab at the end.
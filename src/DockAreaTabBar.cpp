@@ -32,11 +32,14 @@
 #include <QBoxLayout>
 #include <QDebug>
 #include <QMouseEvent>
+#include <QPointer>
 #include <QScrollBar>
 #include <QSet>
 #include <QTimer>
+#include <QVector>
 #include <QtGlobal>
 
+#include <algorithm>
 #include <iostream>
 
 #include "DockAreaWidget.h"
@@ -49,6 +52,238 @@
 
 namespace ads
 {
+/**
+ * Horizontal tabs layout of the virtualized tab strip.
+ * The layout caches the size hints of the tabs and the resulting tab
+ * offsets. Only the tabs that intersect the visible part of the tab bar plus
+ * a margin are positioned. All other tabs are parked left of the tabs
+ * container widget where they are clipped, so they are neither moved nor
+ * painted if the tab strip is scrolled or changed.
+ * The tabs always get their preferred width - if the tabs do not fit into
+ * the tab bar, the tab strip scrolls.
+ */
+class CVirtualTabsLayout : public QLayout
+{
+private:
+    QList<QLayoutItem*> Items;
+    QVector<QSize> Sizes;  ///< cached size hints, invalid if outdated
+    QVector<int> Offsets;  ///< start offsets, Offsets[count()] is the width
+    int Height = 0;
+    bool OffsetsValid = false;
+    QList<QPointer<QWidget>> PlacedWidgets;
+
+    void updateOffsets()
+    {
+        Offsets.resize(Items.count() + 1);
+        int Offset = 0;
+        Height = 0;
+        for (int i = 0; i < Items.count(); ++i)
+        {
+            if (!Sizes[i].isValid())
+            {
+                Sizes[i] = Items[i]->isEmpty() ? QSize(0, 0) :
+                                                 Items[i]->sizeHint();
+            }
+            Offsets[i] = Offset;
+            Offset += Sizes[i].width();
+            Height = qMax(Height, Sizes[i].height());
+        }
+        Offsets[Items.count()] = Offset;
+        OffsetsValid = true;
+    }
+
+    void parkWidget(QWidget* Widget)
+    {
+        Widget->move(-Widget->width() - 1, 0);
+    }
+
+public:
+    /**
+     * Additional width left and right of the visible part of the tab bar in
+     * which tabs are positioned
+     */
+    static const int VisibleMargin = 256;
+
+    /**
+     * Deletes the layout items
+     */
+    ~CVirtualTabsLayout() override
+    {
+        qDeleteAll(Items);
+    }
+
+    /**
+     * Inserts the given widget at the given index
+     */
+    void insertWidget(int Index, QWidget* Widget)
+    {
+        if (Index < 0 || Index > Items.count())
+        {
+            Index = Items.count();
+        }
+        addChildWidget(Widget);
+        parkWidget(Widget);
+        Items.insert(Index, new QWidgetItem(Widget));
+        Sizes.insert(Index, QSize());
+        invalidate();
+    }
+
+    /**
+     * Marks the cached size of the given widget as outdated
+     */
+    void invalidateWidget(QWidget* Widget)
+    {
+        int Index = indexOf(Widget);
+        if (Index >= 0)
+        {
+            Sizes[Index] = QSize();
+            OffsetsValid = false;
+        }
+    }
+
+    /**
+     * Returns the rectangle of the tab with the given index in the
+     * coordinates of the tabs container widget
+     */
+    QRect tabRect(int Index)
+    {
+        if (Index < 0 || Index >= Items.count())
+        {
+            return QRect();
+        }
+        if (!OffsetsValid)
+        {
+            updateOffsets();
+        }
+        return QRect(Offsets[Index], 0, Sizes[Index].width(), Height);
+    }
+
+    /**
+     * Returns the index of the non empty tab at the given x position in the
+     * coordinates of the tabs container widget. Returns -1, if the position
+     * is left of the first tab and count() if it is right of the last tab
+     */
+    int tabIndexAt(int X)
+    {
+        if (!OffsetsValid)
+        {
+            updateOffsets();
+        }
+        if (Items.isEmpty() || X < 0)
+        {
+            return -1;
+        }
+        if (X >= Offsets.last())
+        {
+            return Items.count();
+        }
+        // The first offset greater than X follows the tab that contains X.
+        // Empty tabs share their offset with the next tab, so the last tab
+        // with a start offset less or equal X is the non empty one
+        auto it = std::upper_bound(Offsets.begin(), Offsets.end() - 1, X);
+        return int(it - Offsets.begin()) - 1;
+    }
+
+    /**
+     * Positions the tabs in the currently visible range. Call this if the
+     * tab strip has been scrolled or if the tab bar has been resized
+     */
+    void updateVisibleTabs()
+    {
+        setGeometry(geometry());
+    }
+
+    void addItem(QLayoutItem* Item) override
+    {
+        Items.append(Item);
+        Sizes.append(QSize());
+        invalidate();
+    }
+
+    QLayoutItem* itemAt(int Index) const override
+    {
+        return Items.value(Index);
+    }
+
+    QLayoutItem* takeAt(int Index) override
+    {
+        if (Index < 0 || Index >= Items.count())
+        {
+            return nullptr;
+        }
+        Sizes.remove(Index);
+        OffsetsValid = false;
+        return Items.takeAt(Index);
+    }
+
+    int count() const override
+    {
+        return Items.count();
+    }
+
+    void invalidate() override
+    {
+        OffsetsValid = false;
+        QLayout::invalidate();
+    }
+
+    QSize sizeHint() const override
+    {
+        if (!OffsetsValid)
+        {
+            const_cast<CVirtualTabsLayout*>(this)->updateOffsets();
+        }
+        return QSize(Offsets.last(), Height);
+    }
+
+    QSize minimumSize() const override
+    {
+        return sizeHint();
+    }
+
+    void setGeometry(const QRect& Rect) override
+    {
+        QLayout::setGeometry(Rect);
+        if (!OffsetsValid)
+        {
+            updateOffsets();
+        }
+
+        // The visible range in the coordinates of the tabs container widget
+        auto Container = parentWidget();
+        auto Viewport = Container ? Container->parentWidget() : nullptr;
+        int Left = Container ? -Container->x() : 0;
+        int Right = Left + (Viewport ? Viewport->width() : Rect.width());
+        Left -= VisibleMargin;
+        Right += VisibleMargin;
+
+        QList<QPointer<QWidget>> Placed;
+        auto First = std::upper_bound(Offsets.begin(), Offsets.end() - 1, Left);
+        for (int i = qMax(0, int(First - Offsets.begin()) - 1);
+             i < Items.count() && Offsets[i] < Right; ++i)
+        {
+            if (Items[i]->isEmpty())
+            {
+                continue;
+            }
+            Items[i]->setGeometry(QRect(Rect.x() + Offsets[i], Rect.y(),
+                                        Sizes[i].width(), Rect.height()));
+            Placed.append(Items[i]->widget());
+        }
+
+        for (const auto& Widget : PlacedWidgets)
+        {
+            if (Widget && Widget->parentWidget() == Container
+                && !Placed.contains(Widget))
+            {
+                parkWidget(Widget);
+            }
+        }
+        PlacedWidgets = Placed;
+    }
+};
+
+
 /**
  * Private data class of CDockAreaTabBar class (pimpl)
  */
@@ -57,7 +292,10 @@ struct DockAreaTabBarPrivate
     CDockAreaTabBar* _this;
     CDockAreaWidget* DockArea;
     QWidget* TabsContainerWidget;
-    QBoxLayout* TabsLayout;
+    QLayout* TabsLayout;
+    QBoxLayout* BoxTabsLayout = nullptr;
+    CVirtualTabsLayout* VirtualTabsLayout = nullptr;
+    QPointer<CDockWidgetTab> ActiveTab;
     int CurrentIndex = -1;
     static QSet<CDockWidgetTab*> TempTabWidgets;
     QSet<CDockWidgetTab*> TempTabWidget = {};
@@ -73,6 +311,27 @@ struct DockAreaTabBarPrivate
      */
     void updateTabs();
 
+    /**
+     * Virtualized version of updateTabs() that only updates the previous and
+     * the new active tab and scrolls the active tab into view
+     */
+    void updateVirtualTabs();
+
+    /**
+     * Inserts the tab widget into the tabs layout
+     */
+    void insertTabWidget(int Index, CDockWidgetTab* Tab)
+    {
+        if (VirtualTabsLayout)
+        {
+            VirtualTabsLayout->insertWidget(Index, Tab);
+        }
+        else
+        {
+            BoxTabsLayout->insertWidget(Index, Tab);
+        }
+    }
+
     /**
      * Convenience function to access first tab
      */
@@ -91,9 +350,49 @@ DockAreaTabBarPrivate::DockAreaTabBarPrivate(CDockAreaTabBar* _public)
     : _this(_public)
 {}
 
+//============================================================================
+void DockAreaTabBarPrivate::updateVirtualTabs()
+{
+    auto CurrentTab = _this->tab(CurrentIndex);
+    if (ActiveTab && ActiveTab != CurrentTab)
+    {
+        ActiveTab->setActiveTab(false);
+        VirtualTabsLayout->invalidateWidget(ActiveTab);
+    }
+    ActiveTab = CurrentTab;
+    if (!CurrentTab)
+    {
+        return;
+    }
+
+    CurrentTab->show();
+    CurrentTab->setActiveTab(true);
+    VirtualTabsLayout->invalidateWidget(CurrentTab);
+
+    // The tab may be parked, so we need to scroll to the position from the
+    // layout after the layout has been updated
+    QPointer<CDockWidgetTab> Tab = CurrentTab;
+    QTimer::singleShot(0, _this, [this, Tab] {
+        if (!Tab || Tab != ActiveTab)
+        {
+            return;
+        }
+        TabsLayout->activate();
+        auto Rect = VirtualTabsLayout->tabRect(TabsLayout->indexOf(Tab));
+        _this->ensureVisible(Rect.center().x(), Rect.center().y(),
+                             Rect.width() / 2, 0);
+    });
+}
+
 //============================================================================
 void DockAreaTabBarPrivate::updateTabs()
 {
+    if (VirtualTabsLayout)
+    {
+        updateVirtualTabs();
+        return;
+    }
+
     // Set active TAB and update all other tabs to be inactive
     for (int i = 0; i < _this->count(); ++i)
     {
@@ -142,13 +441,30 @@ CDockAreaTabBar::CDockAreaTabBar(CDockAreaWidget* parent)
     d->TabsContainerWidget->setSizePolicy(QSizePolicy::Preferred,
                                           QSizePolicy::Preferred);
     d->TabsContainerWidget->setObjectName("tabsContainerWidget");
-    d->TabsLayout = new QBoxLayout(QBoxLayout::LeftToRight);
+    if (CDockManager::testPerformanceConfigFlag(CDockManager::VirtualizedTabBar))
+    {
+        d->VirtualTabsLayout = new CVirtualTabsLayout();
+        d->TabsLayout = d->VirtualTabsLayout;
+    }
+    else
+    {
+        d->BoxTabsLayout = new QBoxLayout(QBoxLayout::LeftToRight);
+        d->BoxTabsLayout->setSpacing(0);
+        d->BoxTabsLayout->addStretch(1);
+        d->TabsLayout = d->BoxTabsLayout;
+    }
     d->TabsLayout->setContentsMargins(0, 0, 0, 0);
-    d->TabsLayout->setSpacing(0);
-    d->TabsLayout->addStretch(1);
     d->TabsContainerWidget->setLayout(d->TabsLayout);
     setWidget(d->TabsContainerWidget);
 
+    if (d->VirtualTabsLayout)
+    {
+        // Scrolling and resizing changes the range of positioned tabs
+        connect(horizontalScrollBar(), &QScrollBar::valueChanged, this,
+                [this]() { d->VirtualTabsLayout->updateVisibleTabs(); });
+        viewport()->installEventFilter(this);
+    }
+
     setFocusPolicy(Qt::NoFocus);
 }
 
@@ -198,14 +514,15 @@ void CDockAreaTabBar::setCurrentIndex(int index)
 //============================================================================
 int CDockAreaTabBar::count() const
 {
-    // The tab bar contains a stretch item as last item
-    return d->TabsLayout->count() - 1;
+    // The box layout contains a stretch item as last item
+    return d->BoxTabsLayout ? d->BoxTabsLayout->count() - 1 :
+                              d->TabsLayout->count();
 }
 
 //===========================================================================
 void CDockAreaTabBar::insertTab(int Index, CDockWidgetTab* Tab)
 {
-    d->TabsLayout->insertWidget(Index, Tab);
+    d->insertTabWidget(Index, Tab);
     connect(Tab, SIGNAL(clicked()), this, SLOT(onTabClicked()));
     connect(Tab, SIGNAL(closeRequested()), this, SLOT(onTabCloseRequested()));
     connect(Tab, SIGNAL(closeOtherTabsRequested()), this,
@@ -214,6 +531,12 @@ void CDockAreaTabBar::insertTab(int Index, CDockWidgetTab* Tab)
             SLOT(onTabWidgetMoved(const QPoint&)));
     connect(Tab, SIGNAL(elidedChanged(bool)), this, SIGNAL(elidedChanged(bool)));
     Tab->installEventFilter(this);
+    if (d->VirtualTabsLayout && Tab != d->ActiveTab)
+    {
+        // The virtualized tab bar only updates the previous and the new
+        // active tab, so we need to initialize the state of new tabs here
+        Tab->setActiveTab(false);
+    }
     Q_EMIT tabInserted(Index);
     if (Index <= d->CurrentIndex)
     {
@@ -277,6 +600,10 @@ void CDockAreaTabBar::removeTab(CDockWidgetTab* Tab)
     d->TabsLayout->removeWidget(Tab);
     Tab->disconnect(this);
     Tab->removeEventFilter(this);
+    if (Tab == d->ActiveTab)
+    {
+        d->ActiveTab = nullptr;
+    }
     ADS_PRINT("NewCurrentIndex " << NewCurrentIndex);
     if (NewCurrentIndex != d->CurrentIndex)
     {
@@ -391,32 +718,47 @@ void CDockAreaTabBar::onTabWidgetMoved(const QPoint& GlobalPos)
 		Q_ASSERT_X(d->TabsLayout->count() != 0, "CDockAreaTabBar::onTabWidgetMoved", "Invalid tab widget move state!");
 		return;
 	}
-    auto MousePos = mapFromGlobal(GlobalPos);
-    MousePos.rx() = qMax(d->firstTab()->geometry().left(), MousePos.x());
-    MousePos.rx() = qMin(d->lastTab()->geometry().right(), MousePos.x());
     int toIndex = -1;
-    // Find tab under mouse
-    for (int i = 0; i < count(); ++i)
-    {
-        CDockWidgetTab* DropTab = tab(i);
-        if (DropTab == MovingTab || !DropTab->isVisibleTo(this)
-            || !DropTab->geometry().contains(MousePos))
+    if (d->VirtualTabsLayout)
+    {
+        // The tabs in the virtualized tab bar may be parked, so we use the
+        // tab positions of the layout
+        auto MousePos = d->TabsContainerWidget->mapFromGlobal(GlobalPos);
+        int Index = d->VirtualTabsLayout->tabIndexAt(MousePos.x());
+        Index = qBound(0, Index, count() - 1);
+        if (Index != fromIndex && tab(Index)->isVisibleTo(this))
         {
-            continue;
+            toIndex = Index;
         }
-
-        toIndex = d->TabsLayout->indexOf(DropTab);
-        if (toIndex == fromIndex)
+    }
+    else
+    {
+        auto MousePos = mapFromGlobal(GlobalPos);
+        MousePos.rx() = qMax(d->firstTab()->geometry().left(), MousePos.x());
+        MousePos.rx() = qMin(d->lastTab()->geometry().right(), MousePos.x());
+        // Find tab under mouse
+        for (int i = 0; i < count(); ++i)
         {
-            toIndex = -1;
+            CDockWidgetTab* DropTab = tab(i);
+            if (DropTab == MovingTab || !DropTab->isVisibleTo(this)
+                || !DropTab->geometry().contains(MousePos))
+            {
+                continue;
+            }
+
+            toIndex = d->TabsLayout->indexOf(DropTab);
+            if (toIndex == fromIndex)
+            {
+                toIndex = -1;
+            }
+            break;
         }
-        break;
     }
 
     if (toIndex > -1)
     {
         d->TabsLayout->removeWidget(MovingTab);
-        d->TabsLayout->insertWidget(toIndex, MovingTab);
+        d->insertTabWidget(toIndex, MovingTab);
         ADS_PRINT("tabMoved from " << fromIndex << " to " << toIndex);
         Q_EMIT tabMoved(fromIndex, toIndex);
         setCurrentIndex(toIndex);
@@ -462,12 +804,37 @@ void CDockAreaTabBar::closeTab(int Index)
 bool CDockAreaTabBar::eventFilter(QObject* watched, QEvent* event)
 {
     bool Result = Super::eventFilter(watched, event);
+    if (d->VirtualTabsLayout && watched == viewport()
+        && event->type() == QEvent::Resize)
+    {
+        d->VirtualTabsLayout->updateVisibleTabs();
+        return Result;
+    }
+
     CDockWidgetTab* Tab = qobject_cast<CDockWidgetTab*>(watched);
     if (!Tab)
     {
         return Result;
     }
 
+    // The virtualized tab bar caches the tab sizes
+    if (d->VirtualTabsLayout)
+    {
+        switch (event->type())
+        {
+        case QEvent::Hide:
+        case QEvent::Show:
+        case QEvent::LayoutRequest:
+        case QEvent::FontChange:
+        case QEvent::StyleChange:
+            d->VirtualTabsLayout->invalidateWidget(Tab);
+            d->TabsLayout->invalidate();
+            break;
+
+        default: break;
+        }
+    }
+
     switch (event->type())
     {
     case QEvent::Hide:
@@ -522,6 +889,12 @@ int CDockAreaTabBar::tabAt(const QPoint& Pos) const
         return TabInvalidIndex;
     }
 
+    if (d->VirtualTabsLayout)
+    {
+        auto ContainerPos = d->TabsContainerWidget->mapFrom(this, Pos);
+        return d->VirtualTabsLayout->tabIndexAt(ContainerPos.x());
+    }
+
     if (Pos.x() < tab(0)->geometry().x())
     {
         return -1;
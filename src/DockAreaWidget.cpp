@@ -37,7 +37,6 @@
 #include <QStackedLayout>
 #include <QStyle>
 #include <QWheelEvent>
-#include <QXmlStreamWriter>
 
 #include <AutoHideDockContainer.h>
 #include <AutoHideTab.h>
@@ -47,12 +46,14 @@
 #include "DockComponentsFactory.h"
 #include "DockContainerWidget.h"
 #include "DockFocusController.h"
+#include "DockInstrumentation.h"
 #include "DockManager.h"
 #include "DockOverlay.h"
 #include "DockSplitter.h"
 #include "DockWidget.h"
 #include "DockWidgetTab.h"
 #include "DockingStateReader.h"
+#include "DockingStateWriter.h"
 #include "ElidingLabel.h"
 #include "FloatingDockContainer.h"
 
@@ -242,6 +243,9 @@ struct DockAreaWidgetPrivate
     DockWidgetAreas AllowedAreas = DefaultAllowedAreas;
     QSize MinSizeHint;
     CDockAreaWidget::DockAreaFlags Flags{CDockAreaWidget::DefaultFlags};
+    QList<CDockWidget*> DockWidgets;
+    QList<CDockWidget*> OpenedDockWidgets;
+    bool DockWidgetListsValid = false;
 
     /**
      * Private data constructor
@@ -261,6 +265,12 @@ struct DockAreaWidgetPrivate
         return qobject_cast<CDockWidget*>(ContentsLayout->widget(index));
     }
 
+    /**
+     * Rebuilds the cached lists of all dock widgets and of the open dock
+     * widgets in this area
+     */
+    void updateDockWidgetLists();
+
     /**
      * Convenience function to ease title widget access by index
      */
@@ -322,6 +332,23 @@ DockAreaWidgetPrivate::DockAreaWidgetPrivate(CDockAreaWidget* _public)
     : _this(_public)
 {}
 
+//============================================================================
+void DockAreaWidgetPrivate::updateDockWidgetLists()
+{
+    DockWidgets.clear();
+    OpenedDockWidgets.clear();
+    for (int i = 0; i < ContentsLayout->count(); ++i)
+    {
+        CDockWidget* DockWidget = dockWidgetAt(i);
+        DockWidgets.append(DockWidget);
+        if (DockWidget && !DockWidget->isClosed())
+        {
+            OpenedDockWidgets.append(DockWidget);
+        }
+    }
+    DockWidgetListsValid = true;
+}
+
 //============================================================================
 void DockAreaWidgetPrivate::createTitleBar()
 {
@@ -536,6 +563,7 @@ void CDockAreaWidget::insertDockWidget(int index, CDockWidget* DockWidget,
         index = d->ContentsLayout->count();
     }
     d->ContentsLayout->insertWidget(index, DockWidget);
+    invalidateDockWidgetLists();
     DockWidget->setDockArea(this);
     DockWidget->tabWidget()->setDockAreaWidget(this);
     auto TabWidget = DockWidget->tabWidget();
@@ -573,6 +601,10 @@ void CDockAreaWidget::insertDockWidget(int index, CDockWidget* DockWidget,
     }
     d->updateTitleBarButtonStates();
     updateTitleBarVisibility();
+    if (d->DockManager)
+    {
+        d->DockManager->notifyLayoutMutation(this);
+    }
 }
 
 //============================================================================
@@ -598,6 +630,11 @@ void CDockAreaWidget::removeDockWidget(CDockWidget* DockWidget)
                                   nullptr;
 
     d->ContentsLayout->removeWidget(DockWidget);
+    invalidateDockWidgetLists();
+    if (d->DockManager)
+    {
+        d->DockManager->notifyLayoutMutation(this);
+    }
     auto TabWidget = DockWidget->tabWidget();
     TabWidget->hide();
     d->tabBar()->removeTab(TabWidget);
@@ -749,6 +786,10 @@ void CDockAreaWidget::setCurrentIndex(int index)
     TabBar->setCurrentIndex(index);
     d->ContentsLayout->setCurrentIndex(index);
     d->ContentsLayout->currentWidget()->show();
+    if (d->DockManager)
+    {
+        d->DockManager->notifyLayoutMutation(this);
+    }
     Q_EMIT currentChanged(index);
     if (d->TitleBar->hasCustomButtons())
     {
@@ -784,41 +825,41 @@ int CDockAreaWidget::index(CDockWidget* DockWidget)
 //============================================================================
 QList<CDockWidget*> CDockAreaWidget::dockWidgets() const
 {
-    QList<CDockWidget*> DockWidgetList;
-    for (int i = 0; i < d->ContentsLayout->count(); ++i)
+    if (!d->DockWidgetListsValid)
     {
-        DockWidgetList.append(dockWidget(i));
+        d->updateDockWidgetLists();
     }
-    return DockWidgetList;
+    return d->DockWidgets;
 }
 
 //============================================================================
 int CDockAreaWidget::openDockWidgetsCount() const
 {
-    int Count = 0;
-    for (int i = 0; i < d->ContentsLayout->count(); ++i)
+    if (!d->DockWidgetListsValid)
     {
-        if (dockWidget(i) && !dockWidget(i)->isClosed())
-        {
-            ++Count;
-        }
+        d->updateDockWidgetLists();
     }
-    return Count;
+    return d->OpenedDockWidgets.count();
 }
 
 //============================================================================
 QList<CDockWidget*> CDockAreaWidget::openedDockWidgets() const
 {
-    QList<CDockWidget*> DockWidgetList;
-    for (int i = 0; i < d->ContentsLayout->count(); ++i)
+    if (!d->DockWidgetListsValid)
     {
-        CDockWidget* DockWidget = dockWidget(i);
-        if (DockWidget && !DockWidget->isClosed())
-        {
-            DockWidgetList.append(dockWidget(i));
-        }
+        d->updateDockWidgetLists();
+    }
+    return d->OpenedDockWidgets;
+}
+
+//============================================================================
+void CDockAreaWidget::invalidateDockWidgetLists()
+{
+    d->DockWidgetListsValid = false;
+    if (auto DockContainer = dockContainer())
+    {
+        DockContainer->invalidateDockWidgetLists();
     }
-    return DockWidgetList;
 }
 
 //============================================================================
@@ -862,6 +903,11 @@ void CDockAreaWidget::reorderDockWidget(int fromIndex, int toIndex)
     auto Widget = d->ContentsLayout->widget(fromIndex);
     d->ContentsLayout->removeWidget(Widget);
     d->ContentsLayout->insertWidget(toIndex, Widget);
+    invalidateDockWidgetLists();
+    if (d->DockManager)
+    {
+        d->DockManager->notifyLayoutMutation(this);
+    }
     setCurrentIndex(toIndex);
 }
 
@@ -887,6 +933,11 @@ void CDockAreaWidget::updateTitleBarVisibility()
         return;
     }
 
+    if (Container->deferTitleBarVisibilityUpdate())
+    {
+        return;
+    }
+
     bool IsAutoHide = isAutoHide();
     if (!CDockManager::testConfigFlag(CDockManager::AlwaysShowTabs))
     {
@@ -955,94 +1006,54 @@ void CDockAreaWidget::updateTitleBarButtonsToolTips()
 //============================================================================
 void CDockAreaWidget::saveState(QXmlStreamWriter& s) const
 {
-    s.writeStartElement("Area");
-    s.writeAttribute("Tabs", QString::number(d->ContentsLayout->count()));
-    auto CurrentDockWidget = currentDockWidget();
-    QString Name = CurrentDockWidget ? CurrentDockWidget->objectName() : "";
-    s.writeAttribute("Current", Name);
-
-    if (d->AllowedAreas != DefaultAllowedAreas)
-    {
-        s.writeAttribute("AllowedAreas", QString::number(d->AllowedAreas, 16));
-    }
+    DockStateNode Node;
+    saveState(Node);
+    CDockingStateWriter::writeChildNode(s, Node);
+}
 
-    if (d->Flags != DefaultFlags)
-    {
-        s.writeAttribute("Flags", QString::number(d->Flags, 16));
-    }
-    ADS_PRINT("CDockAreaWidget::saveState TabCount: "
-              << d->ContentsLayout->count() << " Current: " << Name);
+//============================================================================
+void CDockAreaWidget::saveState(DockStateNode& Node) const
+{
+    Node.Type = DockStateNode::AreaNode;
+    auto CurrentDockWidget = currentDockWidget();
+    Node.CurrentDockWidget = CurrentDockWidget ? CurrentDockWidget->objectName() : "";
+    Node.AllowedAreas = (d->AllowedAreas != DefaultAllowedAreas) ? int(d->AllowedAreas) : -1;
+    Node.Flags = (d->Flags != DefaultFlags) ? int(d->Flags) : -1;
+    Node.DockWidgets.reserve(d->ContentsLayout->count());
     for (int i = 0; i < d->ContentsLayout->count(); ++i)
     {
-        dockWidget(i)->saveState(s);
+        DockWidgetState WidgetState;
+        dockWidget(i)->saveState(WidgetState);
+        Node.DockWidgets.append(WidgetState);
     }
-    s.writeEndElement();
 }
 
 //============================================================================
-bool CDockAreaWidget::restoreState(CDockingStateReader& s,
-                                   CDockAreaWidget*& CreatedWidget, bool Testing,
-                                   CDockContainerWidget* Container)
+CDockAreaWidget* CDockAreaWidget::restoreState(const DockStateNode& Node,
+                                               CDockContainerWidget* Container)
 {
-    bool Ok;
-#ifdef ADS_DEBUG_PRINT
-    int Tabs = s.attributes().value("Tabs").toInt(&Ok);
-    if (!Ok)
-    {
-        return false;
-    }
-#endif
-
-    QString CurrentDockWidget = s.attributes().value("Current").toString();
-    ADS_PRINT("Restore NodeDockArea Tabs: " << Tabs
-                                            << " Current: " << CurrentDockWidget);
+    ADS_TRACE_SCOPE("CDockAreaWidget::restoreState");
+    ADS_PRINT("Restore NodeDockArea Tabs: " << Node.DockWidgets.count()
+                                            << " Current: " << Node.CurrentDockWidget);
 
     auto DockManager = Container->dockManager();
-    CDockAreaWidget* DockArea = nullptr;
-    if (!Testing)
+    CDockAreaWidget* DockArea = new CDockAreaWidget(DockManager, Container);
+    if (Node.AllowedAreas >= 0)
     {
-        DockArea = new CDockAreaWidget(DockManager, Container);
-        const auto AllowedAreasAttribute = s.attributes().value("AllowedAreas");
-        if (!AllowedAreasAttribute.isEmpty())
-        {
-            DockArea->setAllowedAreas(
-                (DockWidgetArea)AllowedAreasAttribute.toInt(nullptr, 16));
-        }
-
-        const auto FlagsAttribute = s.attributes().value("Flags");
-        if (!FlagsAttribute.isEmpty())
-        {
-            DockArea->setDockAreaFlags(
-                (CDockAreaWidget::DockAreaFlags)FlagsAttribute.toInt(nullptr,
-                                                                     16));
-        }
+        DockArea->setAllowedAreas((DockWidgetArea)Node.AllowedAreas);
     }
 
-    while (s.readNextStartElement())
+    if (Node.Flags >= 0)
     {
-        if (s.name() != QLatin1String("Widget"))
-        {
-            continue;
-        }
-
-        auto ObjectName = s.attributes().value("Name");
-        if (ObjectName.isEmpty())
-        {
-            return false;
-        }
-
-        bool Closed = s.attributes().value("Closed").toInt(&Ok);
-        if (!Ok)
-        {
-            return false;
-        }
+        DockArea->setDockAreaFlags((CDockAreaWidget::DockAreaFlags)Node.Flags);
+    }
 
-        s.skipCurrentElement();
-        Q_EMIT DockManager->aboutToRestoreDockWidget(ObjectName.toString(),
-                                                     Testing);
-        CDockWidget* DockWidget =
-            DockManager->findDockWidget(ObjectName.toString());
-        if (!DockWidget || Testing)
+    for (const auto& WidgetState : Node.DockWidgets)
+    {
+        Q_EMIT DockManager->aboutToRestoreDockWidget(WidgetState.Name,
+                                                     internal::Restore);
+        CDockWidget* DockWidget = DockManager->findDockWidget(WidgetState.Name);
+        if (!DockWidget)
         {
             continue;
         }
@@ -1055,6 +1066,7 @@ bool CDockAreaWidget::restoreState(CDockingStateReader& s,
 
         // We hide the DockArea here to prevent the short display (the flashing)
         // of the dock areas during application startup
+        const bool Closed = WidgetState.Closed;
         DockArea->hide();
         DockArea->addDockWidget(DockWidget);
         DockWidget->setToggleViewActionChecked(!Closed);
@@ -1063,25 +1075,70 @@ bool CDockAreaWidget::restoreState(CDockingStateReader& s,
         DockWidget->setProperty(internal::DirtyProperty, false);
     }
 
-    if (Testing)
+    if (!DockArea->dockWidgetsCount())
     {
-        return true;
+        delete DockArea;
+        return nullptr;
     }
 
-    if (!DockArea->dockWidgetsCount())
+    DockArea->setProperty("currentDockWidget", Node.CurrentDockWidget);
+    return DockArea;
+}
+
+//============================================================================
+bool CDockAreaWidget::restoreState(CDockingStateReader& s,
+                                   CDockAreaWidget*& CreatedWidget, bool Testing,
+                                   CDockContainerWidget* Container)
+{
+    CreatedWidget = nullptr;
+    DockStateNode Node;
+    if (!s.readDockArea(Node))
     {
-        delete DockArea;
-        DockArea = nullptr;
+        return false;
     }
-    else
+
+    if (Testing)
     {
-        DockArea->setProperty("currentDockWidget", CurrentDockWidget);
+        auto DockManager = Container->dockManager();
+        for (const auto& WidgetState : Node.DockWidgets)
+        {
+            Q_EMIT DockManager->aboutToRestoreDockWidget(WidgetState.Name,
+                                                         internal::RestoreTesting);
+        }
+        return true;
     }
 
-    CreatedWidget = DockArea;
+    CreatedWidget = restoreState(Node, Container);
     return true;
 }
 
+//============================================================================
+void CDockAreaWidget::restoreExistingState(const DockStateNode& Node)
+{
+    setAllowedAreas((Node.AllowedAreas >= 0) ? (DockWidgetArea)Node.AllowedAreas
+                                             : DefaultAllowedAreas);
+    setDockAreaFlags((Node.Flags >= 0) ? (DockAreaFlags)Node.Flags
+                                       : DockAreaFlags(DefaultFlags));
+    for (const auto& WidgetState : Node.DockWidgets)
+    {
+        Q_EMIT d->DockManager->aboutToRestoreDockWidget(WidgetState.Name,
+                                                        internal::Restore);
+        CDockWidget* DockWidget = d->DockManager->findDockWidget(WidgetState.Name);
+        if (!DockWidget || DockWidget->dockAreaWidget() != this)
+        {
+            continue;
+        }
+
+        const bool Closed = WidgetState.Closed;
+        DockWidget->setToggleViewActionChecked(!Closed);
+        DockWidget->setClosedState(Closed);
+        DockWidget->setProperty(internal::ClosedProperty, Closed);
+        DockWidget->setProperty(internal::DirtyProperty, false);
+    }
+
+    setProperty("currentDockWidget", Node.CurrentDockWidget);
+}
+
 //============================================================================
 CDockWidget* CDockAreaWidget::nextOpenDockWidget(CDockWidget* DockWidget) const
 {
@@ -1178,6 +1235,10 @@ void CDockAreaWidget::toggleView(bool Open)
 void CDockAreaWidget::setVisible(bool Visible)
 {
     Super::setVisible(Visible);
+    if (auto DockContainer = dockContainer())
+    {
+        DockContainer->invalidateDockAreaLists();
+    }
     if (d->UpdateTitleBarButtons)
     {
         d->updateTitleBarButtonStates();
@@ -1543,13 +1604,33 @@ void CDockAreaWidget::setFloating()
     d->TitleBar->setAreaFloating();
 }
 
-#ifdef Q_OS_WIN
 //============================================================================
 bool CDockAreaWidget::event(QEvent* e)
 {
     switch (e->type())
     {
+#ifdef Q_OS_WIN
     case QEvent::PlatformSurface: return true;
+#endif
+
+    // Any change of the geometry or visibility of this area invalidates the
+    // hit test index of the dock container
+    case QEvent::Move:
+    case QEvent::Resize:
+    case QEvent::Show:
+    case QEvent::Hide:
+        if (auto DockContainer = dockContainer())
+        {
+            DockContainer->invalidateDockAreaIndex();
+        }
+        break;
+
+    // A dock widget that is deleted while it is still in this area is not
+    // removed via removeDockWidget()
+    case QEvent::ChildRemoved:
+        invalidateDockWidgetLists();
+        break;
+
     default: break;
     }
 
@@ -1569,8 +1650,6 @@ void CDockAreaWidget::fetchIndependentCount()
     }
 }
 
-#endif
-
 }  // namespace ads
 
 //---------------------------------------------------------------------------
@@ -45,6 +45,7 @@ class CDockContainerWidget;
 class DockContainerWidgetPrivate;
 class CDockAreaTitleBar;
 class CDockingStateReader;
+struct DockStateNode;
 class CDockSplitter;
 
 /**
@@ -96,15 +97,14 @@ private Q_SLOTS:
     SideBarLocation calculateSideTabBarArea() const;
 
 protected:
-#ifdef Q_OS_WIN
     /**
-     * Reimplements QWidget::event to handle QEvent::PlatformSurface
-     * This is here to fix issue #294 Tab refresh problem with a QGLWidget
-     * that exists since Qt version 5.12.7. So this function is here to
-     * work around a Qt issue.
+     * Reimplements QWidget::event to invalidate the hit test index of the
+     * dock container if the geometry or visibility of this area changes.
+     * On Windows it also handles QEvent::PlatformSurface to fix issue #294
+     * Tab refresh problem with a QGLWidget that exists since Qt version
+     * 5.12.7.
      */
     virtual bool event(QEvent* event) override;
-#endif
 
     /**
      * Inserts a dock widget into dock area.
@@ -132,6 +132,13 @@ protected:
      */
     void toggleDockWidgetView(CDockWidget* DockWidget, bool Open);
 
+    /**
+     * Invalidates the cached dock widget lists of this area and of its
+     * dock container. Called if dock widgets are added, removed, moved or
+     * if their closed state changes.
+     */
+    void invalidateDockWidgetLists();
+
     /**
      * This is a helper function to get the next open dock widget to activate
      * if the given DockWidget will be closed or removed.
@@ -310,13 +317,38 @@ public:
     void saveState(QXmlStreamWriter& Stream) const;
 
     /**
-     * Restores a dock area.
-     * \see restoreChildNodes() for details
+     * Saves the state into the given in-memory state node
+     */
+    void saveState(DockStateNode& Node) const;
+
+    /**
+     * Restores a dock area from the Area element the given stream is
+     * positioned on.
+     * The element is parsed into a DockStateNode and the dock area is
+     * created by restoreState(const DockStateNode&, CDockContainerWidget*).
+     * If Testing is true, the element is only parsed and CreatedWidget is
+     * set to nullptr. Returns false, if the element is not valid.
      */
     static bool restoreState(CDockingStateReader& Stream,
                              CDockAreaWidget*& CreatedWidget, bool Testing,
                              CDockContainerWidget* ParentContainer);
 
+    /**
+     * Creates a dock area from the given parsed state node.
+     * Returns nullptr, if none of the dock widgets in the node exists
+     * and the created dock area would be empty.
+     */
+    static CDockAreaWidget* restoreState(const DockStateNode& Node,
+                                         CDockContainerWidget* ParentContainer);
+
+    /**
+     * Restores the state of this existing dock area from the given parsed
+     * state node.
+     * This is used if the dock area already contains exactly the dock
+     * widgets of the given node and can be reused.
+     */
+    void restoreExistingState(const DockStateNode& Node);
+
     /**
      * This functions returns the dock widget features of all dock widget in
      * this area.
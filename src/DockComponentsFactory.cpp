@@ -53,6 +53,13 @@ CDockAreaTitleBar* CDockComponentsFactory::createDockAreaTitleBar(
     return new CDockAreaTitleBar(DockArea);
 }
 
+//============================================================================
+CDockWidgetTab* CFlyweightDockComponentsFactory::createDockWidgetTab(
+    CDockWidget* DockWidget) const
+{
+    return new CDockWidgetTab(DockWidget, CDockWidgetTab::PaintedRendering);
+}
+
 //============================================================================
 const CDockComponentsFactory* CDockComponentsFactory::factory()
 {
@@ -81,6 +81,26 @@ public:
     static void resetDefaultFactory();
 };
 
+/**
+ * Components factory that creates painted dock widget tabs.
+ * A painted tab has no child widgets - it paints its title, icon and close
+ * button itself. This reduces the number of widgets, the memory usage and the
+ * layout time for workspaces with many dock widgets.
+ * \code
+ * CDockComponentsFactory::setFactory(new CFlyweightDockComponentsFactory());
+ * \endcode
+ */
+class ADS_EXPORT CFlyweightDockComponentsFactory : public CDockComponentsFactory
+{
+public:
+    /**
+     * Creates a dock widget tab with the CDockWidgetTab::PaintedRendering
+     * render mode
+     */
+    virtual CDockWidgetTab* createDockWidgetTab(
+        CDockWidget* DockWidget) const override;
+};
+
 /**
  * Convenience function to ease factory instance access
  */
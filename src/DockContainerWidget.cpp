@@ -33,15 +33,18 @@
 #include <QDebug>
 #include <QEvent>
 #include <QGridLayout>
+#include <QHash>
 #include <QLabel>
 #include <QList>
 #include <QMetaObject>
 #include <QMetaType>
 #include <QPointer>
+#include <QSet>
 #include <QTimer>
 #include <QVariant>
-#include <QXmlStreamWriter>
+#include <QVector>
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 
@@ -51,12 +54,14 @@
 #include "DockAreaTitleBar.h"
 #include "DockAreaWidget.h"
 #include "DockFocusController.h"
+#include "DockInstrumentation.h"
 #include "DockManager.h"
 #include "DockOverlay.h"
 #include "DockSplitter.h"
 #include "DockWidget.h"
 #include "DockWidgetTab.h"
 #include "DockingStateReader.h"
+#include "DockingStateWriter.h"
 #include "FloatingDockContainer.h"
 #include "ads_globals.h"
 
@@ -130,6 +135,16 @@ static void insertWidgetIntoSplitter(QSplitter* Splitter, QWidget* widget,
     }
 }
 
+/**
+ * Returns a key that identifies the dock widgets in the given list of
+ * object names. Dock areas with the same key contain exactly the same
+ * dock widgets in the same order.
+ */
+static QString dockAreaStateKey(const QStringList& DockWidgetNames)
+{
+    return DockWidgetNames.join(QChar('\n'));
+}
+
 /**
  * Private data class of CDockContainerWidget class (pimpl)
  */
@@ -153,12 +168,92 @@ public:
     QTimer DelayedAutoHideTimer;
     CAutoHideTab* DelayedAutoHideTab;
     bool DelayedAutoHideShow = false;
+    QHash<QString, CDockAreaWidget*> ReusableDockAreas;
+    QSet<QSplitter*> ReusedSplitters;
+    bool RestoringState = false;
+
+    // Lists that are rebuilt on first use after the dock areas, their
+    // visibility or their dock widgets changed. The accessors return
+    // implicitly shared copies of these lists, so repeated queries do not
+    // allocate
+    QList<CDockAreaWidget*> OpenedDockAreas;
+    QList<CDockWidget*> DockWidgets;
+    QList<CDockWidget*> OpenedDockWidgets;
+    bool OpenedDockAreasValid = false;
+    bool DockWidgetListsValid = false;
+
+    // Layout updates that have been deferred while a layout update
+    // transaction of the dock manager is in progress
+    bool SplitterHandlesDirty = false;
+    bool TitleBarVisibilityDirty = false;
+    bool VisibleDockAreaCountDirty = false;
+    bool TopLevelEventPending = false;
+    bool DockAreasAddedPending = false;
+    bool DockAreasRemovedPending = false;
+
+    /**
+     * Entry of the dock area hit test index - the rectangle is in container
+     * coordinates
+     */
+    struct DockAreaIndexEntry
+    {
+        QRect Rect;
+        QPointer<CDockAreaWidget> DockArea;
+    };
+
+    // The hit test index splits the container into columns at the left and
+    // right edges of all visible dock areas. Each column contains the dock
+    // areas that overlap it, sorted by their top edge. Column i covers the
+    // x range [DockAreaIndexEdges[i], DockAreaIndexEdges[i + 1])
+    QVector<int> DockAreaIndexEdges;
+    QVector<QVector<DockAreaIndexEntry>> DockAreaIndexColumns;
+    bool DockAreaIndexValid = false;
 
     /**
      * Private data constructor
      */
     DockContainerWidgetPrivate(CDockContainerWidget* _public);
 
+    /**
+     * Rebuilds the spatial index of the visible dock areas
+     */
+    void updateDockAreaIndex();
+
+    /**
+     * Invalidates all cached lists that depend on the dock areas
+     */
+    void invalidateDockAreaLists()
+    {
+        OpenedDockAreasValid = false;
+        DockWidgetListsValid = false;
+    }
+
+    /**
+     * Rebuilds the cached list of the open dock areas
+     */
+    void updateOpenedDockAreas();
+
+    /**
+     * Rebuilds the cached lists of all dock widgets and of the open dock
+     * widgets in this container
+     */
+    void updateDockWidgetLists();
+
+    /**
+     * Returns true, if layout updates are deferred because the dock manager
+     * is in a layout update transaction
+     */
+    bool isLayoutUpdateDeferred() const
+    {
+        return DockManager && DockManager->isLayoutUpdateInProgress();
+    }
+
+    /**
+     * Applies all layout updates that have been deferred during a layout
+     * update transaction and emits the coalesced signals
+     */
+    void commitLayoutUpdate();
+
     /**
      * Adds dock widget to container and returns the dock area that contains
      * the inserted dock widget
@@ -243,45 +338,49 @@ public:
     void appendDockAreas(const QList<CDockAreaWidget*> NewDockAreas);
 
     /**
-     * Save state of child nodes
+     * Save state of child nodes into the given in-memory state node.
+     * Returns false, if the given widget is neither a splitter nor a dock area
      */
-    void saveChildNodesState(QXmlStreamWriter& Stream, QWidget* Widget);
+    bool saveChildNodesState(DockStateNode& Node, QWidget* Widget);
 
     /**
-     * Save state of auto hide widgets
+     * Save state of auto hide widgets into the given container state
      */
-    void saveAutoHideWidgetsState(QXmlStreamWriter& Stream);
+    void saveAutoHideWidgetsState(ContainerState& State);
 
     /**
      * Restore state of child nodes.
-     * \param[in] Stream The data stream that contains the serialized state
-     * \param[out] CreatedWidget The widget created from parsed data or 0 if
-     * the parsed widget was an empty splitter
-     * \param[in] Testing If Testing is true, only the stream data is
-     * parsed without modifying anything.
+     * Returns the widget created from the given parsed node or nullptr if
+     * the node was an empty splitter or a dock area without any existing
+     * dock widgets
      */
-    bool restoreChildNodes(CDockingStateReader& Stream, QWidget*& CreatedWidget,
-                           bool Testing);
+    QWidget* restoreChildNode(const DockStateNode& Node);
 
     /**
      * Restores a splitter.
-     * \see restoreChildNodes() for details
+     * \see restoreChildNode() for details
      */
-    bool restoreSplitter(CDockingStateReader& Stream, QWidget*& CreatedWidget,
-                         bool Testing);
+    QWidget* restoreSplitter(const DockStateNode& Node);
 
     /**
      * Restores a dock area.
-     * \see restoreChildNodes() for details
+     * \see restoreChildNode() for details
      */
-    bool restoreDockArea(CDockingStateReader& Stream, QWidget*& CreatedWidget,
-                         bool Testing);
+    QWidget* restoreDockArea(const DockStateNode& Node);
 
     /**
      * Restores a auto hide side bar
      */
-    bool restoreSideBar(CDockingStateReader& Stream, QWidget*& CreatedWidget,
-                        bool Testing);
+    void restoreSideBar(const SideBarState& State);
+
+    /**
+     * Returns an existing splitter with the given orientation that contains
+     * exactly the given child widgets in the given order.
+     * Returns nullptr if no such splitter exists or if the splitter has
+     * already been reused.
+     */
+    QSplitter* findReusableSplitter(Qt::Orientation Orientation,
+                                    const QList<QWidget*>& ChildNodes) const;
 
     /**
      * Helper function for recursive dumping of layout
@@ -334,12 +433,22 @@ public:
 
     void emitDockAreasRemoved()
     {
+        if (isLayoutUpdateDeferred())
+        {
+            DockAreasRemovedPending = true;
+            return;
+        }
         onVisibleDockAreaCountChanged();
         Q_EMIT _this->dockAreasRemoved();
     }
 
     void emitDockAreasAdded()
     {
+        if (isLayoutUpdateDeferred())
+        {
+            DockAreasAddedPending = true;
+            return;
+        }
         onVisibleDockAreaCountChanged();
         Q_EMIT _this->dockAreasAdded();
     }
@@ -351,9 +460,23 @@ public:
                                QWidget* parent = nullptr)
     {
         CDockSplitter* s = new CDockSplitter(orientation, parent);
-        s->setOpaqueResize(
-            CDockManager::testConfigFlag(CDockManager::OpaqueSplitterResize));
+        bool OpaqueResize =
+            CDockManager::testConfigFlag(CDockManager::OpaqueSplitterResize);
+        s->setOpaqueResize(OpaqueResize);
+        s->setFrozenLiveResize(OpaqueResize
+                               && CDockManager::testPerformanceConfigFlag(
+                                   CDockManager::FrozenLiveResize));
         s->setChildrenCollapsible(false);
+        QObject::connect(s, &QSplitter::splitterMoved, s, [this, s]()
+        {
+            // Moving a handle moves the dock areas of the splitter
+            // relative to the container
+            DockAreaIndexValid = false;
+            if (DockManager)
+            {
+                DockManager->notifyLayoutMutation(s);
+            }
+        });
         return s;
     }
 
@@ -397,7 +520,14 @@ public:
         CDockAreaWidget* DockArea =
             qobject_cast<CDockAreaWidget*>(_this->sender());
         VisibleDockAreaCount += Visible ? 1 : -1;
-        onVisibleDockAreaCountChanged();
+        if (isLayoutUpdateDeferred())
+        {
+            VisibleDockAreaCountDirty = true;
+        }
+        else
+        {
+            onVisibleDockAreaCountChanged();
+        }
         Q_EMIT _this->dockAreaViewToggled(DockArea, Visible);
     }
 };  // struct DockContainerWidgetPrivate
@@ -609,6 +739,7 @@ void DockContainerWidgetPrivate::dropIntoSection(
     CFloatingDockContainer* FloatingWidget, CDockAreaWidget* TargetArea,
     DockWidgetArea area, int TabIndex)
 {
+    ADS_TRACE_SCOPE("CDockContainerWidget::dropIntoSection");
     // Dropping into center means all dock widgets in the dropped floating
     // widget will become tabs of the drop area
     if (CenterDockWidgetArea == area)
@@ -859,6 +990,12 @@ void DockContainerWidgetPrivate::updateSplitterHandles(QSplitter* splitter)
         return;
     }
 
+    if (isLayoutUpdateDeferred())
+    {
+        SplitterHandlesDirty = true;
+        return;
+    }
+
     for (int i = 0; i < splitter->count(); ++i)
     {
         splitter->setStretchFactor(
@@ -866,6 +1003,97 @@ void DockContainerWidgetPrivate::updateSplitterHandles(QSplitter* splitter)
     }
 }
 
+//============================================================================
+void DockContainerWidgetPrivate::updateOpenedDockAreas()
+{
+    OpenedDockAreas.clear();
+    for (auto DockArea : DockAreas)
+    {
+        if (DockArea && !DockArea->isHidden())
+        {
+            OpenedDockAreas.append(DockArea);
+        }
+    }
+    OpenedDockAreasValid = true;
+}
+
+//============================================================================
+void DockContainerWidgetPrivate::updateDockWidgetLists()
+{
+    DockWidgets.clear();
+    OpenedDockWidgets.clear();
+    for (const auto& DockArea : DockAreas)
+    {
+        if (!DockArea)
+        {
+            continue;
+        }
+
+        DockWidgets.append(DockArea->dockWidgets());
+        if (!DockArea->isHidden())
+        {
+            OpenedDockWidgets.append(DockArea->openedDockWidgets());
+        }
+    }
+    DockWidgetListsValid = true;
+}
+
+//============================================================================
+void DockContainerWidgetPrivate::commitLayoutUpdate()
+{
+    if (SplitterHandlesDirty && RootSplitter)
+    {
+        SplitterHandlesDirty = false;
+        updateSplitterHandles(RootSplitter);
+        for (auto Splitter : RootSplitter->findChildren<CDockSplitter*>())
+        {
+            updateSplitterHandles(Splitter);
+        }
+    }
+
+    if (TitleBarVisibilityDirty)
+    {
+        TitleBarVisibilityDirty = false;
+        for (auto DockArea : DockAreas)
+        {
+            if (DockArea)
+            {
+                DockArea->updateTitleBarVisibility();
+            }
+        }
+    }
+
+    bool AreasAdded = DockAreasAddedPending;
+    bool AreasRemoved = DockAreasRemovedPending;
+    bool TopLevelEvent = TopLevelEventPending;
+    bool VisibleCountChanged = VisibleDockAreaCountDirty || AreasAdded
+                               || AreasRemoved;
+    DockAreasAddedPending = false;
+    DockAreasRemovedPending = false;
+    TopLevelEventPending = false;
+    VisibleDockAreaCountDirty = false;
+    if (VisibleCountChanged)
+    {
+        onVisibleDockAreaCountChanged();
+    }
+
+    if (TopLevelEvent)
+    {
+        CDockWidget::emitTopLevelEventForWidget(_this->topLevelDockWidget(),
+                                                true);
+    }
+
+    if (AreasRemoved)
+    {
+        Q_EMIT _this->dockAreasRemoved();
+    }
+
+    if (AreasAdded)
+    {
+        Q_EMIT _this->dockAreasAdded();
+    }
+}
+
 //============================================================================
 bool DockContainerWidgetPrivate::widgetResizesWithContainer(QWidget* widget)
 {
@@ -965,6 +1193,66 @@ void DockContainerWidgetPrivate::addDockAreasToList(
     }
 
     emitDockAreasAdded();
+    if (DockManager)
+    {
+        DockManager->notifyLayoutMutation(_this);
+    }
+}
+
+//============================================================================
+void DockContainerWidgetPrivate::updateDockAreaIndex()
+{
+    DockAreaIndexEdges.clear();
+    DockAreaIndexColumns.clear();
+    DockAreaIndexValid = true;
+
+    QVector<DockAreaIndexEntry> Entries;
+    for (const auto& DockArea : DockAreas)
+    {
+        if (!DockArea || !DockArea->isVisible() || !_this->isAncestorOf(DockArea))
+        {
+            continue;
+        }
+
+        QRect Rect(DockArea->mapTo(_this, QPoint(0, 0)), DockArea->size());
+        if (Rect.isEmpty())
+        {
+            continue;
+        }
+
+        Entries.append({Rect, DockArea});
+        DockAreaIndexEdges.append(Rect.left());
+        DockAreaIndexEdges.append(Rect.right() + 1);
+    }
+
+    if (Entries.isEmpty())
+    {
+        return;
+    }
+
+    std::sort(DockAreaIndexEdges.begin(), DockAreaIndexEdges.end());
+    DockAreaIndexEdges.erase(
+        std::unique(DockAreaIndexEdges.begin(), DockAreaIndexEdges.end()),
+        DockAreaIndexEdges.end());
+    DockAreaIndexColumns.resize(DockAreaIndexEdges.count() - 1);
+
+    // Inserting the entries sorted by their top edge keeps each column sorted
+    std::sort(Entries.begin(), Entries.end(),
+        [](const DockAreaIndexEntry& lhs, const DockAreaIndexEntry& rhs)
+        {
+            return lhs.Rect.top() < rhs.Rect.top();
+        });
+    for (const auto& Entry : Entries)
+    {
+        int Column = std::lower_bound(DockAreaIndexEdges.cbegin(),
+            DockAreaIndexEdges.cend(), Entry.Rect.left())
+            - DockAreaIndexEdges.cbegin();
+        for (; Column < DockAreaIndexColumns.count()
+               && DockAreaIndexEdges[Column] <= Entry.Rect.right(); ++Column)
+        {
+            DockAreaIndexColumns[Column].append(Entry);
+        }
+    }
 }
 
 //============================================================================
@@ -975,54 +1263,51 @@ void DockContainerWidgetPrivate::appendDockAreas(
     {
         DockAreas.append(newDockArea);
     }
+    DockAreaIndexValid = false;
+    invalidateDockAreaLists();
     for (auto DockArea : NewDockAreas)
     {
         QObject::connect(
             DockArea, &CDockAreaWidget::viewToggled, _this,
             std::bind(&DockContainerWidgetPrivate::onDockAreaViewToggled, this,
                       std::placeholders::_1));
+        // The cached lists must not keep dangling pointers to dock areas
+        // that are deleted while they are still in this container
+        QObject::connect(DockArea, &QObject::destroyed, _this,
+                         [this]() { invalidateDockAreaLists(); });
     }
 }
 
 //============================================================================
-void DockContainerWidgetPrivate::saveChildNodesState(QXmlStreamWriter& s,
+bool DockContainerWidgetPrivate::saveChildNodesState(DockStateNode& Node,
                                                      QWidget* Widget)
 {
     QSplitter* Splitter = qobject_cast<QSplitter*>(Widget);
     if (Splitter)
     {
-        s.writeStartElement("Splitter");
-        s.writeAttribute("Orientation",
-                         (Splitter->orientation() == Qt::Horizontal) ? "|" : "-");
-        s.writeAttribute("Count", QString::number(Splitter->count()));
-        ADS_PRINT("NodeSplitter orient: " << Splitter->orientation()
-                                          << " WidgetCont: "
-                                          << Splitter->count());
+        Node.Type = DockStateNode::SplitterNode;
+        Node.Orientation = Splitter->orientation();
+        Node.Sizes = Splitter->sizes();
+        Node.Children.resize(Splitter->count());
         for (int i = 0; i < Splitter->count(); ++i)
         {
-            saveChildNodesState(s, Splitter->widget(i));
+            saveChildNodesState(Node.Children[i], Splitter->widget(i));
         }
-
-        s.writeStartElement("Sizes");
-        for (auto Size : Splitter->sizes())
-        {
-            s.writeCharacters(QString::number(Size) + " ");
-        }
-        s.writeEndElement();
-        s.writeEndElement();
+        return true;
     }
-    else
+
+    CDockAreaWidget* DockArea = qobject_cast<CDockAreaWidget*>(Widget);
+    if (DockArea)
     {
-        CDockAreaWidget* DockArea = qobject_cast<CDockAreaWidget*>(Widget);
-        if (DockArea)
-        {
-            DockArea->saveState(s);
-        }
+        DockArea->saveState(Node);
+        return true;
     }
+
+    return false;
 }
 
 //============================================================================
-void DockContainerWidgetPrivate::saveAutoHideWidgetsState(QXmlStreamWriter& s)
+void DockContainerWidgetPrivate::saveAutoHideWidgetsState(ContainerState& State)
 {
     for (const auto sideTabBar : SideTabBarWidgets.values())
     {
@@ -1031,201 +1316,130 @@ void DockContainerWidgetPrivate::saveAutoHideWidgetsState(QXmlStreamWriter& s)
             continue;
         }
 
-        sideTabBar->saveState(s);
+        SideBarState SideBar;
+        sideTabBar->saveState(SideBar);
+        State.SideBars.append(SideBar);
     }
 }
 
 //============================================================================
-bool DockContainerWidgetPrivate::restoreSplitter(CDockingStateReader& s,
-                                                 QWidget*& CreatedWidget,
-                                                 bool Testing)
+QSplitter* DockContainerWidgetPrivate::findReusableSplitter(
+    Qt::Orientation Orientation, const QList<QWidget*>& ChildNodes) const
 {
-    bool Ok;
-    QString OrientationStr = s.attributes().value("Orientation").toString();
-
-    // Check if the orientation string is right
-    if (!OrientationStr.startsWith("|") && !OrientationStr.startsWith("-"))
+    QSplitter* Splitter =
+        qobject_cast<QSplitter*>(ChildNodes.first()->parentWidget());
+    if (!Splitter || ReusedSplitters.contains(Splitter)
+        || Splitter->orientation() != Orientation
+        || Splitter->count() != ChildNodes.count())
     {
-        return false;
-    }
-
-    // The "|" shall indicate a vertical splitter handle which in turn means
-    // a Horizontal orientation of the splitter layout.
-    bool HorizontalSplitter = OrientationStr.startsWith("|");
-    // In version 0 we had a small bug. The "|" indicated a vertical orientation,
-    // but this is wrong, because only the splitter handle is vertical, the
-    // layout of the splitter is a horizontal layout. We fix this here
-    if (s.fileVersion() == 0)
-    {
-        HorizontalSplitter = !HorizontalSplitter;
+        return nullptr;
     }
 
-    int Orientation = HorizontalSplitter ? Qt::Horizontal : Qt::Vertical;
-    int WidgetCount = s.attributes().value("Count").toInt(&Ok);
-    if (!Ok)
+    for (int i = 0; i < ChildNodes.count(); ++i)
     {
-        return false;
-    }
-    ADS_PRINT("Restore NodeSplitter Orientation: "
-              << Orientation << " WidgetCount: " << WidgetCount);
-    QSplitter* Splitter = nullptr;
-    if (!Testing)
-    {
-        Splitter = newSplitter(static_cast<Qt::Orientation>(Orientation));
-    }
-    bool Visible = false;
-    QList<int> Sizes;
-    while (s.readNextStartElement())
-    {
-        QWidget* ChildNode = nullptr;
-        bool Result = true;
-        if (s.name() == QLatin1String("Splitter"))
+        if (Splitter->widget(i) != ChildNodes[i])
         {
-            Result = restoreSplitter(s, ChildNode, Testing);
-        }
-        else if (s.name() == QLatin1String("Area"))
-        {
-            Result = restoreDockArea(s, ChildNode, Testing);
-        }
-        else if (s.name() == QLatin1String("Sizes"))
-        {
-            QString sSizes = s.readElementText().trimmed();
-            ADS_PRINT("Sizes: " << sSizes);
-            QTextStream TextStream(&sSizes);
-            while (!TextStream.atEnd())
-            {
-                int value;
-                TextStream >> value;
-                Sizes.append(value);
-            }
-        }
-        else
-        {
-            s.skipCurrentElement();
-        }
-
-        if (!Result)
-        {
-            return false;
+            return nullptr;
         }
+    }
 
-        if (Testing || !ChildNode)
-        {
-            continue;
-        }
+    return Splitter;
+}
 
-        ADS_PRINT("ChildNode isVisible " << ChildNode->isVisible()
-                                         << " isVisibleTo "
-                                         << ChildNode->isVisibleTo(Splitter));
+//============================================================================
+QWidget* DockContainerWidgetPrivate::restoreSplitter(const DockStateNode& Node)
+{
+    ADS_TRACE_SCOPE("CDockContainerWidget::restoreSplitter");
+    ADS_PRINT("Restore NodeSplitter Orientation: "
+              << Node.Orientation << " WidgetCount: " << Node.Sizes.count());
+    QList<QWidget*> ChildNodes;
+    for (const auto& Child : Node.Children)
+    {
+        QWidget* ChildNode = restoreChildNode(Child);
         if (ChildNode)
         {
-            Splitter->addWidget(ChildNode);
-            Visible |= ChildNode->isVisibleTo(Splitter);
+            ChildNodes.append(ChildNode);
         }
     }
-    if (!Testing)
+
+    if (ChildNodes.isEmpty())
     {
-        updateSplitterHandles(Splitter);
+        return nullptr;
     }
 
-    if (Sizes.count() != WidgetCount)
+    // If an existing splitter already contains exactly the restored child
+    // nodes, then we reuse it and only need to apply the new sizes
+    QSplitter* Splitter = findReusableSplitter(Node.Orientation, ChildNodes);
+    if (Splitter)
     {
-        return false;
+        ReusedSplitters.insert(Splitter);
     }
-    if (!Testing)
+    else
     {
-        if (!Splitter->count())
+        Splitter = newSplitter(Node.Orientation);
+        for (auto ChildNode : ChildNodes)
         {
-            delete Splitter;
-            Splitter = nullptr;
-        }
-        else
-        {
-            Splitter->setSizes(Sizes);
-            Splitter->setVisible(Visible);
+            Splitter->addWidget(ChildNode);
         }
-        CreatedWidget = Splitter;
     }
-    else
+
+    bool Visible = false;
+    for (auto ChildNode : ChildNodes)
     {
-        CreatedWidget = nullptr;
+        ADS_PRINT("ChildNode isVisible " << ChildNode->isVisible()
+                                         << " isVisibleTo "
+                                         << ChildNode->isVisibleTo(Splitter));
+        Visible |= ChildNode->isVisibleTo(Splitter);
     }
-
-    return true;
+    updateSplitterHandles(Splitter);
+    Splitter->setSizes(Node.Sizes);
+    Splitter->setVisible(Visible);
+    return Splitter;
 }
 
 //============================================================================
-bool DockContainerWidgetPrivate::restoreDockArea(CDockingStateReader& s,
-                                                 QWidget*& CreatedWidget,
-                                                 bool Testing)
+QWidget* DockContainerWidgetPrivate::restoreDockArea(const DockStateNode& Node)
 {
-    CDockAreaWidget* DockArea = nullptr;
-    auto Result = CDockAreaWidget::restoreState(s, DockArea, Testing, _this);
-    if (Result && DockArea)
+    // Reuse an existing dock area if it contains exactly the same dock
+    // widgets - this saves the recreation of the dock area and the
+    // reparenting of all its dock widgets
+    QStringList DockWidgetNames;
+    for (const auto& WidgetState : Node.DockWidgets)
     {
-        appendDockAreas({DockArea});
+        DockWidgetNames.append(WidgetState.Name);
     }
-    CreatedWidget = DockArea;
-    return Result;
-}
-
-//============================================================================
-bool DockContainerWidgetPrivate::restoreSideBar(CDockingStateReader& s,
-                                                QWidget*& CreatedWidget,
-                                                bool Testing)
-{
-    Q_UNUSED(CreatedWidget)
-    // Simply ignore side bar auto hide widgets from saved state if
-    // auto hide support is disabled
-    if (!CDockManager::testAutoHideConfigFlag(
-            CDockManager::AutoHideFeatureEnabled))
+    CDockAreaWidget* ReusableDockArea = DockWidgetNames.isEmpty() ?
+        nullptr : ReusableDockAreas.take(dockAreaStateKey(DockWidgetNames));
+    if (ReusableDockArea)
     {
-        return true;
+        ADS_PRINT("Reuse dock area " << DockWidgetNames);
+        ReusableDockArea->restoreExistingState(Node);
+        appendDockAreas({ReusableDockArea});
+        return ReusableDockArea;
     }
 
-    bool Ok;
-    auto Area = (ads::SideBarLocation)s.attributes().value("Area").toInt(&Ok);
-    if (!Ok)
+    CDockAreaWidget* DockArea = CDockAreaWidget::restoreState(Node, _this);
+    if (DockArea)
     {
-        return false;
+        appendDockAreas({DockArea});
     }
+    return DockArea;
+}
 
-    while (s.readNextStartElement())
+//============================================================================
+void DockContainerWidgetPrivate::restoreSideBar(const SideBarState& State)
+{
+    for (const auto& WidgetState : State.DockWidgets)
     {
-        if (s.name() != QLatin1String("Widget"))
-        {
-            continue;
-        }
-
-        auto Name = s.attributes().value("Name");
-        if (Name.isEmpty())
-        {
-            return false;
-        }
-
-        bool Ok;
-        bool Closed = s.attributes().value("Closed").toInt(&Ok);
-        if (!Ok)
-        {
-            return false;
-        }
-
-        int Size = s.attributes().value("Size").toInt(&Ok);
-        if (!Ok)
-        {
-            return false;
-        }
-
-        s.skipCurrentElement();
-
-        Q_EMIT DockManager->aboutToRestoreDockWidget(Name.toString(), Testing);
-        CDockWidget* DockWidget = DockManager->findDockWidget(Name.toString());
-        if (!DockWidget || Testing)
+        Q_EMIT DockManager->aboutToRestoreDockWidget(WidgetState.Name,
+                                                     internal::Restore);
+        CDockWidget* DockWidget = DockManager->findDockWidget(WidgetState.Name);
+        if (!DockWidget)
         {
             continue;
         }
 
-        auto SideBar = _this->autoHideSideBar(Area);
+        auto SideBar = _this->autoHideSideBar(State.Area);
         CAutoHideDockContainer* AutoHideContainer;
         if (DockWidget->isAutoHide())
         {
@@ -1239,46 +1453,26 @@ bool DockContainerWidgetPrivate::restoreSideBar(CDockingStateReader& s,
         {
             AutoHideContainer = SideBar->insertDockWidget(-1, DockWidget);
         }
-        AutoHideContainer->setSize(Size);
-        DockWidget->setProperty(internal::ClosedProperty, Closed);
+        AutoHideContainer->setSize(WidgetState.Size);
+        DockWidget->setProperty(internal::ClosedProperty, WidgetState.Closed);
         AutoHideContainer->collapseView(true);
         DockWidget->setProperty(internal::DirtyProperty, false);
     }
-
-    return true;
 }
 
 //============================================================================
-bool DockContainerWidgetPrivate::restoreChildNodes(CDockingStateReader& s,
-                                                   QWidget*& CreatedWidget,
-                                                   bool Testing)
+QWidget* DockContainerWidgetPrivate::restoreChildNode(const DockStateNode& Node)
 {
-    bool Result = true;
-    while (s.readNextStartElement())
+    if (Node.Type == DockStateNode::SplitterNode)
     {
-        if (s.name() == QLatin1String("Splitter"))
-        {
-            Result = restoreSplitter(s, CreatedWidget, Testing);
-            ADS_PRINT("Splitter");
-        }
-        else if (s.name() == QLatin1String("Area"))
-        {
-            Result = restoreDockArea(s, CreatedWidget, Testing);
-            ADS_PRINT("DockAreaWidget");
-        }
-        else if (s.name() == QLatin1String("SideBar"))
-        {
-            Result = restoreSideBar(s, CreatedWidget, Testing);
-            ADS_PRINT("SideBar");
-        }
-        else
-        {
-            s.skipCurrentElement();
-            ADS_PRINT("Unknown element");
-        }
+        ADS_PRINT("Splitter");
+        return restoreSplitter(Node);
+    }
+    else
+    {
+        ADS_PRINT("DockAreaWidget");
+        return restoreDockArea(Node);
     }
-
-    return Result;
 }
 
 //============================================================================
@@ -1488,6 +1682,16 @@ CDockContainerWidget::~CDockContainerWidget()
         d->DockManager->removeDockContainer(this);
     }
 
+    // The dock areas are deleted after the private data, so they must not
+    // notify this container anymore
+    for (auto DockArea : d->DockAreas)
+    {
+        if (DockArea)
+        {
+            DockArea->disconnect(this);
+        }
+    }
+
     delete d;
 }
 
@@ -1591,11 +1795,19 @@ unsigned int CDockContainerWidget::zOrderWindowIndex() const
 void CDockContainerWidget::setZOrderWindowIndex(unsigned int idx)
 {
     d->zOrderWindowIndex = idx;
+    if (d->DockManager)
+    {
+        d->DockManager->invalidateDockContainerOrder();
+    }
 }
 
 void CDockContainerWidget::setZOrderWidgetIndex(unsigned int idx)
 {
 	d->zOrderWidgetIndex = idx;
+    if (d->DockManager)
+    {
+        d->DockManager->invalidateDockContainerOrder();
+    }
 }
 
 //============================================================================
@@ -1626,7 +1838,7 @@ bool CDockContainerWidget::event(QEvent* e)
         {
             d->DockManager->setZOrderWindowIndex(++zOrderWindowCounter);
         }
-        d->zOrderWidgetIndex = ++zOrderWidgetCounter;
+        setZOrderWidgetIndex(++zOrderWidgetCounter);
 		window()->raise();
 		e->accept();
 		return true;
@@ -1657,6 +1869,11 @@ void CDockContainerWidget::addDockArea(CDockAreaWidget* DockAreaWidget,
 void CDockContainerWidget::removeDockArea(CDockAreaWidget* area)
 {
     ADS_PRINT("CDockContainerWidget::removeDockArea");
+    if (d->DockManager)
+    {
+        d->DockManager->notifyLayoutMutation(this);
+    }
+
     // If it is an auto hide area, then there is nothing much to do
     if (area->isAutoHide())
     {
@@ -1667,8 +1884,21 @@ void CDockContainerWidget::removeDockArea(CDockAreaWidget* area)
     area->disconnect(this);
     d->IndependentDWCount -= area->independentDockWidgetCount();
     d->DockAreas.removeAll(area);
+    d->DockAreaIndexValid = false;
+    d->invalidateDockAreaLists();
     auto Splitter = area->parentSplitter();
 
+    // While the state is restored, the old splitters may still be reused
+    // and the root splitter is replaced at the end, so the emptied area is
+    // only detached. restoreState() removes the leftover splitters after
+    // the restored tree has been installed
+    if (d->RestoringState)
+    {
+        area->setParent(nullptr);
+        d->emitDockAreasRemoved();
+        return;
+    }
+
     // Remove are from parent splitter and recursively hide tree of parent
     // splitters if it has no visible content
     area->setParent(nullptr);
@@ -1732,11 +1962,18 @@ void CDockContainerWidget::removeDockArea(CDockAreaWidget* area)
 
 emitAndExit:
     updateSplitterHandles(Splitter);
-    CDockWidget* TopLevelWidget = topLevelDockWidget();
+    if (d->isLayoutUpdateDeferred())
+    {
+        d->TopLevelEventPending = true;
+    }
+    else
+    {
+        CDockWidget* TopLevelWidget = topLevelDockWidget();
 
-    // Updated the title bar visibility of the dock widget if there is only
-    // one single visible dock widget
-    CDockWidget::emitTopLevelEventForWidget(TopLevelWidget, true);
+        // Updated the title bar visibility of the dock widget if there is
+        // only one single visible dock widget
+        CDockWidget::emitTopLevelEventForWidget(TopLevelWidget, true);
+    }
     dumpLayout();
     d->emitDockAreasRemoved();
 }
@@ -1746,20 +1983,82 @@ QList<QPointer<CDockAreaWidget>> CDockContainerWidget::removeAllDockAreas()
 {
     auto Result = d->DockAreas;
     d->DockAreas.clear();
+    d->DockAreaIndexValid = false;
+    d->invalidateDockAreaLists();
     d->IndependentDWCount = 0;
     return Result;
 }
 
+//============================================================================
+void CDockContainerWidget::commitLayoutUpdate()
+{
+    d->commitLayoutUpdate();
+}
+
+//============================================================================
+bool CDockContainerWidget::deferTitleBarVisibilityUpdate()
+{
+    if (!d->isLayoutUpdateDeferred())
+    {
+        return false;
+    }
+
+    d->TitleBarVisibilityDirty = true;
+    return true;
+}
+
+//============================================================================
+void CDockContainerWidget::invalidateDockAreaLists()
+{
+    d->invalidateDockAreaLists();
+}
+
+//============================================================================
+void CDockContainerWidget::invalidateDockWidgetLists()
+{
+    d->DockWidgetListsValid = false;
+}
+
+//============================================================================
+void CDockContainerWidget::invalidateDockAreaIndex()
+{
+    d->DockAreaIndexValid = false;
+}
+
 //============================================================================
 CDockAreaWidget* CDockContainerWidget::dockAreaAt(const QPoint& GlobalPos) const
 {
-    for (const auto& DockArea : d->DockAreas)
+    if (!d->DockAreaIndexValid)
     {
-        if (DockArea && DockArea->isVisible()
-            && DockArea->rect().contains(DockArea->mapFromGlobal(GlobalPos)))
+        d->updateDockAreaIndex();
+    }
+
+    // Find the column via binary search on the x edges and then the dock
+    // area in this column via binary search on the top edges
+    const QPoint Pos = mapFromGlobal(GlobalPos);
+    const auto& Edges = d->DockAreaIndexEdges;
+    int Column = std::upper_bound(Edges.cbegin(), Edges.cend(), Pos.x())
+        - Edges.cbegin() - 1;
+    if (Column < 0 || Column >= d->DockAreaIndexColumns.count())
+    {
+        return nullptr;
+    }
+
+    const auto& Entries = d->DockAreaIndexColumns[Column];
+    auto it = std::upper_bound(Entries.cbegin(), Entries.cend(), Pos.y(),
+        [](int y, const DockContainerWidgetPrivate::DockAreaIndexEntry& Entry)
         {
-            return DockArea;
-        }
+            return y < Entry.Rect.top();
+        });
+    if (it == Entries.cbegin())
+    {
+        return nullptr;
+    }
+
+    --it;
+    if (it->DockArea && it->DockArea->isVisible() && it->Rect.contains(Pos))
+    {
+        return it->DockArea;
     }
 
     return nullptr;
@@ -1786,17 +2085,7 @@ int CDockContainerWidget::dockAreaCount() const
 //============================================================================
 int CDockContainerWidget::visibleDockAreaCount() const
 {
-    int Result = 0;
-    for (auto DockArea : d->DockAreas)
-    {
-        Result += (!DockArea || DockArea->isHidden()) ? 0 : 1;
-    }
-
-    return Result;
-
-    // TODO Cache or precalculate this to speed it up because it is used during
-    // movement of floating widget
-    // return d->visibleDockAreaCount();
+    return openedDockAreas().count();
 }
 
 //============================================================================
@@ -1889,6 +2178,7 @@ void CDockContainerWidget::dropFloatingWidget(
         d->DockManager->notifyWidgetOrAreaRelocation(SingleDroppedDockWidget);
     }
     d->DockManager->notifyFloatingWidgetDrop(FloatingWidget);
+    d->DockManager->notifyLayoutMutation(this);
 }
 
 //============================================================================
@@ -1916,148 +2206,167 @@ void CDockContainerWidget::dropWidget(QWidget* Widget, DockWidgetArea DropArea,
 
     window()->activateWindow();
     d->DockManager->notifyWidgetOrAreaRelocation(Widget);
+    d->DockManager->notifyLayoutMutation(this);
 }
 
 //============================================================================
 QList<CDockAreaWidget*> CDockContainerWidget::openedDockAreas() const
 {
-    QList<CDockAreaWidget*> Result;
-    for (auto DockArea : d->DockAreas)
+    if (!d->OpenedDockAreasValid)
     {
-        if (DockArea && !DockArea->isHidden())
-        {
-            Result.append(DockArea);
-        }
+        d->updateOpenedDockAreas();
     }
-
-    return Result;
+    return d->OpenedDockAreas;
 }
 
 //============================================================================
 QList<CDockWidget*> CDockContainerWidget::openedDockWidgets() const
 {
-    QList<CDockWidget*> DockWidgetList;
-    for (auto DockArea : d->DockAreas)
+    if (!d->DockWidgetListsValid)
     {
-        if (DockArea && !DockArea->isHidden())
-        {
-            DockWidgetList.append(DockArea->openedDockWidgets());
-        }
+        d->updateDockWidgetLists();
     }
-
-    return DockWidgetList;
+    return d->OpenedDockWidgets;
 }
 
 //============================================================================
 bool CDockContainerWidget::hasOpenDockAreas() const
 {
-    for (auto DockArea : d->DockAreas)
-    {
-        if (DockArea && !DockArea->isHidden())
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return visibleDockAreaCount() > 0;
 }
 
 //============================================================================
 void CDockContainerWidget::saveState(QXmlStreamWriter& s) const
+{
+    ContainerState State;
+    saveState(State);
+    CDockingStateWriter::writeContainer(s, State);
+}
+
+//============================================================================
+void CDockContainerWidget::saveState(ContainerState& State) const
 {
     ADS_PRINT("CDockContainerWidget::saveState isFloating " << isFloating());
 
-    s.writeStartElement("Container");
-    s.writeAttribute("Independent",
-                     QString::number(hasIndependentWidget() ? 1 : 0));
-    s.writeAttribute("Floating", QString::number(isFloating() ? 1 : 0));
+    State.Independent = hasIndependentWidget();
+    State.Floating = isFloating();
     if (isFloating())
     {
-        CFloatingDockContainer* FloatingWidget = floatingWidget();
-        QByteArray Geometry = FloatingWidget->saveGeometry();
-#if QT_VERSION < 0x050900
-        s.writeTextElement("Geometry", qByteArrayToHex(Geometry, ' '));
-#else
-        s.writeTextElement("Geometry", Geometry.toHex(' '));
-#endif
+        State.Geometry = floatingWidget()->saveGeometry();
     }
-    d->saveChildNodesState(s, d->RootSplitter);
-    d->saveAutoHideWidgetsState(s);
-    s.writeEndElement();
+    State.HasRootNode = d->saveChildNodesState(State.RootNode, d->RootSplitter);
+    d->saveAutoHideWidgetsState(State);
 }
 
 //============================================================================
-bool CDockContainerWidget::restoreState(CDockingStateReader& s, bool Testing)
+void CDockContainerWidget::restoreState(const ContainerState& State)
 {
-    bool IsFloating = s.attributes().value("Floating").toInt();
-    ADS_PRINT("Restore CDockContainerWidget Floating" << IsFloating);
+    ADS_PRINT("Restore CDockContainerWidget Floating" << State.Floating);
 
-    QWidget* NewRootSplitter{};
-    if (!Testing)
+    // Existing dock areas are not deleted up front. All dock areas that
+    // contain exactly the same dock widgets like a dock area in the restored
+    // state are reused. Only the remaining dock areas are deleted after the
+    // restore
+    d->VisibleDockAreaCount = -1;  // invalidate the dock area count
+    d->RestoringState = true;
+    auto OldDockAreas = d->DockAreas;
+    QList<QPointer<QSplitter>> OldSplitters;
+    if (d->RootSplitter)
     {
-        d->VisibleDockAreaCount = -1;  // invalidate the dock area count
-        for (int i = 0; i < d->DockAreas.count(); i++)
+        OldSplitters.append(d->RootSplitter);
+        for (auto Splitter : d->RootSplitter->findChildren<QSplitter*>())
         {
-            d->DockAreas[i]->hide();
-            d->Layout->removeWidget(d->DockAreas[i]);
-            d->DockAreas[i]->deleteLater();
+            OldSplitters.append(Splitter);
         }
-        d->DockAreas.clear();
-        std::fill(std::begin(d->LastAddedAreaCache),
-                  std::end(d->LastAddedAreaCache), nullptr);
-        d->TopLevelDockArea = nullptr;
     }
-    if (IsFloating)
+    d->DockAreas.clear();
+    d->DockAreaIndexValid = false;
+    d->invalidateDockAreaLists();
+    for (const auto& DockArea : OldDockAreas)
     {
-        ADS_PRINT("Restore floating widget");
-        if (!s.readNextStartElement() || s.name() != QLatin1String("Geometry"))
-        {
-            return false;
-        }
-
-        QByteArray GeometryString =
-            s.readElementText(CDockingStateReader::ErrorOnUnexpectedElement)
-                .toLocal8Bit();
-        QByteArray Geometry = QByteArray::fromHex(GeometryString);
-        if (Geometry.isEmpty())
+        if (!DockArea || DockArea->isAutoHide() || !DockArea->dockWidgetsCount())
         {
-            return false;
+            continue;
         }
 
-        if (!Testing)
+        QStringList DockWidgetNames;
+        for (auto DockWidget : DockArea->dockWidgets())
         {
-            CFloatingDockContainer* FloatingWidget = floatingWidget();
-            if (FloatingWidget)
-            {
-                FloatingWidget->restoreGeometry(Geometry);
-            }
+            DockWidgetNames.append(DockWidget->objectName());
         }
+        // A reused dock area is connected again when it is appended
+        DockArea->disconnect(this);
+        d->ReusableDockAreas.insert(dockAreaStateKey(DockWidgetNames), DockArea);
     }
+    std::fill(std::begin(d->LastAddedAreaCache),
+              std::end(d->LastAddedAreaCache), nullptr);
+    d->TopLevelDockArea = nullptr;
 
-    if (!d->restoreChildNodes(s, NewRootSplitter, Testing))
+    if (State.Floating)
     {
-        return false;
+        ADS_PRINT("Restore floating widget");
+        CFloatingDockContainer* FloatingWidget = floatingWidget();
+        if (FloatingWidget)
+        {
+            FloatingWidget->restoreGeometry(State.Geometry);
+        }
     }
 
-    if (Testing)
+    QWidget* NewRootSplitter =
+        State.HasRootNode ? d->restoreChildNode(State.RootNode) : nullptr;
+    for (const auto& SideBar : State.SideBars)
     {
-        return true;
+        d->restoreSideBar(SideBar);
     }
 
-    // If the root splitter is empty, rostoreChildNodes returns a 0 pointer
+    // If the root splitter is empty, restoreChildNode returns a 0 pointer
     // and we need to create a new empty root splitter
     if (!NewRootSplitter)
     {
         NewRootSplitter = d->newSplitter(Qt::Horizontal);
     }
 
-    QLayoutItem* li = d->Layout->replaceWidget(d->RootSplitter, NewRootSplitter);
-    auto OldRoot = d->RootSplitter;
-    d->RootSplitter = qobject_cast<CDockSplitter*>(NewRootSplitter);
-    OldRoot->deleteLater();
-    delete li;
+    if (NewRootSplitter != d->RootSplitter)
+    {
+        QLayoutItem* li = d->Layout->replaceWidget(d->RootSplitter, NewRootSplitter);
+        // If the old root splitter has been reused as a child node of the
+        // new root splitter, it is not in the layout anymore
+        if (!li)
+        {
+            d->Layout->addWidget(NewRootSplitter, 1, 1);
+        }
+        d->RootSplitter = qobject_cast<CDockSplitter*>(NewRootSplitter);
+        delete li;
+    }
 
-    return true;
+    // Now that the restored tree is installed, the old dock areas and
+    // splitters that are not part of it are removed
+    for (const auto& DockArea : OldDockAreas)
+    {
+        if (!DockArea || d->DockAreas.contains(DockArea))
+        {
+            continue;
+        }
+
+        DockArea->hide();
+        d->Layout->removeWidget(DockArea);
+        DockArea->deleteLater();
+    }
+
+    for (const auto& Splitter : OldSplitters)
+    {
+        if (!Splitter || Splitter == NewRootSplitter
+         || NewRootSplitter->isAncestorOf(Splitter))
+        {
+            continue;
+        }
+
+        Splitter->hide();
+        Splitter->deleteLater();
+    }
+    d->ReusableDockAreas.clear();
+    d->ReusedSplitters.clear();
+    d->RestoringState = false;
 }
 
 //============================================================================
@@ -2135,13 +2444,8 @@ CDockAreaWidget* CDockContainerWidget::lastAddedDockAreaWidget(
 //============================================================================
 bool CDockContainerWidget::hasTopLevelDockWidget() const
 {
-    auto DockAreas = openedDockAreas();
-    if (DockAreas.count() != 1)
-    {
-        return false;
-    }
-
-    return DockAreas[0]->openDockWidgetsCount() == 1;
+    auto TopLevelDockArea = topLevelDockArea();
+    return TopLevelDockArea && TopLevelDockArea->openDockWidgetsCount() == 1;
 }
 
 //============================================================================
@@ -2199,17 +2503,11 @@ CDockAreaWidget* CDockContainerWidget::topLevelDockArea() const
 //============================================================================
 QList<CDockWidget*> CDockContainerWidget::dockWidgets() const
 {
-    QList<CDockWidget*> Result;
-    for (const auto& DockArea : d->DockAreas)
+    if (!d->DockWidgetListsValid)
     {
-        if (!DockArea)
-        {
-            continue;
-        }
-        Result.append(DockArea->dockWidgets());
+        d->updateDockWidgetLists();
     }
-
-    return Result;
+    return d->DockWidgets;
 }
 
 //============================================================================
@@ -2262,6 +2560,8 @@ void CDockContainerWidget::clear()
         }
     }
     d->DockAreas.clear();
+    d->DockAreaIndexValid = false;
+    d->invalidateDockAreaLists();
     std::fill(std::begin(d->LastAddedAreaCache), std::end(d->LastAddedAreaCache),
               nullptr);
     d->TopLevelDockArea = nullptr;
@@ -2372,7 +2672,7 @@ void CDockContainerWidget::raise()
 	{
 		d->DockManager->setZOrderWindowIndex(++zOrderWindowCounter);
 	}
-	d->zOrderWidgetIndex = ++zOrderWidgetCounter;
+	setZOrderWidgetIndex(++zOrderWidgetCounter);
 	window()->raise();
 }
 
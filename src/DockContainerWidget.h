@@ -49,7 +49,7 @@ class CFloatingDockContainer;
 struct FloatingDockContainerPrivate;
 class CFloatingDragPreview;
 struct FloatingDragPreviewPrivate;
-class CDockingStateReader;
+struct ContainerState;
 class CAutoHideSideBar;
 class CAutoHideTab;
 class CDockSplitter;
@@ -85,6 +85,7 @@ private:
     friend AutoHideTabPrivate;
     friend AutoHideDockContainerPrivate;
     friend CAutoHideSideBar;
+    friend class CDockSplitter;
 
 protected:
     /**
@@ -111,6 +112,39 @@ protected:
      */
     void createRootSplitter();
 
+    /**
+     * Invalidates the spatial index of the visible dock areas that is used
+     * by dockAreaAt(). The index is rebuilt on the next hit test.
+     */
+    void invalidateDockAreaIndex();
+
+    /**
+     * Invalidates the cached lists of the open dock areas and of the dock
+     * widgets. Called if the visibility of a dock area changes.
+     */
+    void invalidateDockAreaLists();
+
+    /**
+     * Invalidates the cached lists of the dock widgets. Called if dock
+     * widgets are added to or removed from a dock area of this container or
+     * if their closed state changes.
+     */
+    void invalidateDockWidgetLists();
+
+    /**
+     * Applies the layout updates that have been deferred during a layout
+     * update transaction of the dock manager.
+     * \see CDockManager::beginLayoutUpdate()
+     */
+    void commitLayoutUpdate();
+
+    /**
+     * Returns true, if the dock manager is in a layout update transaction.
+     * In this case the title bar visibility of all dock areas of this
+     * container is updated when the transaction is committed.
+     */
+    bool deferTitleBarVisibilityUpdate();
+
     /**
      * Helper function for creation of the side tab bar widgets
      */
@@ -154,12 +188,16 @@ protected:
     void saveState(QXmlStreamWriter& Stream) const;
 
     /**
-     * Restores the state from given stream.
-     * If Testing is true, the function only parses the data from the given
-     * stream but does not restore anything. You can use this check for
-     * faulty files before you start restoring the state
+     * Saves the state into the given in-memory container state
+     */
+    void saveState(ContainerState& State) const;
+
+    /**
+     * Restores the state from the given parsed container state.
+     * The state needs to be parsed and validated via CDockingStateReader
+     * before it is passed to this function.
      */
-    bool restoreState(CDockingStateReader& Stream, bool Testing);
+    void restoreState(const ContainerState& State);
 
     /**
      * This function returns the last added dock area widget for the given
@@ -185,8 +223,10 @@ protected:
      * It may be possible, depending on the implementation, that dock widgets,
      * that are not visible to the user have no parent widget. Therefore simply
      * calling findChildren() would not work here. Therefore this function
-     * iterates over all dock areas and creates a list that contains all
-     * dock widgets returned from all dock areas.
+     * returns a list that contains all dock widgets returned from all dock
+     * areas. The list is cached and only rebuilt if dock areas or dock
+     * widgets have been added or removed, so calling this function
+     * repeatedly does not allocate.
      */
     QList<CDockWidget*> dockWidgets() const;
 
@@ -272,7 +312,9 @@ public:
 
     /**
      * Returns the dock area at the given global position or 0 if there is no
-     * dock area at this position
+     * dock area at this position.
+     * The lookup uses a cached spatial index of the visible dock areas, so
+     * it is cheap enough to be called on every mouse move during dragging.
      */
     CDockAreaWidget* dockAreaAt(const QPoint& GlobalPos) const;
 
@@ -289,7 +331,8 @@ public:
     QList<CDockAreaWidget*> openedDockAreas() const;
 
     /**
-     * Returns a list for all open dock widgets in all open dock areas
+     * Returns a list for all open dock widgets in all open dock areas.
+     * Like dockWidgets(), the list is cached and not rebuilt for each call.
      */
     QList<CDockWidget*> openedDockWidgets() const;
 
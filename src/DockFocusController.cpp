@@ -12,7 +12,9 @@
 
 #include <QAbstractButton>
 #include <QApplication>
+#include <QHash>
 #include <QPointer>
+#include <QTimer>
 #include <QWindow>
 
 #include <AutoHideTab.h>
@@ -33,6 +35,24 @@ namespace ads
 {
 static const char* const FocusedDockWidgetProperty = "FocusedDockWidget";
 
+/**
+ * Function that repolishes the style of a widget after its focused
+ * property changed
+ */
+using FocusStylePolishFunction = void (*)(QWidget*);
+
+/**
+ * A focus style update that has been deferred until the next event loop
+ * iteration. WasFocused stores the focused property value the widget had
+ * before the first change in this iteration.
+ */
+struct PendingFocusStyle
+{
+    QPointer<QWidget> Widget;
+    FocusStylePolishFunction Polish = nullptr;
+    bool WasFocused = false;
+};
+
 /**
  * Private data class of CDockFocusController class (pimpl)
  */
@@ -48,12 +68,35 @@ struct DockFocusControllerPrivate
     CDockManager* DockManager;
     bool ForceFocusChangedSignal = false;
     bool TabPressed = false;
+    QHash<QWidget*, PendingFocusStyle> PendingFocusStyles;
+    bool FocusStyleUpdateScheduled = false;
+    quint64 FocusStylePolishCount = 0;
 
     /**
      * Private data constructor
      */
     DockFocusControllerPrivate(CDockFocusController* _public);
 
+    /**
+     * Sets the focused property of the given widget and repolishes its
+     * style. If the BatchedFocusStyleUpdates performance flag is set, the
+     * repolish is deferred to the next event loop iteration, so that
+     * multiple focus changes result in a single style update per widget.
+     */
+    void updateFocusStyle(QWidget* Widget, bool Focused,
+                          FocusStylePolishFunction Polish);
+
+    /**
+     * Repolishes all widgets with a deferred focus style update, if
+     * their focused property really changed
+     */
+    void flushFocusStyles();
+
+    void updateDockWidgetFocusStyle(CDockWidget* DockWidget, bool Focused);
+    void updateDockAreaFocusStyle(CDockAreaWidget* DockArea, bool Focused);
+    void updateFloatingWidgetFocusStyle(CFloatingDockContainer* FloatingWidget,
+                                        bool Focused);
+
     /**
      * This function updates the focus style of the given dock widget and
      * the dock area that it belongs to
@@ -62,29 +105,123 @@ struct DockFocusControllerPrivate
 };  // struct DockFocusControllerPrivate
 
 //===========================================================================
-static void updateDockWidgetFocusStyle(CDockWidget* DockWidget, bool Focused)
+static bool batchedFocusStyleUpdates()
+{
+    return CDockManager::testPerformanceConfigFlag(
+        CDockManager::BatchedFocusStyleUpdates);
+}
+
+//===========================================================================
+static void polishDockWidgetFocusStyle(QWidget* Widget)
+{
+    // Style sheets evaluate [focused="true"] selectors only when a widget is
+    // polished, so the tab still needs a repolish. The focus highlighting
+    // rules do not match the dock widget itself, so batched updates only
+    // repaint it
+    auto DockWidget = static_cast<CDockWidget*>(Widget);
+    DockWidget->tabWidget()->updateStyle();
+    if (batchedFocusStyleUpdates())
+    {
+        DockWidget->update();
+    }
+    else
+    {
+        internal::repolishStyle(DockWidget);
+    }
+    DockWidget->tabWidget()->update();
+}
+
+//===========================================================================
+static void polishDockAreaFocusStyle(QWidget* Widget)
+{
+    // The focus highlighting rules only match the title bar of a focused
+    // dock area, so batched updates only repaint the dock area itself
+    auto DockArea = static_cast<CDockAreaWidget*>(Widget);
+    if (!batchedFocusStyleUpdates())
+    {
+        internal::repolishStyle(DockArea);
+    }
+    internal::repolishStyle(DockArea->titleBar());
+    DockArea->titleBar()->update();
+    DockArea->update();
+}
+
+//===========================================================================
+static void polishFloatingTitleBarFocusStyle(QWidget* Widget)
+{
+    static_cast<CFloatingWidgetTitleBar*>(Widget)->updateStyle();
+}
+
+//===========================================================================
+void DockFocusControllerPrivate::updateFocusStyle(QWidget* Widget, bool Focused,
+    FocusStylePolishFunction Polish)
+{
+    if (!batchedFocusStyleUpdates())
+    {
+        Widget->setProperty("focused", Focused);
+        Polish(Widget);
+        FocusStylePolishCount++;
+        return;
+    }
+
+    auto it = PendingFocusStyles.constFind(Widget);
+    if (it == PendingFocusStyles.constEnd() || !it->Widget)
+    {
+        PendingFocusStyle Pending;
+        Pending.Widget = Widget;
+        Pending.Polish = Polish;
+        Pending.WasFocused = Widget->property("focused").toBool();
+        PendingFocusStyles.insert(Widget, Pending);
+    }
+    Widget->setProperty("focused", Focused);
+
+    if (!FocusStyleUpdateScheduled)
+    {
+        FocusStyleUpdateScheduled = true;
+        QTimer::singleShot(0, _this, [this]() { flushFocusStyles(); });
+    }
+}
+
+//===========================================================================
+void DockFocusControllerPrivate::flushFocusStyles()
+{
+    FocusStyleUpdateScheduled = false;
+    auto Pending = std::move(PendingFocusStyles);
+    PendingFocusStyles.clear();
+    for (const auto& Entry : Pending)
+    {
+        // If the focus left a widget and came back in the same event loop
+        // iteration, then its style does not need to be updated
+        if (!Entry.Widget
+            || Entry.Widget->property("focused").toBool() == Entry.WasFocused)
+        {
+            continue;
+        }
+
+        Entry.Polish(Entry.Widget);
+        FocusStylePolishCount++;
+    }
+}
+
+//===========================================================================
+void DockFocusControllerPrivate::updateDockWidgetFocusStyle(
+    CDockWidget* DockWidget, bool Focused)
 {
-    DockWidget->setProperty("focused", Focused);
     DockWidget->tabWidget()->setProperty("focused", Focused);
-	DockWidget->tabWidget()->updateStyle();
-	internal::repolishStyle(DockWidget);
-	DockWidget->tabWidget()->update();
+    updateFocusStyle(DockWidget, Focused, polishDockWidgetFocusStyle);
 }
 
 //===========================================================================
-static void updateDockAreaFocusStyle(CDockAreaWidget* DockArea, bool Focused)
+void DockFocusControllerPrivate::updateDockAreaFocusStyle(
+    CDockAreaWidget* DockArea, bool Focused)
 {
-    DockArea->setProperty("focused", Focused);
-    internal::repolishStyle(DockArea);
-	internal::repolishStyle(DockArea->titleBar());
-	DockArea->titleBar()->update();
-	DockArea->update();
+    updateFocusStyle(DockArea, Focused, polishDockAreaFocusStyle);
 }
 
 //===========================================================================
 /*#ifdef Q_OS_LINUX*/
-static void updateFloatingWidgetFocusStyle(CFloatingDockContainer* FloatingWidget,
-                                           bool Focused)
+void DockFocusControllerPrivate::updateFloatingWidgetFocusStyle(
+    CFloatingDockContainer* FloatingWidget, bool Focused)
 {
     if (FloatingWidget->hasNativeTitleBar())
     {
@@ -96,8 +233,7 @@ static void updateFloatingWidgetFocusStyle(CFloatingDockContainer* FloatingWidge
     {
         return;
     }
-    TitleBar->setProperty("focused", Focused);
-    TitleBar->updateStyle();
+    updateFocusStyle(TitleBar, Focused, polishFloatingTitleBarFocusStyle);
 }
 /*#endif*/
 
@@ -315,7 +451,7 @@ void CDockFocusController::setDockWidgetTabFocused(CDockWidgetTab* Tab)
 void CDockFocusController::clearDockWidgetFocus(CDockWidget* dockWidget)
 {
     dockWidget->clearFocus();
-    updateDockWidgetFocusStyle(dockWidget, false);
+    d->updateDockWidgetFocusStyle(dockWidget, false);
 }
 
 //===========================================================================
@@ -402,7 +538,7 @@ void CDockFocusController::onStateRestored()
 {
     if (d->FocusedDockWidget)
     {
-        updateDockWidgetFocusStyle(d->FocusedDockWidget, false);
+        d->updateDockWidgetFocusStyle(d->FocusedDockWidget, false);
     }
 }
 
@@ -417,6 +553,18 @@ void CDockFocusController::setDockWidgetTabPressed(bool Value)
 {
     d->TabPressed = Value;
 }
+
+//==========================================================================
+quint64 CDockFocusController::focusStylePolishCount() const
+{
+    return d->FocusStylePolishCount;
+}
+
+//==========================================================================
+void CDockFocusController::resetFocusStylePolishCount()
+{
+    d->FocusStylePolishCount = 0;
+}
 }  // namespace ads
 
 //---------------------------------------------------------------------------
@@ -87,6 +87,19 @@ public:
      */
     void setDockWidgetTabPressed(bool Value);
 
+    /**
+     * Returns the number of focus style repolish operations. Each operation
+     * repolishes one dock widget with its tab, one dock area with its
+     * title bar or one floating widget title bar.
+     * \see CDockManager::BatchedFocusStyleUpdates
+     */
+    quint64 focusStylePolishCount() const;
+
+    /**
+     * Resets the counter returned by focusStylePolishCount()
+     */
+    void resetFocusStylePolishCount();
+
 public Q_SLOTS:
     /**
      * Request a focus change to the given dock widget
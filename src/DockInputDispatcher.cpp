@@ -0,0 +1,247 @@
+//============================================================================
+/// \file   DockInputDispatcher.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockInputDispatcher
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockInputDispatcher.h"
+
+#include <QApplication>
+#include <QEvent>
+#include <QWidget>
+
+namespace ads
+{
+/**
+ * Maps the given event to the dispatcher event type. Returns an empty
+ * flag set for all events the dispatcher is not interested in
+ */
+static CDockInputDispatcher::EventTypes dispatchTypeOf(const QEvent* event)
+{
+    switch (event->type())
+    {
+    case QEvent::MouseButtonPress: return CDockInputDispatcher::MouseButtonPressEvents;
+    case QEvent::MouseMove: return CDockInputDispatcher::MouseMoveEvents;
+    case QEvent::KeyPress: return CDockInputDispatcher::KeyPressEvents;
+    case QEvent::Resize: return CDockInputDispatcher::ScopeResizeEvents;
+    default: break;
+    }
+
+    // We cannot use the registered drag start event types in a switch case
+    if (event->type() == internal::FloatingWidgetDragStartEvent
+        || event->type() == internal::DockedWidgetDragStartEvent)
+    {
+        return CDockInputDispatcher::DragStartEvents;
+    }
+
+    return CDockInputDispatcher::EventTypes();
+}
+
+//============================================================================
+CDockInputDispatcher::CDockInputDispatcher(QObject* parent) : Super(parent)
+{
+}
+
+//============================================================================
+CDockInputDispatcher::~CDockInputDispatcher()
+{
+    if (FilterInstalled)
+    {
+        qApp->removeEventFilter(this);
+    }
+}
+
+//============================================================================
+void CDockInputDispatcher::registerClient(QObject* Client, EventTypes Types,
+                                          QWidget* Scope)
+{
+    if (!Client)
+    {
+        return;
+    }
+
+    Registration* Existing = nullptr;
+    for (auto& Entry : Clients)
+    {
+        if (Entry.Client == Client)
+        {
+            Existing = &Entry;
+            break;
+        }
+    }
+
+    if (!Existing)
+    {
+        Clients.append(Registration());
+        Existing = &Clients.last();
+        Existing->Client = Client;
+        connect(Client, &QObject::destroyed, this,
+                &CDockInputDispatcher::onClientDestroyed);
+    }
+
+    Existing->Types = Types;
+    Existing->Scope = Scope;
+    Existing->ScopeWindow = Scope ? Scope->window() : nullptr;
+    updateRegistrations();
+}
+
+//============================================================================
+void CDockInputDispatcher::unregisterClient(QObject* Client)
+{
+    for (int i = 0; i < Clients.count(); ++i)
+    {
+        if (Clients.at(i).Client == Client)
+        {
+            disconnect(Client, &QObject::destroyed, this,
+                       &CDockInputDispatcher::onClientDestroyed);
+            Clients.remove(i);
+            updateRegistrations();
+            return;
+        }
+    }
+}
+
+//============================================================================
+bool CDockInputDispatcher::isClientRegistered(QObject* Client) const
+{
+    for (const auto& Entry : Clients)
+    {
+        if (Entry.Client == Client)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//============================================================================
+void CDockInputDispatcher::onClientDestroyed(QObject* Client)
+{
+    for (int i = 0; i < Clients.count(); ++i)
+    {
+        if (Clients.at(i).Client == Client)
+        {
+            Clients.remove(i);
+            updateRegistrations();
+            return;
+        }
+    }
+}
+
+//============================================================================
+void CDockInputDispatcher::updateRegistrations()
+{
+    RegisteredTypes = EventTypes();
+    UnscopedMousePressClients = false;
+    ScopeWindows.clear();
+    for (const auto& Entry : Clients)
+    {
+        RegisteredTypes |= Entry.Types;
+        if (!(Entry.Types & MouseButtonPressEvents))
+        {
+            continue;
+        }
+
+        if (!Entry.ScopeWindow)
+        {
+            UnscopedMousePressClients = true;
+        }
+        else if (!ScopeWindows.contains(Entry.ScopeWindow))
+        {
+            ScopeWindows.append(Entry.ScopeWindow);
+        }
+    }
+
+    // The application event filter is only installed while there are
+    // clients that need it
+    const bool NeedsFilter = !Clients.isEmpty();
+    if (NeedsFilter == FilterInstalled)
+    {
+        return;
+    }
+
+    FilterInstalled = NeedsFilter;
+    if (NeedsFilter)
+    {
+        qApp->installEventFilter(this);
+    }
+    else
+    {
+        qApp->removeEventFilter(this);
+    }
+}
+
+//============================================================================
+bool CDockInputDispatcher::eventFilter(QObject* watched, QEvent* event)
+{
+    const auto Type = dispatchTypeOf(event);
+    if (!(RegisteredTypes & Type))
+    {
+        return false;
+    }
+
+    // Mouse presses are delivered to every widget in the application.
+    // Clients are only interested in presses into the window of their scope
+    // widget, so we can skip all other windows with a single lookup
+    QWidget* Window = nullptr;
+    if (Type == MouseButtonPressEvents)
+    {
+        auto Widget = qobject_cast<QWidget*>(watched);
+        if (!Widget)
+        {
+            return false;
+        }
+        Window = Widget->window();
+        if (!UnscopedMousePressClients && !ScopeWindows.contains(Window))
+        {
+            return false;
+        }
+    }
+
+    // Clients may register or unregister while we dispatch the event. The
+    // copy is cheap because of implicit sharing and only detaches if the
+    // registrations change
+    const auto Registrations = Clients;
+    for (const auto& Entry : Registrations)
+    {
+        if (!(Entry.Types & Type))
+        {
+            continue;
+        }
+
+        if (Type == ScopeResizeEvents && watched != Entry.Scope.data()
+            && watched->parent() != Entry.Scope.data())
+        {
+            continue;
+        }
+
+        if (Type == MouseButtonPressEvents && Entry.ScopeWindow
+            && Entry.ScopeWindow != Window)
+        {
+            continue;
+        }
+
+        // Skip clients that have been unregistered or destroyed by a
+        // previous client
+        if ((Registrations.count() > 1) && !isClientRegistered(Entry.Client))
+        {
+            continue;
+        }
+
+        if (Entry.Client->eventFilter(watched, event))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockInputDispatcher.cpp
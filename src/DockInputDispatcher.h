@@ -0,0 +1,113 @@
+#ifndef DockInputDispatcherH
+#define DockInputDispatcherH
+//============================================================================
+/// \file   DockInputDispatcher.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockInputDispatcher
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+
+#include "ads_globals.h"
+
+QT_FORWARD_DECLARE_CLASS(QWidget)
+
+namespace ads
+{
+/**
+ * Application wide input event dispatcher of a dock manager.
+ * Auto hide containers, resize handles and drag previews need to see
+ * input events of the whole application, e.g. to collapse an auto hide
+ * widget if the user clicks somewhere else or to cancel a drag operation
+ * if the user presses escape. Instead of installing one application event
+ * filter per component, the components register as clients of the
+ * dispatcher of their dock manager. The dispatcher installs a single
+ * application event filter only while clients are registered and
+ * forwards only the event types a client registered for to the
+ * eventFilter() function of the client.
+ */
+class CDockInputDispatcher : public QObject
+{
+    Q_OBJECT
+public:
+    using Super = QObject;
+
+    /**
+     * The event types a client can register for
+     */
+    enum eEventType
+    {
+        MouseButtonPressEvents = 0x01,
+        MouseMoveEvents = 0x02,
+        KeyPressEvents = 0x04,
+        ScopeResizeEvents = 0x08,  ///< resizes of the scope and its children
+        DragStartEvents = 0x10     ///< floating and docked drag start events
+    };
+    Q_DECLARE_FLAGS(EventTypes, eEventType)
+
+    /**
+     * Creates the dispatcher
+     */
+    CDockInputDispatcher(QObject* parent = nullptr);
+
+    /**
+     * Virtual destructor
+     */
+    virtual ~CDockInputDispatcher();
+
+    /**
+     * Registers the given client for the given event types.
+     * If a Scope widget is given, mouse press events are only forwarded if
+     * the receiver is in the same window as the scope widget. Resize events
+     * are only forwarded for the scope widget and its direct children.
+     * Registering a client twice replaces the previous registration. The
+     * client is unregistered automatically if it is destroyed.
+     */
+    void registerClient(QObject* Client, EventTypes Types,
+                        QWidget* Scope = nullptr);
+
+    /**
+     * Unregisters the given client. It is safe to call this function from
+     * the eventFilter() function of a client.
+     */
+    void unregisterClient(QObject* Client);
+
+    /**
+     * Returns true, if the given client is registered
+     */
+    bool isClientRegistered(QObject* Client) const;
+
+protected:
+    virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    struct Registration
+    {
+        QObject* Client = nullptr;
+        EventTypes Types;
+        QPointer<QWidget> Scope;
+        QWidget* ScopeWindow = nullptr;
+    };
+
+    QVector<Registration> Clients;
+    QVector<QWidget*> ScopeWindows;
+    EventTypes RegisteredTypes;
+    bool UnscopedMousePressClients = false;
+    bool FilterInstalled = false;
+
+    void onClientDestroyed(QObject* Client);
+    void updateRegistrations();
+};
+
+}  // namespace ads
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ads::CDockInputDispatcher::EventTypes)
+
+//---------------------------------------------------------------------------
+#endif  // DockInputDispatcherH
@@ -0,0 +1,203 @@
+//============================================================================
+/// \file   DockInstrumentation.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of the internal hot path instrumentation
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockInstrumentation.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+
+#include <algorithm>
+#include <limits>
+
+namespace ads
+{
+namespace internal
+{
+bool InstrumentationEnabled = false;
+}
+
+/**
+ * Maximum number of events that are stored for the Chrome trace export.
+ * The statistics are updated for all events.
+ */
+static const int MaxTraceEvents = 1000000;
+
+namespace
+{
+struct TraceEvent
+{
+    const char* Name;
+    qint64 StartNs;
+    qint64 DurationNs;
+};
+
+struct ScopeStatistics
+{
+    quint64 Count = 0;
+    qint64 TotalNs = 0;
+    qint64 MinNs = std::numeric_limits<qint64>::max();
+    qint64 MaxNs = 0;
+};
+
+/**
+ * Recorded instrumentation data. The docking system is used from the GUI
+ * thread only, so the data is not protected by a mutex.
+ */
+struct InstrumentationData
+{
+    QElapsedTimer Clock;
+    QVector<TraceEvent> Events;
+    QHash<const char*, ScopeStatistics> Scopes;
+    quint64 DroppedEvents = 0;
+};
+
+InstrumentationData& instrumentationData()
+{
+    static InstrumentationData Data;
+    return Data;
+}
+}  // namespace
+
+//============================================================================
+QString DockInstrumentationStatistics::toString() const
+{
+    QString Result;
+    for (const auto& Entry : Entries)
+    {
+        Result += QString("%1: count %2, total %3 ms, avg %4 us, min %5 us, "
+                          "max %6 us\n")
+                      .arg(Entry.Name)
+                      .arg(Entry.Count)
+                      .arg(Entry.TotalNs / 1000000.0, 0, 'f', 3)
+                      .arg(Entry.TotalNs / 1000.0 / qMax<quint64>(1, Entry.Count),
+                           0, 'f', 1)
+                      .arg(Entry.MinNs / 1000.0, 0, 'f', 1)
+                      .arg(Entry.MaxNs / 1000.0, 0, 'f', 1);
+    }
+    if (DroppedTraceEvents)
+    {
+        Result += QString("%1 trace events dropped\n").arg(DroppedTraceEvents);
+    }
+    return Result;
+}
+
+namespace internal
+{
+//============================================================================
+void setInstrumentationEnabled(bool Enabled)
+{
+    if (Enabled && !InstrumentationEnabled)
+    {
+        resetInstrumentation();
+        instrumentationData().Clock.start();
+    }
+    InstrumentationEnabled = Enabled;
+}
+
+//============================================================================
+void resetInstrumentation()
+{
+    auto& Data = instrumentationData();
+    Data.Events.clear();
+    Data.Scopes.clear();
+    Data.DroppedEvents = 0;
+}
+
+//============================================================================
+qint64 instrumentationTime()
+{
+    const auto& Clock = instrumentationData().Clock;
+    return Clock.isValid() ? Clock.nsecsElapsed() : 0;
+}
+
+//============================================================================
+void recordInstrumentationScope(const char* Name, qint64 StartNs, qint64 EndNs)
+{
+    auto& Data = instrumentationData();
+    const qint64 DurationNs = EndNs - StartNs;
+    auto& Scope = Data.Scopes[Name];
+    Scope.Count++;
+    Scope.TotalNs += DurationNs;
+    Scope.MinNs = qMin(Scope.MinNs, DurationNs);
+    Scope.MaxNs = qMax(Scope.MaxNs, DurationNs);
+
+    if (Data.Events.count() < MaxTraceEvents)
+    {
+        Data.Events.append({Name, StartNs, DurationNs});
+    }
+    else
+    {
+        Data.DroppedEvents++;
+    }
+}
+
+//============================================================================
+DockInstrumentationStatistics instrumentationStatistics()
+{
+    const auto& Data = instrumentationData();
+
+    // The same name may be used in different translation units, so we
+    // merge the statistics by name and not by the address of the name
+    QMap<QString, DockInstrumentationEntry> EntriesByName;
+    for (auto it = Data.Scopes.constBegin(); it != Data.Scopes.constEnd(); ++it)
+    {
+        const QString Name = QString::fromLatin1(it.key());
+        auto& Entry = EntriesByName[Name];
+        const auto& Scope = it.value();
+        Entry.MinNs = Entry.Count ? qMin(Entry.MinNs, Scope.MinNs) : Scope.MinNs;
+        Entry.Name = Name;
+        Entry.Count += Scope.Count;
+        Entry.TotalNs += Scope.TotalNs;
+        Entry.MaxNs = qMax(Entry.MaxNs, Scope.MaxNs);
+    }
+
+    DockInstrumentationStatistics Statistics;
+    Statistics.Entries.reserve(EntriesByName.count());
+    for (const auto& Entry : EntriesByName)
+    {
+        Statistics.Entries.append(Entry);
+    }
+    std::sort(Statistics.Entries.begin(), Statistics.Entries.end(),
+              [](const DockInstrumentationEntry& a,
+                 const DockInstrumentationEntry& b)
+              { return a.TotalNs > b.TotalNs; });
+    Statistics.DroppedTraceEvents = Data.DroppedEvents;
+    return Statistics;
+}
+
+//============================================================================
+QByteArray instrumentationChromeTrace()
+{
+    const auto& Data = instrumentationData();
+    QByteArray Trace;
+    Trace.reserve(64 + Data.Events.count() * 96);
+    Trace += "{\"traceEvents\":[";
+    bool First = true;
+    for (const auto& Event : Data.Events)
+    {
+        Trace += First ? "\n" : ",\n";
+        First = false;
+        Trace += "{\"name\":\"";
+        Trace += Event.Name;
+        Trace += "\",\"cat\":\"ads\",\"ph\":\"X\",\"ts\":";
+        Trace += QByteArray::number(Event.StartNs / 1000.0, 'f', 3);
+        Trace += ",\"dur\":";
+        Trace += QByteArray::number(Event.DurationNs / 1000.0, 'f', 3);
+        Trace += ",\"pid\":1,\"tid\":1}";
+    }
+    Trace += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return Trace;
+}
+}  // namespace internal
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockInstrumentation.cpp
@@ -0,0 +1,147 @@
+#ifndef DockInstrumentationH
+#define DockInstrumentationH
+//============================================================================
+/// \file   DockInstrumentation.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of the internal hot path instrumentation
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+/**
+ * Aggregated timings of one instrumented scope
+ */
+struct DockInstrumentationEntry
+{
+    QString Name;
+    quint64 Count = 0;
+    qint64 TotalNs = 0;
+    qint64 MinNs = 0;
+    qint64 MaxNs = 0;
+};
+
+/**
+ * Statistics of all instrumented scopes that have been recorded since the
+ * instrumentation has been enabled or reset.
+ * The entries are sorted by total time, the most expensive scope first.
+ */
+struct DockInstrumentationStatistics
+{
+    QVector<DockInstrumentationEntry> Entries;
+    quint64 DroppedTraceEvents = 0;  ///< events not stored for the trace
+
+    /**
+     * Returns the statistics as human readable multi line text for logging
+     */
+    QString toString() const;
+};
+
+namespace internal
+{
+/**
+ * Global switch of the instrumentation. It is only read via
+ * instrumentationEnabled() to keep the disabled case to a single load.
+ */
+extern ADS_EXPORT bool InstrumentationEnabled;
+
+/**
+ * Returns true, if the instrumentation is enabled
+ */
+inline bool instrumentationEnabled()
+{
+    return InstrumentationEnabled;
+}
+
+/**
+ * Enables or disables the instrumentation. Enabling clears all recorded
+ * data and starts a new time base for the trace events
+ */
+ADS_EXPORT void setInstrumentationEnabled(bool Enabled);
+
+/**
+ * Clears all recorded data
+ */
+ADS_EXPORT void resetInstrumentation();
+
+/**
+ * Returns the current time of the instrumentation clock in nanoseconds
+ */
+ADS_EXPORT qint64 instrumentationTime();
+
+/**
+ * Records a completed scope with the given name. Name needs to be a string
+ * with static storage duration
+ */
+ADS_EXPORT void recordInstrumentationScope(const char* Name, qint64 StartNs,
+                                           qint64 EndNs);
+
+/**
+ * Returns the aggregated statistics of all recorded scopes
+ */
+ADS_EXPORT DockInstrumentationStatistics instrumentationStatistics();
+
+/**
+ * Returns all recorded scopes in the Chrome trace event JSON format that can
+ * be loaded into chrome://tracing or https://ui.perfetto.dev
+ */
+ADS_EXPORT QByteArray instrumentationChromeTrace();
+
+/**
+ * Records the time between construction and destruction as one instrumented
+ * scope, if the instrumentation is enabled at construction time.
+ * Use the ADS_TRACE_SCOPE macro instead of using this class directly.
+ */
+class CInstrumentationScope
+{
+public:
+    explicit CInstrumentationScope(const char* ScopeName)
+        : Name(instrumentationEnabled() ? ScopeName : nullptr)
+    {
+        if (Name)
+        {
+            StartNs = instrumentationTime();
+        }
+    }
+
+    ~CInstrumentationScope()
+    {
+        if (Name)
+        {
+            recordInstrumentationScope(Name, StartNs, instrumentationTime());
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(CInstrumentationScope)
+    const char* Name;
+    qint64 StartNs = 0;
+};
+}  // namespace internal
+}  // namespace ads
+
+/**
+ * Instruments the enclosing scope with the given static name. Define
+ * ADS_NO_INSTRUMENTATION to compile the instrumentation out completely.
+ */
+#ifdef ADS_NO_INSTRUMENTATION
+#    define ADS_TRACE_SCOPE(Name)
+#else
+#    define ADS_TRACE_CONCAT_IMPL(a, b) a##b
+#    define ADS_TRACE_CONCAT(a, b) ADS_TRACE_CONCAT_IMPL(a, b)
+#    define ADS_TRACE_SCOPE(Name)                                             \
+        ads::internal::CInstrumentationScope ADS_TRACE_CONCAT(AdsTraceScope, \
+                                                              __LINE__)(Name)
+#endif
+
+//---------------------------------------------------------------------------
+#endif  // DockInstrumentationH
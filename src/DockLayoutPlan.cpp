@@ -0,0 +1,44 @@
+//============================================================================
+/// \file   DockLayoutPlan.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockLayoutPlan
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockLayoutPlan.h"
+
+#include "DockingStateReader.h"
+
+namespace ads
+{
+
+//============================================================================
+CDockLayoutPlan::CDockLayoutPlan()
+{
+}
+
+//============================================================================
+bool CDockLayoutPlan::isValid() const
+{
+    return State != nullptr;
+}
+
+//============================================================================
+int CDockLayoutPlan::userVersion() const
+{
+    return UserVersion;
+}
+
+//============================================================================
+const DockingState* CDockLayoutPlan::state() const
+{
+    return State.get();
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockLayoutPlan.cpp
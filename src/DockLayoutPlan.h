@@ -0,0 +1,69 @@
+#ifndef DockLayoutPlanH
+#define DockLayoutPlanH
+//============================================================================
+/// \file   DockLayoutPlan.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockLayoutPlan
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <memory>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockingState;
+class CDockManager;
+struct DockManagerPrivate;
+
+/**
+ * A decoded and validated docking state that is ready to be applied via
+ * CDockManager::restoreState(const CDockLayoutPlan&).
+ * A plan is created by CDockManager::prepareRestoreAsync(). All the
+ * expensive work - uncompressing and parsing the saved state and checking
+ * its structure and version - is already done when the plan is handed out,
+ * so applying it on the GUI thread only creates and arranges the widgets.
+ * Plans are immutable and cheap to copy - all copies share the same
+ * parsed state.
+ */
+class ADS_EXPORT CDockLayoutPlan
+{
+private:
+    std::shared_ptr<const DockingState> State;
+    int UserVersion = 0;
+    friend class CDockManager;
+    friend struct DockManagerPrivate;
+
+public:
+    /**
+     * Creates an invalid plan
+     */
+    CDockLayoutPlan();
+
+    /**
+     * Returns true, if the state has been decoded and validated
+     * successfully
+     */
+    bool isValid() const;
+
+    /**
+     * Returns the version number that has been passed to
+     * prepareRestoreAsync(). The plan can only be applied, if the saved
+     * state matches this version.
+     */
+    int userVersion() const;
+
+    /**
+     * Returns the parsed state or nullptr, if the plan is invalid
+     */
+    const DockingState* state() const;
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // DockLayoutPlanH
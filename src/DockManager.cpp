@@ -31,19 +31,27 @@
 #include "DockAreaTitleBar.h"
 #include "DockAreaWidget.h"
 #include "DockFocusController.h"
+#include "DockInputDispatcher.h"
+#include "DockInstrumentation.h"
 #include "DockOverlay.h"
 #include "DockSplitter.h"
 #include "DockWidget.h"
 #include "DockWidgetTab.h"
+#include "DockingStateBinaryFormat.h"
 #include "DockingStateReader.h"
+#include "DockingStateWriter.h"
 #include "FloatingDockContainer.h"
 #include "IconProvider.h"
+#include "LayoutJournal.h"
+#include "PerspectiveStore.h"
 #include "ads_globals.h"
 
 #include <AutoHideDockContainer.h>
 #include <QAction>
 #include <QApplication>
+#include <QAtomicInt>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QGuiApplication>
 #include <QLayout>
@@ -52,14 +60,18 @@
 #include <QMap>
 #include <QMenu>
 #include <QPushButton>
+#include <QRunnable>
+#include <QSet>
 #include <QSettings>
 #include <QStatusBar>
+#include <QThreadPool>
+#include <QTimer>
 #include <QVariant>
 #include <QWindow>
 #include <QWindowStateChangeEvent>
-#include <QXmlStreamWriter>
 #include <algorithm>
 #include <iostream>
+#include <memory>
 
 // #include "FloatingWidgetTitleBar.h"
 
@@ -96,8 +108,62 @@ static CDockManager::AutoHideFlags StaticAutoHideConfigFlags; // auto hide
                                                                // disabled by
                                                                // default
 
+static CDockManager::PerformanceFlags StaticPerformanceConfigFlags =
+    CDockManager::DefaultPerformanceConfig;
+
 static QString FloatingContainersTitle;
 
+/**
+ * Delay in milliseconds of the visibility level update. All changes within
+ * this delay, like the move events of a dragged floating widget, are
+ * coalesced into a single update.
+ */
+static const int VisibilityLevelUpdateDelay = 50;
+
+/**
+ * The layout journal is not compacted before its records exceed this size
+ */
+static const qint64 MinLayoutJournalCompactionSize = 16 * 1024;
+
+/**
+ * An asynchronous save or restore request.
+ * Work is called on the state worker thread and must not touch any widget.
+ * Finished is called afterwards on the GUI thread.
+ */
+struct StateTask
+{
+    std::function<void()> Work;
+    std::function<void()> Finished;
+    QAtomicInt Done;
+};
+
+/**
+ * Runs a state task on the state worker thread and notifies the dock
+ * manager when the work is done
+ */
+class CStateTaskRunnable : public QRunnable
+{
+public:
+    CStateTaskRunnable(std::shared_ptr<StateTask> Task, CDockManager* DockManager)
+        : Task(std::move(Task)), DockManager(DockManager)
+    {
+    }
+
+    virtual void run() override
+    {
+        Task->Work();
+        Task->Done.storeRelease(1);
+        // The dock manager waits for all running tasks in its destructor,
+        // so the dock manager is still alive here
+        QMetaObject::invokeMethod(DockManager, "onStateTaskFinished",
+                                  Qt::QueuedConnection);
+    }
+
+private:
+    std::shared_ptr<StateTask> Task;
+    CDockManager* DockManager;
+};
+
 /**
  * Private data class of CDockManager class (pimpl)
  */
@@ -107,16 +173,30 @@ struct DockManagerPrivate
     QList<CFloatingDockContainer*> FloatingWidgets;
     QList<CFloatingDockContainer*> HiddenFloatingWidgets;
     QList<CDockContainerWidget*> Containers;
+    QList<CDockContainerWidget*> ContainersByZOrder;
+    bool ContainersByZOrderValid = false;
+    QTimer VisibilityLevelTimer;
+    bool VisibilityLevelsDirty = false;
+    quint64 DropOverlayUpdateCount = 0;
+    quint64 SkippedDropOverlayUpdateCount = 0;
+    QList<QPointer<CDockWidget>> HiddenLazyContents;
+    int LazyContentBudget = -1;
+    QTimer LazyContentBudgetTimer;
     CDockOverlay* ContainerOverlay;
     CDockOverlay* DockAreaOverlay;
     QMap<QString, CDockWidget*> DockWidgetsMap;
     QMap<QString, QByteArray> Perspectives;
+    QMap<QString, CDockLayoutPlan> PerspectivePlans;
+    std::unique_ptr<CPerspectiveStore> PerspectiveStore;
+    CDockStatePool PerspectivePool;
     QMap<QString, QMenu*> ViewMenuGroups;
     QMenu* ViewMenu;
 	CDockManager::eViewMenuInsertionOrder MenuInsertionOrder = CDockManager::MenuAlphabeticallySorted;
     bool RestoringState = false;
+    int LayoutUpdateDepth = 0;
     QVector<CFloatingDockContainer*> UninitializedFloatingWidgets;
     CDockFocusController* FocusController = nullptr;
+    CDockInputDispatcher* InputDispatcher = nullptr;
     CDockWidget* CentralWidget = nullptr;
     bool IsLeavingMinimized = false;
     Qt::ToolButtonStyle ToolBarStyleDocked = Qt::ToolButtonIconOnly;
@@ -124,28 +204,275 @@ struct DockManagerPrivate
     QSize ToolBarIconSizeDocked = QSize(16, 16);
     QSize ToolBarIconSizeFloating = QSize(24, 24);
     CDockWidget::DockWidgetFeatures LockedDockWidgetFeatures;
+    QThreadPool StateTaskPool;
+    QList<std::shared_ptr<StateTask>> StateTasks;
+    QTimer RestoreSliceTimer;
+    int RestoreTimeSlice = 10;
+    QList<std::function<bool()>> RestoreSteps;
+    int RestoreStepCount = 0;
+    std::shared_ptr<const DockingState> RestoreState;
+    int RestoreVersion = 0;
+    QList<QPointer<CDockContainerWidget>> RestoredContainers;
+    std::unique_ptr<CLayoutJournal> LayoutJournal;
+    int LayoutJournalVersion = 0;
+    bool LayoutJournalSnapshotRequired = false;
+    QList<QPointer<CDockContainerWidget>> JournalContainers;
+    QList<QPointer<CDockContainerWidget>> JournalDirtyContainers;
+    QList<QPointer<CDockAreaWidget>> JournalDirtyAreas;
+    QList<QPointer<QSplitter>> JournalResizedSplitters;
     /**
      * Private data constructor
      */
     DockManagerPrivate(CDockManager* _public);
 
     /**
-     * Checks if the given data stream is a valid docking system state
-     * file.
+     * Returns the registered dock containers sorted front to back
+     */
+    const QList<CDockContainerWidget*>& containersByZOrder();
+
+    /**
+     * Marks the visibility levels of all dock widgets as outdated. The
+     * levels are only updated by the deferred timer, if a dock widget has a
+     * receiver for its visibilityLevelChanged() signal. Otherwise they are
+     * updated when CDockWidget::visibilityLevel() is called.
+     */
+    void scheduleVisibilityLevelUpdate();
+
+    /**
+     * Returns true, if any dock widget has a receiver for its
+     * visibilityLevelChanged() signal
+     */
+    bool hasVisibilityLevelReceivers() const;
+
+    /**
+     * Updates the visibility levels of all dock widgets
+     */
+    void updateVisibilityLevels();
+
+    /**
+     * Returns true, if the given dock widget is completely covered by a
+     * visible dock container in front of its own dock container
+     */
+    bool isOccluded(CDockWidget* DockWidget);
+
+    /**
+     * Saves the current layout into the given plain State tree
+     */
+    void saveState(DockingState& State, int version);
+
+    /**
+     * Serializes the given State tree into the format selected by the
+     * given config flags. This function does not touch any widget, so it
+     * is safe to call it from a worker thread.
+     */
+    static QByteArray serializeState(const DockingState& State,
+        CDockManager::ConfigFlags Flags);
+
+    /**
+     * Parses the given state data into the given State tree.
+     * Compressed data is uncompressed before parsing. This function does
+     * not touch any widget, so it is safe to call it from a worker thread.
+     */
+    static bool readState(const QByteArray& state, DockingState& State);
+
+    /**
+     * Returns true, if the version numbers of the given parsed state are
+     * supported and if the user version matches the given version
+     */
+    static bool checkVersion(const DockingState& State, int version);
+
+    /**
+     * Parses the given state data into a layout plan for the given version.
+     * Returns an invalid plan, if the data is not a valid docking state.
+     * This function does not touch any widget, so it is safe to call it
+     * from a worker thread.
+     */
+    static CDockLayoutPlan createLayoutPlan(const QByteArray& state, int version);
+
+    /**
+     * Returns true, if perspectives are stored in the deduplicating
+     * PerspectivePool. Perspectives in a perspective store are never
+     * deduplicated.
      */
-    bool checkFormat(const QByteArray& state, int version);
+    bool deduplicatesPerspectives() const;
 
     /**
-     * Restores the state
+     * Stores the data of the perspective with the given name in the
+     * perspective store, in the PerspectivePool or in the Perspectives map
+     * and drops the cached layout plan of the perspective
      */
-	bool restoreStateFromXml(const QByteArray& state, int version, bool Testing = internal::Restore);
+    void storePerspective(const QString& Name, const QByteArray& Data);
+
+    /**
+     * Stores the perspective with the given already parsed State. The State
+     * is added to the PerspectivePool without parsing the given Data again.
+     */
+    void storePerspective(const QString& Name, const QByteArray& Data,
+        const DockingState& State);
+
+    /**
+     * Adds the given State to the PerspectivePool. FullSize is the size of
+     * the serialized state data
+     */
+    void storePooledPerspective(const QString& Name, const DockingState& State,
+        qint64 FullSize);
+
+    /**
+     * Creates the cached layout plan for the given perspective data.
+     * Perspectives in a perspective store are parsed on first use to keep
+     * loading the store cheap, so this function does nothing if a
+     * perspective store is open.
+     */
+    void preparePerspectivePlan(const QString& Name, const QByteArray& Data);
+
+    /**
+     * Returns the cached layout plan of the given perspective. The plan is
+     * created, if it is not cached yet
+     */
+    CDockLayoutPlan perspectivePlan(const QString& Name);
+
+    /**
+     * Returns true, if a perspective with the given name exists
+     */
+    bool hasPerspective(const QString& Name) const;
+
+    /**
+     * Returns the names of all perspectives
+     */
+    QStringList perspectiveNames() const;
+
+    /**
+     * Returns the data of the given perspective. The data of a pooled
+     * perspective is serialized on first use and cached in the pool.
+     */
+    QByteArray perspectiveData(const QString& Name);
+
+    /**
+     * Removes the given perspective. Returns the number of removed
+     * perspectives
+     */
+    int removePerspective(const QString& Name);
+
+    /**
+     * Marks the given container, dock area, splitter or dock widget as
+     * changed. The change is written to the layout journal in the next
+     * flushLayoutJournal() call.
+     */
+    void recordLayoutMutation(QWidget* Widget);
+
+    /**
+     * Computes the child indices from the root splitter of the given
+     * Container to the given Widget. Returns false, if the Widget is not
+     * part of the splitter tree of the container.
+     */
+    static bool journalPath(QWidget* Widget, CDockContainerWidget* Container,
+        QList<int>& Path);
+
+    /**
+     * Appends the complete state of the given container to the layout
+     * journal
+     */
+    void journalContainer(int Index, CDockContainerWidget* Container);
+
+    /**
+     * Treats the current layout as the journaled layout and drops all
+     * recorded changes
+     */
+    void resetJournalTracking();
+
+    /**
+     * Writes the records for all changes since the last flush to the
+     * layout journal
+     */
+    bool flushLayoutJournal();
+
+    /**
+     * Replaces the layout journal with a snapshot of the current layout
+     */
+    bool compactLayoutJournal();
+
+    /**
+     * Checks if the given parsed state is a valid docking system state
+     * for this dock manager.
+     */
+    bool checkFormat(const DockingState& State, int version);
+
+    /**
+     * Emits aboutToRestoreDockWidget() for all dock widgets in the given node
+     */
+    void emitAboutToRestoreDockWidgets(const DockStateNode& Node, bool Testing);
+
+    /**
+     * Restores all containers from the given parsed and checked state
+     */
+    void restoreContainers(const DockingState& State);
+
+    /**
+     * Deletes the floating widgets that are not used by a restored state
+     * with the given number of containers
+     */
+    void deleteUnusedFloatingWidgets(int DockContainerCount);
 
     /**
      * Restore state
      */
     bool restoreState(const QByteArray& state, int version);
 
+    /**
+     * Restores the given parsed state
+     */
+    bool restoreState(const DockingState& State, int version);
+
+    /**
+     * Calls the given Restore function with the dock manager hidden and
+     * emits the restoringState() and stateRestored() signals.
+     * Returns false without calling Restore, if a restore is already
+     * running
+     */
+    bool runRestore(const std::function<bool()>& Restore);
+
+    /**
+     * Starts a time sliced restore of the given state.
+     * Returns false, if the state does not fit to this dock manager or if
+     * a restore is already running
+     */
+    bool startTimeSlicedRestore(const std::shared_ptr<const DockingState>& State,
+        int version);
+
+    /**
+     * Runs the restore steps of a time sliced restore until the time slice
+     * is used up
+     */
+    void restoreNextTimeSlice();
+
+    /**
+     * Starts the running time sliced restore again from the first step.
+     * This is required, if a dock container has been deleted between two
+     * time slices
+     */
+    void restartTimeSlicedRestore();
+
+    /**
+     * Returns true, if a container that has been restored by the running
+     * time sliced restore has been deleted
+     */
+    bool hasDeletedRestoredContainer() const;
+
+    /**
+     * Runs Work on the state worker thread and calls Finished on the GUI
+     * thread when the work is done. Finished is called in the order the
+     * tasks have been started.
+     */
+    void startStateTask(std::function<void()> Work,
+        std::function<void()> Finished);
+
+    /**
+     * Calls the Finished functions of all finished state tasks
+     */
+    void finishStateTasks();
+
     void restoreDockWidgetsOpenState();
+    void restoreDockWidgetOpenState(CDockWidget* DockWidget);
     void restoreDockAreasIndices();
     void emitTopLevelEvents();
 
@@ -170,9 +497,23 @@ struct DockManagerPrivate
     }
 
     /**
-     * Restores the container with the given index
+     * Releases the content of the dock widgets that have been hidden for
+     * the longest time until the lazy content budget is met
+     */
+    void enforceLazyContentBudget();
+
+    /**
+     * Enforces the lazy content budget from the event loop, if a budget
+     * is set
      */
-    bool restoreContainer(int Index, CDockingStateReader& stream, bool Testing);
+    void scheduleLazyContentBudget();
+
+    /**
+     * Restores the container with the given index and returns the restored
+     * container. If the index is not the index of a registered container,
+     * a new floating widget is created
+     */
+    CDockContainerWidget* restoreContainer(int Index, const ContainerState& State);
 
     /**
      * Loads the stylesheet
@@ -191,11 +532,147 @@ struct DockManagerPrivate
 DockManagerPrivate::DockManagerPrivate(CDockManager* _public)
 	: _this(_public)
 {
+    VisibilityLevelTimer.setSingleShot(true);
+    VisibilityLevelTimer.setInterval(VisibilityLevelUpdateDelay);
+    QObject::connect(&VisibilityLevelTimer, &QTimer::timeout,
+                     [this]() { updateVisibilityLevels(); });
+    LazyContentBudgetTimer.setSingleShot(true);
+    LazyContentBudgetTimer.setInterval(0);
+    QObject::connect(&LazyContentBudgetTimer, &QTimer::timeout,
+                     [this]() { enforceLazyContentBudget(); });
+    // A single worker thread keeps the order of save and restore requests
+    StateTaskPool.setMaxThreadCount(1);
+    RestoreSliceTimer.setSingleShot(true);
+    RestoreSliceTimer.setInterval(0);
+    QObject::connect(&RestoreSliceTimer, &QTimer::timeout,
+                     [this]() { restoreNextTimeSlice(); });
+}
+
+//============================================================================
+const QList<CDockContainerWidget*>& DockManagerPrivate::containersByZOrder()
+{
+    // Sort front to back - the stable sort keeps the registration order for
+    // containers with the same z-order, like the previous linear search did
+    if (!ContainersByZOrderValid)
+    {
+        ContainersByZOrder = Containers;
+        std::stable_sort(ContainersByZOrder.begin(), ContainersByZOrder.end(),
+            [](CDockContainerWidget* lhs, CDockContainerWidget* rhs)
+            {
+                return lhs->isInFrontOf(rhs);
+            });
+        ContainersByZOrderValid = true;
+    }
+
+    return ContainersByZOrder;
+}
+
+//============================================================================
+void DockManagerPrivate::scheduleVisibilityLevelUpdate()
+{
+    VisibilityLevelsDirty = true;
+    if (!VisibilityLevelTimer.isActive() && hasVisibilityLevelReceivers())
+    {
+        VisibilityLevelTimer.start();
+    }
+}
+
+//============================================================================
+bool DockManagerPrivate::hasVisibilityLevelReceivers() const
+{
+    for (auto DockWidget : DockWidgetsMap)
+    {
+        if (DockWidget->hasVisibilityLevelReceivers())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//============================================================================
+bool DockManagerPrivate::isOccluded(CDockWidget* DockWidget)
+{
+    auto DockContainer = DockWidget->dockContainer();
+    QRect Rect(DockWidget->mapToGlobal(QPoint(0, 0)), DockWidget->size());
+    for (auto ContainerWidget : containersByZOrder())
+    {
+        // Containers behind the own container cannot cover the dock widget
+        if (ContainerWidget == DockContainer)
+        {
+            return false;
+        }
+
+        if (!ContainerWidget->isVisible()
+            || ContainerWidget->window()->isMinimized())
+        {
+            continue;
+        }
+
+        QRect ContainerRect(ContainerWidget->mapToGlobal(QPoint(0, 0)),
+                            ContainerWidget->size());
+        if (ContainerRect.contains(Rect))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//============================================================================
+void DockManagerPrivate::updateVisibilityLevels()
+{
+    ADS_TRACE_SCOPE("CDockManager::updateVisibilityLevels");
+    VisibilityLevelTimer.stop();
+    VisibilityLevelsDirty = false;
+    CDockWidget* FocusedDockWidget = nullptr;
+    if (FocusController)
+    {
+        FocusedDockWidget = FocusController->focusedDockWidget();
+    }
+    else if (auto FocusWidget = QApplication::focusWidget())
+    {
+        FocusedDockWidget = qobject_cast<CDockWidget*>(FocusWidget);
+        if (!FocusedDockWidget)
+        {
+            FocusedDockWidget = internal::findParent<CDockWidget*>(FocusWidget);
+        }
+    }
+    bool ApplicationActive =
+        QGuiApplication::applicationState() == Qt::ApplicationActive;
+
+    // Iterate over a copy, because slots connected to the
+    // visibilityLevelChanged() signal may remove dock widgets
+    const auto DockWidgets = DockWidgetsMap;
+    for (auto DockWidget : DockWidgets)
+    {
+        auto Level = CDockWidget::VisibilityVisible;
+        if (!DockWidget->isVisible() || DockWidget->window()->isMinimized())
+        {
+            Level = CDockWidget::VisibilityHidden;
+        }
+        else if (isOccluded(DockWidget))
+        {
+            Level = CDockWidget::VisibilityOccluded;
+        }
+        else if (!ApplicationActive)
+        {
+            Level = CDockWidget::VisibilityBackground;
+        }
+        else if (DockWidget == FocusedDockWidget)
+        {
+            Level = CDockWidget::VisibilityFocused;
+        }
+        DockWidget->setVisibilityLevel(Level);
+    }
 }
 
 //============================================================================
 void DockManagerPrivate::loadStyle()
 {
+    ADS_TRACE_SCOPE("CDockManager::loadStyle");
     initResource();
 	if (!ads::CDockManager::testConfigFlag(ads::CDockManager::eConfigFlag::UseProxyStyle))
 	{
@@ -335,112 +812,518 @@ void DockManagerPrivate::loadStyle()
 }
 
 //============================================================================
-bool DockManagerPrivate::restoreContainer(int Index, CDockingStateReader& stream, bool Testing)
+void DockManagerPrivate::enforceLazyContentBudget()
 {
-    if (Testing)
+    // Restoring the state hides and shows dock widgets temporarily, so we
+    // only release content outside of state restoring
+    if (LazyContentBudget < 0 || RestoringState)
     {
-        Index = 0;
+        return;
     }
-    bool Result = false;
+
+    for (int i = HiddenLazyContents.count() - 1; i >= 0; --i)
+    {
+        if (!HiddenLazyContents.at(i))
+        {
+            HiddenLazyContents.removeAt(i);
+        }
+    }
+
+    while (HiddenLazyContents.count() > LazyContentBudget)
+    {
+        auto DockWidget = HiddenLazyContents.takeFirst();
+        DockWidget->releaseFactoryContent();
+    }
+}
+
+//============================================================================
+void DockManagerPrivate::scheduleLazyContentBudget()
+{
+    if (LazyContentBudget >= 0)
+    {
+        LazyContentBudgetTimer.start();
+    }
+}
+
+//============================================================================
+CDockContainerWidget* DockManagerPrivate::restoreContainer(int Index,
+    const ContainerState& State)
+{
     if (Index >= Containers.count())
     {
-        bool IsIndependent = stream.attributes().value("Independent").toInt();
-		CFloatingDockContainer* FloatingWidget = new CFloatingDockContainer(_this, IsIndependent);
-        Result = FloatingWidget->restoreState(stream, Testing);
+		CFloatingDockContainer* FloatingWidget = new CFloatingDockContainer(_this, State.Independent);
+        FloatingWidget->restoreState(State);
         FloatingWidget->dockContainer()->fetchIndependentCount();
+        return FloatingWidget->dockContainer();
     }
-    else if (Index >= 0)
+
+    ADS_PRINT("d->Containers[i]->restoreState "); // setPerspective case
+    auto Container = Containers[Index];
+    if (Container->isFloating())
     {
-		ADS_PRINT("d->Containers[i]->restoreState "); // setPerspective case
-        auto Container = Containers[Index];
-        if (Container->isFloating())
+        CFloatingDockContainer* FloatingWidget = Container->floatingWidget();
+        if (!State.Independent)
         {
-            CFloatingDockContainer* FloatingWidget = Container->floatingWidget();
-            bool IsIndependent = stream.attributes().value("Independent").toInt();
-            if (!IsIndependent)
-            {
-                Result = FloatingWidget->restoreState(stream, Testing);
-            }
-            else
-            {
-                int idx = FloatingWidgets.indexOf(FloatingWidget);
-                FloatingWidget->hideAndDeleteLater();
-                FloatingWidget = new CFloatingDockContainer(_this, IsIndependent);
-                Result = FloatingWidget->restoreState(stream, Testing);
-                FloatingWidget->dockContainer()->fetchIndependentCount();
-                int newIdx = FloatingWidgets.indexOf(FloatingWidget);
-                FloatingWidgets.erase(FloatingWidgets.begin() + newIdx);
-                FloatingWidgets.insert(FloatingWidgets.begin() + idx,
-                                       FloatingWidget);
-            }
+            FloatingWidget->restoreState(State);
         }
         else
         {
-            Result = Container->restoreState(stream, Testing);
-            Container->fetchIndependentCount();
+            int idx = FloatingWidgets.indexOf(FloatingWidget);
+            FloatingWidget->hideAndDeleteLater();
+            FloatingWidget = new CFloatingDockContainer(_this, State.Independent);
+            FloatingWidget->restoreState(State);
+            FloatingWidget->dockContainer()->fetchIndependentCount();
+            int newIdx = FloatingWidgets.indexOf(FloatingWidget);
+            FloatingWidgets.erase(FloatingWidgets.begin() + newIdx);
+            FloatingWidgets.insert(FloatingWidgets.begin() + idx,
+                                   FloatingWidget);
+            return FloatingWidget->dockContainer();
         }
     }
     else
     {
-        Result = false;
+        Container->restoreState(State);
+        Container->fetchIndependentCount();
     }
-    return Result;
+    return Container;
 }
 
 //============================================================================
-bool DockManagerPrivate::checkFormat(const QByteArray& state, int version)
+bool DockManagerPrivate::readState(const QByteArray& state, DockingState& State)
 {
-    return restoreStateFromXml(state, version, internal::RestoreTesting);
+    if (state.isEmpty())
+    {
+        return false;
+    }
+
+    if (CDockingStateBinaryFormat::isBinaryState(state))
+    {
+        return CDockingStateBinaryFormat::read(state, State);
+    }
+
+    CDockingStateReader s(state.startsWith("<?xml") ? state : qUncompress(state));
+    return s.readState(State);
 }
 
 //============================================================================
-bool DockManagerPrivate::restoreStateFromXml(const QByteArray& state, int version, bool Testing)
+bool DockManagerPrivate::checkVersion(const DockingState& State, int version)
 {
-    Q_UNUSED(version);
-
-    if (state.isEmpty())
+    if (State.Version > CurrentVersion)
     {
         return false;
     }
-    CDockingStateReader s(state);
-    s.readNextStartElement();
-    if (s.name() != QLatin1String("QtAdvancedDockingSystem"))
+
+    return !State.HasUserVersion || State.UserVersion == version;
+}
+
+//============================================================================
+CDockLayoutPlan DockManagerPrivate::createLayoutPlan(const QByteArray& state,
+    int version)
+{
+    CDockLayoutPlan Plan;
+    Plan.UserVersion = version;
+    auto State = std::make_shared<DockingState>();
+    if (readState(state, *State) && checkVersion(*State, version))
     {
-        return false;
+        Plan.State = State;
     }
-    ADS_PRINT(s.attributes().value("Version"));
-    bool ok;
-    int v = s.attributes().value("Version").toInt(&ok);
-    if (!ok || v > CurrentVersion)
+    return Plan;
+}
+
+//============================================================================
+bool DockManagerPrivate::deduplicatesPerspectives() const
+{
+    return !PerspectiveStore
+        && CDockManager::testPerformanceConfigFlag(CDockManager::DeduplicatedPerspectives);
+}
+
+//============================================================================
+void DockManagerPrivate::storePerspective(const QString& Name,
+    const QByteArray& Data)
+{
+    // Data that can not be parsed is kept as it is
+    DockingState State;
+    if (deduplicatesPerspectives() && readState(Data, State))
     {
-        return false;
+        storePerspective(Name, Data, State);
+        return;
+    }
+
+    PerspectivePlans.remove(Name);
+    if (PerspectiveStore)
+    {
+        PerspectiveStore->write(Name, Data);
+    }
+    else
+    {
+        PerspectivePool.remove(Name);
+        Perspectives.insert(Name, Data);
+    }
+}
+
+//============================================================================
+void DockManagerPrivate::storePerspective(const QString& Name,
+    const QByteArray& Data, const DockingState& State)
+{
+    if (!deduplicatesPerspectives())
+    {
+        storePerspective(Name, Data);
+        return;
+    }
+
+    storePooledPerspective(Name, State, Data.size());
+}
+
+//============================================================================
+void DockManagerPrivate::storePooledPerspective(const QString& Name,
+    const DockingState& State, qint64 FullSize)
+{
+    PerspectivePlans.remove(Name);
+    Perspectives.remove(Name);
+    PerspectivePool.insert(Name, State, FullSize);
+}
+
+//============================================================================
+void DockManagerPrivate::preparePerspectivePlan(const QString& Name,
+    const QByteArray& Data)
+{
+    // Pooled perspectives are rebuilt from the pool when they are opened -
+    // caching their plans would duplicate the layout trees again
+    if (!PerspectiveStore && !PerspectivePool.contains(Name))
+    {
+        PerspectivePlans.insert(Name, createLayoutPlan(Data, CurrentVersion));
+    }
+}
+
+//============================================================================
+CDockLayoutPlan DockManagerPrivate::perspectivePlan(const QString& Name)
+{
+    auto it = PerspectivePlans.constFind(Name);
+    if (it != PerspectivePlans.constEnd())
+    {
+        return it.value();
+    }
+
+    if (PerspectivePool.contains(Name))
+    {
+        CDockLayoutPlan Plan;
+        Plan.UserVersion = CurrentVersion;
+        auto State = std::make_shared<DockingState>();
+        if (PerspectivePool.state(Name, *State) && checkVersion(*State, CurrentVersion))
+        {
+            Plan.State = State;
+        }
+        return Plan;
+    }
+
+    auto Plan = createLayoutPlan(perspectiveData(Name), CurrentVersion);
+    PerspectivePlans.insert(Name, Plan);
+    return Plan;
+}
+
+//============================================================================
+bool DockManagerPrivate::hasPerspective(const QString& Name) const
+{
+    return PerspectiveStore ? PerspectiveStore->contains(Name)
+        : (Perspectives.contains(Name) || PerspectivePool.contains(Name));
+}
+
+//============================================================================
+QStringList DockManagerPrivate::perspectiveNames() const
+{
+    if (PerspectiveStore)
+    {
+        return PerspectiveStore->names();
+    }
+
+    if (!PerspectivePool.count())
+    {
+        return Perspectives.keys();
+    }
+
+    QStringList Names = Perspectives.keys() + PerspectivePool.names();
+    Names.sort();
+    return Names;
+}
+
+//============================================================================
+QByteArray DockManagerPrivate::perspectiveData(const QString& Name)
+{
+    if (PerspectiveStore)
+    {
+        return PerspectiveStore->read(Name);
+    }
+
+    // Pooled perspectives are serialized again in the current state format.
+    // The data describes the same layout but it is not necessarily byte
+    // identical to the data passed to addPerspective()
+    QByteArray Data = PerspectivePool.cachedData(Name);
+    if (!Data.isEmpty())
+    {
+        return Data;
     }
-    s.setFileVersion(v);
 
-    ADS_PRINT(s.attributes().value("UserVersion"));
-    // Older files do not support UserVersion but we still want to load them so
-    // we first test if the attribute exists
-    if (!s.attributes().value("UserVersion").isEmpty())
+    DockingState State;
+    if (PerspectivePool.state(Name, State))
     {
-        v = s.attributes().value("UserVersion").toInt(&ok);
-        if (!ok || v != version)
+        Data = serializeState(State, CDockManager::configFlags());
+        PerspectivePool.setCachedData(Name, Data);
+        return Data;
+    }
+    return Perspectives.value(Name);
+}
+
+//============================================================================
+int DockManagerPrivate::removePerspective(const QString& Name)
+{
+    PerspectivePlans.remove(Name);
+    if (PerspectiveStore)
+    {
+        return PerspectiveStore->remove(Name) ? 1 : 0;
+    }
+    return Perspectives.remove(Name) + (PerspectivePool.remove(Name) ? 1 : 0);
+}
+
+//============================================================================
+void DockManagerPrivate::recordLayoutMutation(QWidget* Widget)
+{
+    if (!LayoutJournal || !Widget)
+    {
+        return;
+    }
+
+    auto Container = qobject_cast<CDockContainerWidget*>(Widget);
+    if (Container)
+    {
+        if (!JournalDirtyContainers.contains(Container))
+        {
+            JournalDirtyContainers.append(Container);
+        }
+        return;
+    }
+
+    auto DockWidget = qobject_cast<CDockWidget*>(Widget);
+    if (DockWidget)
+    {
+        // Auto hide widgets are stored in the side bars of the container
+        Widget = DockWidget->isAutoHide()
+            ? static_cast<QWidget*>(DockWidget->dockContainer())
+            : static_cast<QWidget*>(DockWidget->dockAreaWidget());
+        recordLayoutMutation(Widget);
+        return;
+    }
+
+    auto DockArea = qobject_cast<CDockAreaWidget*>(Widget);
+    if (DockArea)
+    {
+        if (!JournalDirtyAreas.contains(DockArea))
+        {
+            JournalDirtyAreas.append(DockArea);
+        }
+        return;
+    }
+
+    auto Splitter = qobject_cast<QSplitter*>(Widget);
+    if (Splitter && !JournalResizedSplitters.contains(Splitter))
+    {
+        JournalResizedSplitters.append(Splitter);
+    }
+}
+
+//============================================================================
+bool DockManagerPrivate::journalPath(QWidget* Widget,
+    CDockContainerWidget* Container, QList<int>& Path)
+{
+    QWidget* RootSplitter = Container->rootSplitter();
+    while (Widget != RootSplitter)
+    {
+        auto Splitter = qobject_cast<QSplitter*>(Widget->parentWidget());
+        if (!Splitter)
         {
             return false;
         }
+        Path.prepend(Splitter->indexOf(Widget));
+        Widget = Splitter;
     }
+    return true;
+}
 
-    bool Result = true;
-#ifdef ADS_DEBUG_PRINT
-    int DockContainers = s.attributes().value("Containers").toInt();
-#endif
-    ADS_PRINT(DockContainers);
+//============================================================================
+void DockManagerPrivate::journalContainer(int Index,
+    CDockContainerWidget* Container)
+{
+    Container->fetchIndependentCount();
+    ContainerState State;
+    Container->saveState(State);
+    LayoutJournal->appendContainer(Index, State);
+}
 
+//============================================================================
+void DockManagerPrivate::resetJournalTracking()
+{
+    JournalContainers.clear();
+    for (auto Container : Containers)
+    {
+        JournalContainers.append(Container);
+    }
+    JournalDirtyContainers.clear();
+    JournalDirtyAreas.clear();
+    JournalResizedSplitters.clear();
+    LayoutJournalSnapshotRequired = false;
+}
+
+//============================================================================
+bool DockManagerPrivate::flushLayoutJournal()
+{
+    if (!LayoutJournal)
+    {
+        return false;
+    }
+
+    // A running restore changes the layout completely - the journal gets a
+    // new snapshot after the restore has finished
+    if (RestoringState)
+    {
+        return true;
+    }
+
+    // Containers are registered in creation order, so new containers are
+    // always appended. Removed containers are removed from the back to
+    // keep the indices of the remaining records valid.
+    for (int i = JournalContainers.count() - 1; i >= 0; --i)
+    {
+        if (!JournalContainers[i] || !Containers.contains(JournalContainers[i]))
+        {
+            LayoutJournal->appendRemoveContainer(i);
+            JournalContainers.removeAt(i);
+        }
+    }
+
+    bool SnapshotRequired = LayoutJournalSnapshotRequired;
+    for (int i = 0; i < JournalContainers.count() && !SnapshotRequired; ++i)
+    {
+        SnapshotRequired = (Containers.value(i) != JournalContainers[i]);
+    }
+    if (SnapshotRequired)
+    {
+        return compactLayoutJournal();
+    }
+
+    QSet<CDockContainerWidget*> RecordedContainers;
+    for (int i = 0; i < Containers.count(); ++i)
+    {
+        auto Container = Containers[i];
+        if (i >= JournalContainers.count())
+        {
+            JournalContainers.append(Container);
+        }
+        else if (!JournalDirtyContainers.contains(Container))
+        {
+            continue;
+        }
+        journalContainer(i, Container);
+        RecordedContainers.insert(Container);
+    }
+
+    for (const auto& DockArea : JournalDirtyAreas)
+    {
+        auto Container = DockArea ? DockArea->dockContainer() : nullptr;
+        if (!Container || RecordedContainers.contains(Container))
+        {
+            continue;
+        }
+
+        int Index = JournalContainers.indexOf(Container);
+        if (Index < 0)
+        {
+            continue;
+        }
+
+        QList<int> Path;
+        if (!journalPath(DockArea, Container, Path))
+        {
+            journalContainer(Index, Container);
+            RecordedContainers.insert(Container);
+            continue;
+        }
+
+        DockStateNode Node;
+        DockArea->saveState(Node);
+        LayoutJournal->appendDockArea(Index, Path, Node);
+    }
+
+    for (const auto& Splitter : JournalResizedSplitters)
+    {
+        auto Container = Splitter
+            ? internal::findParent<CDockContainerWidget*>(Splitter.data()) : nullptr;
+        if (!Container || RecordedContainers.contains(Container))
+        {
+            continue;
+        }
+
+        int Index = JournalContainers.indexOf(Container);
+        if (Index < 0)
+        {
+            continue;
+        }
+
+        QList<int> Path;
+        if (!journalPath(Splitter, Container, Path))
+        {
+            journalContainer(Index, Container);
+            RecordedContainers.insert(Container);
+            continue;
+        }
+
+        LayoutJournal->appendSplitterSizes(Index, Path, Splitter->sizes());
+    }
+
+    JournalDirtyContainers.clear();
+    JournalDirtyAreas.clear();
+    JournalResizedSplitters.clear();
+    if (!LayoutJournal->flush())
+    {
+        return false;
+    }
+
+    // The journal is compacted as soon as replaying it would cost more than
+    // reading a new snapshot
+    if (LayoutJournal->journalSize() > qMax(LayoutJournal->snapshotSize(),
+            MinLayoutJournalCompactionSize))
+    {
+        return compactLayoutJournal();
+    }
+    return true;
+}
+
+//============================================================================
+bool DockManagerPrivate::compactLayoutJournal()
+{
+    if (!LayoutJournal)
+    {
+        return false;
+    }
+
+    DockingState State;
+    saveState(State, LayoutJournalVersion);
+    resetJournalTracking();
+    return LayoutJournal->compact(State);
+}
+
+//============================================================================
+bool DockManagerPrivate::checkFormat(const DockingState& State, int version)
+{
+    if (!checkVersion(State, version))
+    {
+        return false;
+    }
+
+    ADS_PRINT(State.Containers.count());
     if (CentralWidget)
     {
-        const auto CentralWidgetAttribute = s.attributes().value("CentralWidget");
         // If we have a central widget but a state without central widget, then
         // something is wrong.
-        if (CentralWidgetAttribute.isEmpty())
+        if (State.CentralWidget.isEmpty())
         {
             qWarning() << "Dock manager has central widget but saved state does "
                           "not have central widget.";
@@ -449,7 +1332,7 @@ bool DockManagerPrivate::restoreStateFromXml(const QByteArray& state, int versio
 
         // If the object name of the central widget does not match the name of the
         // saved central widget, the something is wrong
-        if (CentralWidget->objectName() != CentralWidgetAttribute.toString())
+        if (CentralWidget->objectName() != State.CentralWidget)
         {
             qWarning() << "Object name of central widget does not match name of "
                           "central widget in saved state.";
@@ -457,35 +1340,67 @@ bool DockManagerPrivate::restoreStateFromXml(const QByteArray& state, int versio
         }
     }
 
-    int DockContainerCount = 0;
-    while (s.readNextStartElement())
+    for (const auto& Container : State.Containers)
     {
-        if (s.name() == QLatin1String("Container"))
+        if (Container.HasRootNode)
         {
-            Result = restoreContainer(DockContainerCount, s, Testing);
-            if (!Result)
+            emitAboutToRestoreDockWidgets(Container.RootNode, internal::RestoreTesting);
+        }
+
+        for (const auto& SideBar : Container.SideBars)
+        {
+            for (const auto& WidgetState : SideBar.DockWidgets)
             {
-                break;
+                Q_EMIT _this->aboutToRestoreDockWidget(WidgetState.Name,
+                                                       internal::RestoreTesting);
             }
-            DockContainerCount++;
         }
     }
 
-    if (!Testing)
+    return true;
+}
+
+//============================================================================
+void DockManagerPrivate::emitAboutToRestoreDockWidgets(const DockStateNode& Node,
+                                                       bool Testing)
+{
+    for (const auto& Child : Node.Children)
     {
-        // Delete remaining empty floating widgets
-        int FloatingWidgetIndex = DockContainerCount - 1;
-        for (int i = FloatingWidgetIndex; i < FloatingWidgets.count(); ++i)
-        {
-            CFloatingDockContainer* floatingWidget = FloatingWidgets[i];
-            if (!floatingWidget)
-                continue;
-            _this->removeDockContainer(floatingWidget->dockContainer());
-            floatingWidget->deleteLater();
-        }
+        emitAboutToRestoreDockWidgets(Child, Testing);
     }
 
-    return Result;
+    for (const auto& WidgetState : Node.DockWidgets)
+    {
+        Q_EMIT _this->aboutToRestoreDockWidget(WidgetState.Name, Testing);
+    }
+}
+
+//============================================================================
+void DockManagerPrivate::restoreContainers(const DockingState& State)
+{
+    ADS_TRACE_SCOPE("CDockManager::restoreContainers");
+    int DockContainerCount = 0;
+    for (const auto& Container : State.Containers)
+    {
+        restoreContainer(DockContainerCount, Container);
+        DockContainerCount++;
+    }
+    deleteUnusedFloatingWidgets(DockContainerCount);
+}
+
+//============================================================================
+void DockManagerPrivate::deleteUnusedFloatingWidgets(int DockContainerCount)
+{
+    // Delete remaining empty floating widgets
+    int FloatingWidgetIndex = DockContainerCount - 1;
+    for (int i = FloatingWidgetIndex; i < FloatingWidgets.count(); ++i)
+    {
+        CFloatingDockContainer* floatingWidget = FloatingWidgets[i];
+        if (!floatingWidget)
+            continue;
+        _this->removeDockContainer(floatingWidget->dockContainer());
+        floatingWidget->deleteLater();
+    }
 }
 
 //============================================================================
@@ -497,21 +1412,27 @@ void DockManagerPrivate::restoreDockWidgetsOpenState()
     // toggle view action the next time
     for (auto DockWidget : DockWidgetsMap)
     {
-        if (DockWidget->property(internal::DirtyProperty).toBool())
-        {
-            // If the DockWidget is an auto hide widget that is not assigned yet,
-            // then we need to delete the auto hide container now
-            if (DockWidget->isAutoHide())
-            {
-                DockWidget->autoHideDockContainer()->cleanupAndDelete();
-            }
-            DockWidget->flagAsUnassigned();
-            Q_EMIT DockWidget->viewToggled(false);
-        }
-        else
+        restoreDockWidgetOpenState(DockWidget);
+    }
+}
+
+//============================================================================
+void DockManagerPrivate::restoreDockWidgetOpenState(CDockWidget* DockWidget)
+{
+    if (DockWidget->property(internal::DirtyProperty).toBool())
+    {
+        // If the DockWidget is an auto hide widget that is not assigned yet,
+        // then we need to delete the auto hide container now
+        if (DockWidget->isAutoHide())
         {
-			DockWidget->toggleViewInternal(!DockWidget->property(internal::ClosedProperty).toBool());
+            DockWidget->autoHideDockContainer()->cleanupAndDelete();
         }
+        DockWidget->flagAsUnassigned();
+        Q_EMIT DockWidget->viewToggled(false);
+    }
+    else
+    {
+        DockWidget->toggleViewInternal(!DockWidget->property(internal::ClosedProperty).toBool());
     }
 }
 
@@ -579,25 +1500,33 @@ void DockManagerPrivate::emitTopLevelEvents()
 }
 
 //============================================================================
-bool DockManagerPrivate::restoreState(const QByteArray& State, int version)
+bool DockManagerPrivate::restoreState(const QByteArray& state, int version)
 {
-    QByteArray state = State.startsWith("<?xml") ? State : qUncompress(State);
-    if (!checkFormat(state, version))
+    // The state is parsed only once - the parsed tree is used for checking
+    // the format and for restoring the layout
+    DockingState State;
+    if (!readState(state, State))
     {
-        ADS_PRINT("checkFormat: Error checking format!!!!!!!");
+        ADS_PRINT("readState: Error reading state!!!!!!!");
         return false;
     }
 
-    // Hide updates of floating widgets from use
-    hideFloatingWidgets();
-    markDockWidgetsDirty();
+    return restoreState(State, version);
+}
 
-    if (!restoreStateFromXml(state, version))
+//============================================================================
+bool DockManagerPrivate::restoreState(const DockingState& State, int version)
+{
+    if (!checkFormat(State, version))
     {
-        ADS_PRINT("restoreState: Error restoring state!!!!!!!");
+        ADS_PRINT("checkFormat: Error checking format!!!!!!!");
         return false;
     }
 
+    // Hide updates of floating widgets from use
+    hideFloatingWidgets();
+    markDockWidgetsDirty();
+    restoreContainers(State);
     restoreDockWidgetsOpenState();
     restoreDockAreasIndices();
     emitTopLevelEvents();
@@ -606,6 +1535,283 @@ bool DockManagerPrivate::restoreState(const QByteArray& State, int version)
     return true;
 }
 
+//============================================================================
+void DockManagerPrivate::saveState(DockingState& State, int version)
+{
+    State.Version = CurrentVersion;
+    State.HasUserVersion = true;
+    State.UserVersion = version;
+    if (CentralWidget)
+    {
+        State.CentralWidget = CentralWidget->objectName();
+    }
+    for (auto Container : Containers)
+    {
+        Container->fetchIndependentCount();
+        ContainerState SavedContainer;
+        Container->saveState(SavedContainer);
+        State.Containers.append(std::move(SavedContainer));
+    }
+}
+
+//============================================================================
+QByteArray DockManagerPrivate::serializeState(const DockingState& State,
+    CDockManager::ConfigFlags Flags)
+{
+    if (Flags.testFlag(CDockManager::BinaryStateFormat))
+    {
+        return CDockingStateBinaryFormat::write(State);
+    }
+
+    QByteArray xmldata;
+    CDockingStateWriter s(&xmldata);
+    s.setAutoFormatting(Flags.testFlag(CDockManager::XmlAutoFormattingEnabled));
+    s.writeState(State);
+    return Flags.testFlag(CDockManager::XmlCompressionEnabled) ? qCompress(xmldata, 9) : xmldata;
+}
+
+//============================================================================
+bool DockManagerPrivate::runRestore(const std::function<bool()>& Restore)
+{
+    // Prevent multiple calls as long as state is not restore. This may
+    // happen, if QApplication::processEvents() is called somewhere
+    if (RestoringState)
+    {
+        return false;
+    }
+
+    // We hide the complete dock manager here. Restoring the state means
+    // that DockWidgets are removed from the DockArea internal stack layout
+    // which in turn  means, that each time a widget is removed the stack
+    // will show and raise the next available widget which in turn
+    // triggers show events for the dock widgets. To avoid this we hide the
+    // dock manager. Because there will be no processing of application
+    // events until this function is finished, the user will not see this
+    // hiding
+    bool IsHidden = _this->isHidden();
+    if (!IsHidden)
+    {
+        _this->hide();
+    }
+    RestoringState = true;
+    Q_EMIT _this->restoringState();
+    bool Result;
+    {
+        ADS_TRACE_SCOPE("CDockManager::restoreState");
+        Result = Restore();
+    }
+    RestoringState = false;
+    LayoutJournalSnapshotRequired = true;
+    scheduleLazyContentBudget();
+    if (!IsHidden)
+    {
+        _this->show();
+    }
+    Q_EMIT _this->stateRestored();
+    return Result;
+}
+
+//============================================================================
+bool DockManagerPrivate::startTimeSlicedRestore(
+    const std::shared_ptr<const DockingState>& State, int version)
+{
+    if (RestoringState || !checkFormat(*State, version))
+    {
+        return false;
+    }
+
+    RestoringState = true;
+    Q_EMIT _this->restoringState();
+    hideFloatingWidgets();
+    markDockWidgetsDirty();
+
+    // The restore is split into the same steps like the normal restore.
+    // Each container is restored in one step. Only the dock manager itself
+    // is hidden while its container is restored - floating widgets are
+    // hidden until the end like in the normal restore.
+    // The application keeps running between the time slices, so the steps
+    // must not rely on indices. Each container state is assigned to the
+    // container with the same index when the restore starts. If one of
+    // these containers or a restored container is deleted before the
+    // restore is finished, a step returns false and the restore starts
+    // again with the current containers.
+    RestoreState = State;
+    RestoreVersion = version;
+    RestoredContainers.clear();
+    RestoreSteps.clear();
+    for (int i = 0; i < State->Containers.count(); ++i)
+    {
+        QPointer<CDockContainerWidget> Target = Containers.value(i);
+        const bool HasTarget = !Target.isNull();
+        RestoreSteps.append([this, State, i, Target, HasTarget]()
+        {
+            ADS_TRACE_SCOPE("CDockManager::restoreContainers");
+            int Index = HasTarget ? Containers.indexOf(Target) : Containers.count();
+            if (Index < 0 || hasDeletedRestoredContainer())
+            {
+                return false;
+            }
+
+            bool HideManager = HasTarget && !Target->isFloating()
+                && !_this->isHidden();
+            if (HideManager)
+            {
+                _this->hide();
+            }
+            RestoredContainers.append(restoreContainer(Index, State->Containers[i]));
+            if (HideManager)
+            {
+                _this->show();
+            }
+            return true;
+        });
+    }
+
+    RestoreSteps.append([this]()
+    {
+        if (hasDeletedRestoredContainer())
+        {
+            return false;
+        }
+
+        // Delete all floating widgets that have not been restored
+        const auto Widgets = FloatingWidgets;
+        for (auto FloatingWidget : Widgets)
+        {
+            if (FloatingWidget
+             && !RestoredContainers.contains(FloatingWidget->dockContainer()))
+            {
+                _this->removeDockContainer(FloatingWidget->dockContainer());
+                FloatingWidget->deleteLater();
+            }
+        }
+        return true;
+    });
+
+    // Dock widgets are looked up by name when their step runs, so dock
+    // widgets that are removed in between are skipped
+    for (const auto& Name : DockWidgetsMap.keys())
+    {
+        RestoreSteps.append([this, Name]()
+        {
+            auto DockWidget = DockWidgetsMap.value(Name);
+            if (DockWidget)
+            {
+                restoreDockWidgetOpenState(DockWidget);
+            }
+            return true;
+        });
+    }
+    RestoreSteps.append([this]()
+    {
+        restoreDockAreasIndices();
+        return true;
+    });
+    RestoreSteps.append([this]()
+    {
+        emitTopLevelEvents();
+        _this->dumpLayout();
+        return true;
+    });
+
+    RestoreStepCount = RestoreSteps.count();
+    Q_EMIT _this->stateRestoreProgress(0, RestoreStepCount);
+    RestoreSliceTimer.start();
+    return true;
+}
+
+//============================================================================
+void DockManagerPrivate::restoreNextTimeSlice()
+{
+    QElapsedTimer SliceTimer;
+    SliceTimer.start();
+    while (!RestoreSteps.isEmpty())
+    {
+        auto Step = RestoreSteps.takeFirst();
+        if (!Step())
+        {
+            restartTimeSlicedRestore();
+            return;
+        }
+        if (SliceTimer.elapsed() >= RestoreTimeSlice)
+        {
+            break;
+        }
+    }
+
+    Q_EMIT _this->stateRestoreProgress(RestoreStepCount - RestoreSteps.count(),
+        RestoreStepCount);
+    if (!RestoreSteps.isEmpty())
+    {
+        RestoreSliceTimer.start();
+        return;
+    }
+
+    RestoringState = false;
+    LayoutJournalSnapshotRequired = true;
+    scheduleLazyContentBudget();
+    RestoreState.reset();
+    RestoredContainers.clear();
+    Q_EMIT _this->stateRestored();
+}
+
+//============================================================================
+void DockManagerPrivate::restartTimeSlicedRestore()
+{
+    ADS_PRINT("restartTimeSlicedRestore: dock container has been deleted");
+    RestoreSliceTimer.stop();
+    RestoreSteps.clear();
+    RestoringState = false;
+    auto State = RestoreState;
+    if (startTimeSlicedRestore(State, RestoreVersion))
+    {
+        return;
+    }
+
+    // The state does not fit to the dock manager anymore
+    LayoutJournalSnapshotRequired = true;
+    RestoreState.reset();
+    RestoredContainers.clear();
+    Q_EMIT _this->stateRestored();
+}
+
+//============================================================================
+bool DockManagerPrivate::hasDeletedRestoredContainer() const
+{
+    for (const auto& Container : RestoredContainers)
+    {
+        if (!Container)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//============================================================================
+void DockManagerPrivate::startStateTask(std::function<void()> Work,
+    std::function<void()> Finished)
+{
+    auto Task = std::make_shared<StateTask>();
+    Task->Work = std::move(Work);
+    Task->Finished = std::move(Finished);
+    StateTasks.append(Task);
+    StateTaskPool.start(new CStateTaskRunnable(Task, _this));
+}
+
+//============================================================================
+void DockManagerPrivate::finishStateTasks()
+{
+    // The Finished functions may start new tasks, so we must not keep
+    // iterators into the task list here
+    while (!StateTasks.isEmpty() && StateTasks.first()->Done.loadAcquire())
+    {
+        auto Task = StateTasks.takeFirst();
+        Task->Finished();
+    }
+}
+
 //============================================================================
 void DockManagerPrivate::addActionToMenu(QAction* Action, QMenu* Menu, bool InsertSorted)
 {
@@ -657,6 +1863,7 @@ CDockManager::CDockManager(QWidget* parent)
     {
         d->FocusController = new CDockFocusController(this);
     }
+    d->InputDispatcher = new CDockInputDispatcher(this);
 
     window()->installEventFilter(this);
 	connect(qApp,
@@ -673,6 +1880,8 @@ CDockManager::CDockManager(QWidget* parent)
 	QObject::connect((QGuiApplication*)QGuiApplication::instance(),
 		&QGuiApplication::applicationStateChanged,
 		this, &CDockManager::onApplicationStateChanged);
+    connect(qApp, &QApplication::focusChanged, this,
+            [this]() { d->scheduleVisibilityLevelUpdate(); });
 	class TempEventFilter : public QObject
 	{
 	public:
@@ -698,6 +1907,14 @@ CDockManager::CDockManager(QWidget* parent)
 //============================================================================
 CDockManager::~CDockManager()
 {
+    // The state tasks must not outlive the dock manager. Pending Finished
+    // callbacks are dropped
+    d->StateTaskPool.waitForDone();
+    d->StateTasks.clear();
+    d->RestoreSliceTimer.stop();
+    d->RestoreSteps.clear();
+    // Deleting the layout must not be recorded in the layout journal
+    d->LayoutJournal.reset();
 	delete d->DockAreaOverlay;
 	delete d->ContainerOverlay;
     // fix memory leaks, see
@@ -742,10 +1959,36 @@ CDockManager::~CDockManager()
     delete d;
 }
 
+//============================================================================
+/**
+ * Returns true, if the given event of the main window may change the
+ * visibility level of dock widgets
+ */
+static bool isVisibilityLevelEvent(const QEvent* e)
+{
+    switch (e->type())
+    {
+    case QEvent::Move:
+    case QEvent::Resize:
+    case QEvent::WindowStateChange:
+    case QEvent::WindowActivate:
+    case QEvent::WindowDeactivate:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
 //============================================================================
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
 bool CDockManager::eventFilter(QObject* obj, QEvent* e)
 {
+    if (obj == window() && isVisibilityLevelEvent(e))
+    {
+        d->scheduleVisibilityLevelUpdate();
+    }
+
     // Emulate Qt:Tool behaviour.
     // Required because on some WMs Tool windows can't be maximized.
 
@@ -833,6 +2076,11 @@ bool CDockManager::eventFilter(QObject* obj, QEvent* e)
 //============================================================================
 bool CDockManager::eventFilter(QObject* obj, QEvent* e)
 {
+    if (obj == window() && isVisibilityLevelEvent(e))
+    {
+        d->scheduleVisibilityLevelUpdate();
+    }
+
 	if (obj == window() && e->type() == QEvent::WindowStateChange)
     {
         QWindowStateChangeEvent* ev = static_cast<QWindowStateChangeEvent*>(e);
@@ -905,6 +2153,7 @@ void CDockManager::removeFloatingWidget(CFloatingDockContainer* FloatingWidget)
 void CDockManager::registerDockContainer(CDockContainerWidget* DockContainer)
 {
     d->Containers.append(DockContainer);
+    d->ContainersByZOrderValid = false;
 }
 
 //============================================================================
@@ -913,7 +2162,158 @@ void CDockManager::removeDockContainer(CDockContainerWidget* DockContainer)
     if (this != DockContainer)
     {
         d->Containers.removeAll(DockContainer);
+        d->ContainersByZOrderValid = false;
+        d->JournalDirtyContainers.removeAll(DockContainer);
+    }
+}
+
+//============================================================================
+void CDockManager::countDropOverlayUpdate(bool Skipped)
+{
+    if (Skipped)
+    {
+        d->SkippedDropOverlayUpdateCount++;
+    }
+    else
+    {
+        d->DropOverlayUpdateCount++;
+    }
+}
+
+//============================================================================
+quint64 CDockManager::dropOverlayUpdateCount() const
+{
+    return d->DropOverlayUpdateCount;
+}
+
+//============================================================================
+quint64 CDockManager::skippedDropOverlayUpdateCount() const
+{
+    return d->SkippedDropOverlayUpdateCount;
+}
+
+//============================================================================
+void CDockManager::resetDropOverlayUpdateCounters()
+{
+    d->DropOverlayUpdateCount = 0;
+    d->SkippedDropOverlayUpdateCount = 0;
+}
+
+//============================================================================
+void CDockManager::notifyDockWidgetContentVisible(CDockWidget* DockWidget,
+                                                  bool Visible)
+{
+    d->HiddenLazyContents.removeAll(DockWidget);
+    if (Visible)
+    {
+        return;
+    }
+
+    // The content is released from the event loop and not from the Hide
+    // event handler of the dock widget that reports its hidden content
+    d->HiddenLazyContents.append(DockWidget);
+    d->scheduleLazyContentBudget();
+}
+
+//============================================================================
+void CDockManager::setLazyContentBudget(int MaxHiddenContents)
+{
+    d->LazyContentBudget = MaxHiddenContents;
+    d->enforceLazyContentBudget();
+}
+
+//============================================================================
+int CDockManager::lazyContentBudget() const
+{
+    return d->LazyContentBudget;
+}
+
+//============================================================================
+void CDockManager::setInstrumentationEnabled(bool Enabled)
+{
+    internal::setInstrumentationEnabled(Enabled);
+}
+
+//============================================================================
+bool CDockManager::isInstrumentationEnabled()
+{
+    return internal::instrumentationEnabled();
+}
+
+//============================================================================
+void CDockManager::resetInstrumentation()
+{
+    internal::resetInstrumentation();
+}
+
+//============================================================================
+DockInstrumentationStatistics CDockManager::instrumentationStatistics()
+{
+    return internal::instrumentationStatistics();
+}
+
+//============================================================================
+QByteArray CDockManager::instrumentationChromeTrace()
+{
+    return internal::instrumentationChromeTrace();
+}
+
+//============================================================================
+quint64 CDockManager::focusStylePolishCount() const
+{
+    return d->FocusController ? d->FocusController->focusStylePolishCount() : 0;
+}
+
+//============================================================================
+void CDockManager::resetFocusStylePolishCount()
+{
+    if (d->FocusController)
+    {
+        d->FocusController->resetFocusStylePolishCount();
+    }
+}
+
+//============================================================================
+void CDockManager::invalidateDockContainerOrder()
+{
+    d->ContainersByZOrderValid = false;
+    d->scheduleVisibilityLevelUpdate();
+}
+
+//============================================================================
+void CDockManager::scheduleVisibilityLevelUpdate()
+{
+    d->scheduleVisibilityLevelUpdate();
+}
+
+//============================================================================
+void CDockManager::updatePendingVisibilityLevels()
+{
+    if (d->VisibilityLevelsDirty)
+    {
+        d->updateVisibilityLevels();
+    }
+}
+
+//============================================================================
+CDockContainerWidget* CDockManager::dockContainerAt(const QPoint& GlobalPos,
+    const CDockContainerWidget* Exclude) const
+{
+    for (auto ContainerWidget : d->containersByZOrder())
+    {
+        if (ContainerWidget == Exclude || !ContainerWidget->isVisible())
+        {
+            continue;
+        }
+
+        QPoint MappedPos = ContainerWidget->mapFromGlobal(GlobalPos);
+        if (ContainerWidget->rect().contains(MappedPos))
+        {
+            return ContainerWidget;
+        }
     }
+
+    return nullptr;
 }
 
 //============================================================================
@@ -955,77 +2355,180 @@ unsigned int CDockManager::zOrderWidgetIndex() const
 //============================================================================
 QByteArray CDockManager::saveState(int version) const
 {
-    QByteArray xmldata;
-    QXmlStreamWriter s(&xmldata);
-    auto ConfigFlags = CDockManager::configFlags();
-    s.setAutoFormatting(ConfigFlags.testFlag(XmlAutoFormattingEnabled));
-    s.writeStartDocument();
+    // While a restore is running, the layout is only partially restored
+    if (d->RestoringState)
     {
-        s.writeStartElement("QtAdvancedDockingSystem");
-        s.writeAttribute("Version", QString::number(CurrentVersion));
-        s.writeAttribute("UserVersion", QString::number(version));
-        s.writeAttribute("Containers", QString::number(d->Containers.count()));
-        if (d->CentralWidget)
-        {
-            s.writeAttribute("CentralWidget", d->CentralWidget->objectName());
-        }
-        for (auto Container : d->Containers)
-        {
-            Container->fetchIndependentCount();
-            Container->saveState(s);
-        }
-
-        s.writeEndElement();
+        return QByteArray();
     }
-    s.writeEndDocument();
 
-	return ConfigFlags.testFlag(XmlCompressionEnabled) ? qCompress(xmldata, 9) : xmldata;
+    DockingState State;
+    d->saveState(State, version);
+    return DockManagerPrivate::serializeState(State, CDockManager::configFlags());
 }
 
 //============================================================================
 bool CDockManager::restoreState(const QByteArray& state, int version)
 {
-    // Prevent multiple calls as long as state is not restore. This may
-    // happen, if QApplication::processEvents() is called somewhere
+    return d->runRestore([&]() { return d->restoreState(state, version); });
+}
+
+//============================================================================
+void CDockManager::saveStateAsync(
+    const std::function<void(const QByteArray& State)>& Callback,
+    int version) const
+{
+    // While a time sliced restore is running, the snapshot is taken when
+    // the restore is complete
+    if (d->RestoringState)
+    {
+        auto Connection = std::make_shared<QMetaObject::Connection>();
+        *Connection = connect(this, &CDockManager::stateRestored, this,
+            [this, Callback, version, Connection]()
+            {
+                QObject::disconnect(*Connection);
+                saveStateAsync(Callback, version);
+            });
+        return;
+    }
+
+    // The snapshot is the only part that needs the widgets - serializing
+    // and compressing is done by the worker
+    auto State = std::make_shared<DockingState>();
+    d->saveState(*State, version);
+    auto Flags = CDockManager::configFlags();
+    auto Data = std::make_shared<QByteArray>();
+    d->startStateTask(
+        [State, Flags, Data]()
+        { *Data = DockManagerPrivate::serializeState(*State, Flags); },
+        [Callback, Data]() { Callback(*Data); });
+}
+
+//============================================================================
+void CDockManager::prepareRestoreAsync(const QByteArray& state,
+    const std::function<void(const CDockLayoutPlan& Plan)>& Callback,
+    int version)
+{
+    auto Plan = std::make_shared<CDockLayoutPlan>();
+    d->startStateTask(
+        [state, version, Plan]()
+        { *Plan = DockManagerPrivate::createLayoutPlan(state, version); },
+        [Callback, Plan]() { Callback(*Plan); });
+}
+
+//============================================================================
+bool CDockManager::restoreState(const CDockLayoutPlan& Plan)
+{
+    if (!Plan.isValid())
+    {
+        return false;
+    }
+
+    return d->runRestore(
+        [&]() { return d->restoreState(*Plan.state(), Plan.userVersion()); });
+}
+
+//============================================================================
+bool CDockManager::restoreStateTimeSliced(const QByteArray& state, int version)
+{
     if (d->RestoringState)
     {
         return false;
     }
 
-    // We hide the complete dock manager here. Restoring the state means
-    // that DockWidgets are removed from the DockArea internal stack layout
-    // which in turn  means, that each time a widget is removed the stack
-    // will show and raise the next available widget which in turn
-    // triggers show events for the dock widgets. To avoid this we hide the
-    // dock manager. Because there will be no processing of application
-    // events until this function is finished, the user will not see this
-    // hiding
-    bool IsHidden = this->isHidden();
-    if (!IsHidden)
+    auto State = std::make_shared<DockingState>();
+    if (!d->readState(state, *State))
     {
-        hide();
+        return false;
     }
-    d->RestoringState = true;
-    Q_EMIT restoringState();
-    bool Result = d->restoreState(state, version);
-    d->RestoringState = false;
-    if (!IsHidden)
+
+    return d->startTimeSlicedRestore(State, version);
+}
+
+//============================================================================
+bool CDockManager::restoreStateTimeSliced(const CDockLayoutPlan& Plan)
+{
+    if (!Plan.isValid())
     {
-        show();
+        return false;
     }
-    Q_EMIT stateRestored();
-    return Result;
+
+    return d->startTimeSlicedRestore(Plan.State, Plan.userVersion());
+}
+
+//============================================================================
+void CDockManager::setRestoreTimeSlice(int Msec)
+{
+    d->RestoreTimeSlice = Msec;
+}
+
+//============================================================================
+int CDockManager::restoreTimeSlice() const
+{
+    return d->RestoreTimeSlice;
+}
+
+//============================================================================
+void CDockManager::onStateTaskFinished()
+{
+    d->finishStateTasks();
 }
 
+//============================================================================
 bool CDockManager::checkFormat(const QByteArray& state, int version /*= 0*/)
 {
-	return d->checkFormat(state, version);
+	DockingState State;
+	return d->readState(state, State) && d->checkFormat(State, version);
 }
 
 //============================================================================
 QMap<QString, QByteArray> CDockManager::perspectives() const
 {
-    return d->Perspectives;
+    if (!d->PerspectiveStore && !d->PerspectivePool.count())
+    {
+        return d->Perspectives;
+    }
+
+    QMap<QString, QByteArray> Result;
+    for (const auto& Name : d->perspectiveNames())
+    {
+        Result.insert(Name, d->perspectiveData(Name));
+    }
+    return Result;
+}
+
+//============================================================================
+QByteArray CDockManager::perspectiveData(const QString& Name) const
+{
+    return d->perspectiveData(Name);
+}
+
+//============================================================================
+PerspectiveStorageUsage CDockManager::perspectiveStorageUsage() const
+{
+    PerspectiveStorageUsage Usage;
+    if (d->PerspectiveStore)
+    {
+        // The perspective data stays in the memory mapped store file
+        Usage.PerspectiveCount = d->PerspectiveStore->names().count();
+        Usage.DiskSize = d->PerspectiveStore->fileSize();
+        Usage.FullSize = Usage.DiskSize - d->PerspectiveStore->unusedSize();
+        return Usage;
+    }
+
+    for (const auto& Data : d->Perspectives)
+    {
+        Usage.MemorySize += Data.size();
+    }
+    Usage.PerspectiveCount = d->Perspectives.count() + d->PerspectivePool.count();
+    Usage.DiskSize = Usage.MemorySize;
+    Usage.FullSize = Usage.MemorySize + d->PerspectivePool.fullSize();
+    Usage.MemorySize += d->PerspectivePool.memoryUsage();
+    Usage.UniqueNodeCount = d->PerspectivePool.chunkCount();
+    if (d->PerspectivePool.count())
+    {
+        Usage.DiskSize += d->PerspectivePool.savedSize();
+    }
+    return Usage;
 }
 
 //============================================================================
@@ -1191,6 +2694,7 @@ void CDockManager::removeDockWidget(CDockWidget* Dockwidget)
     d->DockWidgetsMap.remove(Dockwidget->objectName());
     CDockContainerWidget::removeDockWidget(Dockwidget);
     Dockwidget->setDockManager(nullptr);
+    Dockwidget->setVisibilityLevel(CDockWidget::VisibilityHidden);
     Q_EMIT dockWidgetRemoved(Dockwidget);
 }
 
@@ -1203,7 +2707,26 @@ QMap<QString, CDockWidget*> CDockManager::dockWidgetsMap() const
 //============================================================================
 void CDockManager::addPerspective(const QString& UniquePrespectiveName)
 {
-    d->Perspectives.insert(UniquePrespectiveName, saveState(CurrentVersion));
+    // A partially restored layout is not saved as perspective
+    if (d->RestoringState)
+    {
+        return;
+    }
+
+    // The saved snapshot is used as parsed layout plan, so the state data
+    // never needs to be parsed
+    auto State = std::make_shared<DockingState>();
+    d->saveState(*State, CurrentVersion);
+    CDockLayoutPlan Plan;
+    Plan.State = State;
+    Plan.UserVersion = CurrentVersion;
+    d->storePerspective(UniquePrespectiveName,
+        DockManagerPrivate::serializeState(*State, CDockManager::configFlags()),
+        *State);
+    if (!d->PerspectivePool.contains(UniquePrespectiveName))
+    {
+        d->PerspectivePlans.insert(UniquePrespectiveName, Plan);
+    }
     Q_EMIT perspectiveListChanged();
 }
 
@@ -1211,7 +2734,8 @@ void CDockManager::addPerspective(const QString& UniquePrespectiveName)
 void CDockManager::addPerspective(const QString& UniquePrespectiveName,
                                   const QByteArray& PerspectiveData)
 {
-    d->Perspectives.insert(UniquePrespectiveName, PerspectiveData);
+    d->storePerspective(UniquePrespectiveName, PerspectiveData);
+    d->preparePerspectivePlan(UniquePrespectiveName, PerspectiveData);
     Q_EMIT perspectiveListChanged();
 }
 
@@ -1227,7 +2751,7 @@ void CDockManager::removePerspectives(const QStringList& Names)
     int Count = 0;
     for (const auto& Name : Names)
     {
-        Count += d->Perspectives.remove(Name);
+        Count += d->removePerspective(Name);
     }
 
     if (Count)
@@ -1240,44 +2764,76 @@ void CDockManager::removePerspectives(const QStringList& Names)
 //============================================================================
 QStringList CDockManager::perspectiveNames() const
 {
-    return d->Perspectives.keys();
+    return d->perspectiveNames();
 }
 
 //============================================================================
 void CDockManager::openPerspective(const QString& PerspectiveName)
 {
-    const auto Iterator = d->Perspectives.find(PerspectiveName);
-    if (d->Perspectives.end() == Iterator)
+    if (d->RestoringState || !d->hasPerspective(PerspectiveName))
     {
         return;
     }
 
+    // The cached layout plan skips uncompressing and parsing the state.
+    // An invalid plan is restored from the data to get the same signals
+    // like restoreState()
     Q_EMIT openingPerspective(PerspectiveName);
-    restoreState(Iterator.value(), CurrentVersion);
+    const auto Plan = d->perspectivePlan(PerspectiveName);
+    if (Plan.isValid())
+    {
+        restoreState(Plan);
+    }
+    else
+    {
+        restoreState(d->perspectiveData(PerspectiveName), CurrentVersion);
+    }
     Q_EMIT perspectiveOpened(PerspectiveName);
 }
 
 //============================================================================
 void CDockManager::savePerspectives(QSettings& Settings) const
 {
-    Settings.beginWriteArray("Perspectives", d->Perspectives.size());
+    // Deduplicated perspectives are written as one pool value. Only the
+    // perspectives that are not pooled are written as separate entries.
+    // Older versions can not read the pool, so it is only written while the
+    // DeduplicatedPerspectives flag is set
+    const bool Pooled = d->deduplicatesPerspectives()
+        && d->PerspectivePool.count() > 0;
+    const auto Names = Pooled ? d->Perspectives.keys() : d->perspectiveNames();
+    Settings.beginWriteArray("Perspectives", Names.size());
     int i = 0;
-	for (auto it = d->Perspectives.constBegin(); it != d->Perspectives.constEnd(); ++it)
+    for (const auto& Name : Names)
     {
         Settings.setArrayIndex(i);
-        Settings.setValue("Name", it.key());
-        Settings.setValue("State", it.value());
+        Settings.setValue("Name", Name);
+        Settings.setValue("State", d->perspectiveData(Name));
         ++i;
     }
     Settings.endArray();
+
+    if (Pooled)
+    {
+        Settings.setValue("PerspectivePool", d->PerspectivePool.save());
+    }
+    else
+    {
+        Settings.remove("PerspectivePool");
+    }
 }
 
 //============================================================================
 void CDockManager::loadPerspectives(QSettings& Settings)
 {
+    // Only the perspectives held in memory are replaced. The perspectives
+    // of an open perspective store are kept and the loaded perspectives
+    // are merged into the store
     d->Perspectives.clear();
+    d->PerspectivePool.clear();
+    d->PerspectivePlans.clear();
     int Size = Settings.beginReadArray("Perspectives");
-    if (!Size)
+    const bool Pooled = Settings.contains("PerspectivePool");
+    if (!Size && !Pooled)
     {
         Settings.endArray();
         return;
@@ -1293,12 +2849,155 @@ void CDockManager::loadPerspectives(QSettings& Settings)
             continue;
         }
 
-        d->Perspectives.insert(Name, Data);
+        d->storePerspective(Name, Data);
+        d->preparePerspectivePlan(Name, Data);
     }
-
     Settings.endArray();
+
+    CDockStatePool Pool;
+    if (Pooled && Pool.restore(Settings.value("PerspectivePool").toByteArray()))
+    {
+        for (const auto& Name : Pool.names())
+        {
+            DockingState State;
+            if (!Pool.state(Name, State))
+            {
+                continue;
+            }
+
+            // The data of pooled perspectives is only serialized, if it is
+            // requested via perspectives() or if the perspective is saved
+            // without deduplication
+            if (d->deduplicatesPerspectives())
+            {
+                d->storePooledPerspective(Name, State, Pool.fullSize(Name));
+                continue;
+            }
+
+            QByteArray Data = DockManagerPrivate::serializeState(State,
+                CDockManager::configFlags());
+            d->storePerspective(Name, Data);
+            d->preparePerspectivePlan(Name, Data);
+        }
+    }
+
+    Q_EMIT perspectiveListChanged();
+    Q_EMIT perspectiveListLoaded();
+}
+
+//============================================================================
+bool CDockManager::openPerspectiveStore(const QString& FileName)
+{
+    std::unique_ptr<CPerspectiveStore> Store(new CPerspectiveStore());
+    if (!Store->open(FileName))
+    {
+        return false;
+    }
+
+    // Perspectives that are only held in memory are moved into the store.
+    // The perspectives of a previously opened store stay in that store.
+    QMap<QString, CDockLayoutPlan> Plans;
+    const auto Names = d->PerspectiveStore ? QStringList() : d->perspectiveNames();
+    for (const auto& Name : Names)
+    {
+        Store->write(Name, d->perspectiveData(Name));
+        if (d->PerspectivePlans.contains(Name))
+        {
+            Plans.insert(Name, d->PerspectivePlans.value(Name));
+        }
+    }
+    d->Perspectives.clear();
+    d->PerspectivePool.clear();
+    d->PerspectivePlans = Plans;
+    d->PerspectiveStore = std::move(Store);
     Q_EMIT perspectiveListChanged();
     Q_EMIT perspectiveListLoaded();
+    return true;
+}
+
+//============================================================================
+void CDockManager::closePerspectiveStore()
+{
+    if (!d->PerspectiveStore)
+    {
+        return;
+    }
+
+    d->PerspectiveStore.reset();
+    d->PerspectivePlans.clear();
+    Q_EMIT perspectiveListChanged();
+}
+
+//============================================================================
+CPerspectiveStore* CDockManager::perspectiveStore() const
+{
+    return d->PerspectiveStore.get();
+}
+
+//============================================================================
+void CDockManager::notifyLayoutMutation(QWidget* Widget)
+{
+    d->recordLayoutMutation(Widget);
+}
+
+//============================================================================
+bool CDockManager::openLayoutJournal(const QString& FileName, int version)
+{
+    DockingState State;
+    d->saveState(State, version);
+    std::unique_ptr<CLayoutJournal> Journal(new CLayoutJournal());
+    if (!Journal->open(FileName, State))
+    {
+        return false;
+    }
+
+    d->LayoutJournal = std::move(Journal);
+    d->LayoutJournalVersion = version;
+    d->resetJournalTracking();
+    return true;
+}
+
+//============================================================================
+void CDockManager::closeLayoutJournal()
+{
+    if (!d->LayoutJournal)
+    {
+        return;
+    }
+
+    d->flushLayoutJournal();
+    d->LayoutJournal.reset();
+    d->resetJournalTracking();
+}
+
+//============================================================================
+bool CDockManager::flushLayoutJournal()
+{
+    return d->flushLayoutJournal();
+}
+
+//============================================================================
+bool CDockManager::compactLayoutJournal()
+{
+    return d->compactLayoutJournal();
+}
+
+//============================================================================
+CLayoutJournal* CDockManager::layoutJournal() const
+{
+    return d->LayoutJournal.get();
+}
+
+//============================================================================
+bool CDockManager::restoreLayoutJournal(const QString& FileName, int version)
+{
+    DockingState State;
+    if (!CLayoutJournal::replay(FileName, State))
+    {
+        return false;
+    }
+
+    return d->runRestore([&]() { return d->restoreState(State, version); });
 }
 
 //============================================================================
@@ -1450,6 +3149,64 @@ bool CDockManager::isRestoringState() const
     return d->RestoringState;
 }
 
+//===========================================================================
+void CDockManager::beginLayoutUpdate()
+{
+    d->LayoutUpdateDepth++;
+}
+
+//===========================================================================
+void CDockManager::endLayoutUpdate()
+{
+    if (d->LayoutUpdateDepth <= 0)
+    {
+        qWarning() << "CDockManager::endLayoutUpdate() called without "
+                      "beginLayoutUpdate()";
+        return;
+    }
+
+    if (--d->LayoutUpdateDepth > 0)
+    {
+        return;
+    }
+
+    ADS_TRACE_SCOPE("CDockManager::endLayoutUpdate");
+    // Committing may emit signals that change the list of containers
+    const auto Containers = d->Containers;
+    for (auto Container : Containers)
+    {
+        if (d->Containers.contains(Container))
+        {
+            Container->commitLayoutUpdate();
+        }
+    }
+}
+
+//===========================================================================
+bool CDockManager::isLayoutUpdateInProgress() const
+{
+    return d->LayoutUpdateDepth > 0;
+}
+
+//===========================================================================
+CDockLayoutUpdateGuard::CDockLayoutUpdateGuard(CDockManager* DockManager)
+    : DockManager(DockManager)
+{
+    if (DockManager)
+    {
+        DockManager->beginLayoutUpdate();
+    }
+}
+
+//===========================================================================
+CDockLayoutUpdateGuard::~CDockLayoutUpdateGuard()
+{
+    if (DockManager)
+    {
+        DockManager->endLayoutUpdate();
+    }
+}
+
 //===========================================================================
 int CDockManager::startDragDistance()
 {
@@ -1467,6 +3224,12 @@ CDockManager::AutoHideFlags CDockManager::autoHideConfigFlags()
     return StaticAutoHideConfigFlags;
 }
 
+//===========================================================================
+CDockManager::PerformanceFlags CDockManager::performanceConfigFlags()
+{
+    return StaticPerformanceConfigFlags;
+}
+
 //===========================================================================
 void CDockManager::setConfigFlags(const ConfigFlags Flags)
 {
@@ -1479,6 +3242,12 @@ void CDockManager::setAutoHideConfigFlags(const AutoHideFlags Flags)
     StaticAutoHideConfigFlags = Flags;
 }
 
+//===========================================================================
+void CDockManager::setPerformanceConfigFlags(const PerformanceFlags Flags)
+{
+    StaticPerformanceConfigFlags = Flags;
+}
+
 //===========================================================================
 void CDockManager::setConfigFlag(eConfigFlag Flag, bool On)
 {
@@ -1491,6 +3260,12 @@ void CDockManager::setAutoHideConfigFlag(eAutoHideFlag Flag, bool On)
     internal::setFlag(StaticAutoHideConfigFlags, Flag, On);
 }
 
+//===========================================================================
+void CDockManager::setPerformanceConfigFlag(ePerformanceFlag Flag, bool On)
+{
+    internal::setFlag(StaticPerformanceConfigFlags, Flag, On);
+}
+
 //===========================================================================
 bool CDockManager::testConfigFlag(eConfigFlag Flag)
 {
@@ -1503,6 +3278,12 @@ bool CDockManager::testAutoHideConfigFlag(eAutoHideFlag Flag)
     return autoHideConfigFlags().testFlag(Flag);
 }
 
+//===========================================================================
+bool CDockManager::testPerformanceConfigFlag(ePerformanceFlag Flag)
+{
+    return performanceConfigFlags().testFlag(Flag);
+}
+
 //===========================================================================
 CIconProvider& CDockManager::iconProvider()
 {
@@ -1610,6 +3391,7 @@ void CDockManager::setSplitterSizes(CDockAreaWidget* ContainedArea, const QList<
     if (Splitter && Splitter->count() == sizes.count())
     {
         Splitter->setSizes(sizes);
+        notifyLayoutMutation(Splitter);
     }
 }
 
@@ -1619,6 +3401,12 @@ CDockFocusController* CDockManager::dockFocusController() const
     return d->FocusController;
 }
 
+//===========================================================================
+CDockInputDispatcher* CDockManager::dockInputDispatcher() const
+{
+    return d->InputDispatcher;
+}
+
 //===========================================================================
 void CDockManager::setFloatingContainersTitle(const QString& Title)
 {
@@ -28,7 +28,14 @@
 //============================================================================
 //                                   INCLUDES
 //============================================================================
+#include <QPointer>
+
+#include <functional>
+
 #include "DockContainerWidget.h"
+#include "DockInstrumentation.h"
+#include "DockLayoutPlan.h"
+#include "DockStatePool.h"
 #include "DockWidget.h"
 #include "FloatingDockContainer.h"
 #include "ads_globals.h"
@@ -51,9 +58,12 @@ struct DockAreaWidgetPrivate;
 class CIconProvider;
 class CDockComponentsFactory;
 class CDockFocusController;
+class CDockInputDispatcher;
 class CAutoHideSideBar;
 class CAutoHideTab;
 struct AutoHideTabPrivate;
+class CPerspectiveStore;
+class CLayoutJournal;
 
 /**
  * The central dock manager that maintains the complete docking system.
@@ -77,6 +87,8 @@ private:
     friend struct FloatingDockContainerPrivate;
     friend class CDockContainerWidget;
     friend class DockContainerWidgetPrivate;
+    friend class CDockAreaWidget;
+    friend class CDockWidget;
     friend class CDockAreaTabBar;
     friend class CDockWidgetTab;
     friend struct DockAreaWidgetPrivate;
@@ -88,9 +100,12 @@ private:
     friend CAutoHideSideBar;
     friend CAutoHideTab;
     friend AutoHideTabPrivate;
+    friend class CDropOverlayUpdateScheduler;
+    friend struct DockWidgetPrivate;
 private Q_SLOTS:
 	void onApplicationStateChanged(Qt::ApplicationState newState);
 	void onMainWindowActivated();
+	void onStateTaskFinished();
 public Q_SLOTS:
     /**
      * Ends the isRestoringFromMinimizedState
@@ -121,6 +136,28 @@ protected:
      */
     void removeDockContainer(CDockContainerWidget* DockContainer);
 
+    /**
+     * Invalidates the cached z-order of the registered dock containers that
+     * is used by dockContainerAt(). A container calls this function whenever
+     * its z-order index changes
+     */
+    void invalidateDockContainerOrder();
+
+    /**
+     * Requests an update of the visibility levels of all dock widgets.
+     * Multiple requests are coalesced into a single deferred update. If no
+     * dock widget has a receiver for its visibilityLevelChanged() signal,
+     * the levels are only updated on demand.
+     * \see CDockWidget::visibilityLevel()
+     */
+    void scheduleVisibilityLevelUpdate();
+
+    /**
+     * Updates the visibility levels of all dock widgets now, if an update
+     * has been requested
+     */
+    void updatePendingVisibilityLevels();
+
     /**
      * Overlay for containers
      */
@@ -137,6 +174,19 @@ protected:
      */
     void notifyWidgetOrAreaRelocation(QWidget* RelocatedWidget);
 
+    /**
+     * Counts a drop overlay update for the statistics returned by
+     * dropOverlayUpdateCount() and skippedDropOverlayUpdateCount()
+     */
+    void countDropOverlayUpdate(bool Skipped);
+
+    /**
+     * A dock widget calls this function if its factory created content
+     * becomes visible or hidden. Hidden content is released if the number
+     * of hidden factory created contents exceeds the lazy content budget.
+     */
+    void notifyDockWidgetContentVisible(CDockWidget* DockWidget, bool Visible);
+
     /**
      * This function is called, if a floating widget has been dropped into
      * an new position.
@@ -145,6 +195,13 @@ protected:
      */
     void notifyFloatingWidgetDrop(CFloatingDockContainer* FloatingWidget);
 
+    /**
+     * Containers, dock areas, splitters and dock widgets call this function
+     * if their part of the layout changed. The change is written to the
+     * layout journal in the next flushLayoutJournal() call.
+     */
+    void notifyLayoutMutation(QWidget* Widget);
+
     /**
      * Show the floating widgets that has been created floating
      */
@@ -157,6 +214,13 @@ protected:
      */
     CDockFocusController* dockFocusController() const;
 
+    /**
+     * Access for the internal input dispatcher that forwards application
+     * wide input events to auto hide containers, resize handles and drag
+     * previews
+     */
+    CDockInputDispatcher* dockInputDispatcher() const;
+
     /**
      * Restore floating widgets hidden by an earlier call to
      * hideManagerAndFloatingWidgets.
@@ -192,6 +256,8 @@ public:
 		AllTabsHaveCloseButton = 0x0080, //!< if this flag is set, then all tabs that are closable show a close button
 		RetainTabSizeWhenCloseButtonHidden =
 			0x0100, //!< if this flag is set, the space for the close button is reserved even if the close button is not visible
+		BinaryStateFormat = 0x0200, //!< If enabled, saveState() writes a compact binary state instead of XML. restoreState()
+									//!< detects the format automatically and restores both formats
 		DragPreviewIsDynamic = 0x0400,			///< If opaque undocking is disabled, this
 												///< flag defines the behavior of the drag
 												///< preview window, if this flag is
@@ -335,6 +401,72 @@ public:
     };
     Q_DECLARE_FLAGS(AutoHideFlags, eAutoHideFlag)
 
+    /**
+     * These global configuration flags enable or disable performance
+     * optimizations of the docking system.
+     * Set the dock manager flags, before you create the dock manager instance.
+     */
+    enum ePerformanceFlag
+    {
+        CoalesceDropOverlayUpdates = 0x01,  //!< If this flag is set, the drop
+                                            //!< overlays are updated at most
+                                            //!< once per display frame while
+                                            //!< dragging and updates are
+                                            //!< skipped if the hovered drop
+                                            //!< target did not change
+        AsyncDragPreviewSnapshot = 0x02,  //!< If this flag is set, the drag
+                                          //!< preview starts with a placeholder
+                                          //!< or the cached pixmap of the last
+                                          //!< drag and renders a downscaled
+                                          //!< content pixmap after the drag has
+                                          //!< started
+        BatchedFocusStyleUpdates = 0x04,  //!< If this flag is set, the focus
+                                          //!< highlighting updates the focused
+                                          //!< property immediately. In the next
+                                          //!< event loop iteration, the dock
+                                          //!< widget tabs and dock area title
+                                          //!< bars whose focused state changed
+                                          //!< are repolished once and the dock
+                                          //!< widgets and dock areas are only
+                                          //!< repainted
+        LazyDockWidgetContent = 0x08,  //!< If this flag is set, dock widgets
+                                       //!< with a widget factory and without
+                                       //!< content widget create their content
+                                       //!< the first time they are shown. This
+                                       //!< flag is not part of the default
+                                       //!< configuration
+        VirtualizedTabBar = 0x10,  //!< If this flag is set, dock area tab bars
+                                   //!< only position the tabs in the visible
+                                   //!< part of the tab strip and only update
+                                   //!< the previous and the new current tab if
+                                   //!< the current tab changes. Tabs keep their
+                                   //!< preferred width and the tab strip
+                                   //!< scrolls. The flag is read when a tab bar
+                                   //!< is created and is not part of the
+                                   //!< default configuration
+        FrozenLiveResize = 0x20,  //!< If this flag is set, dragging a splitter
+                                  //!< handle or an auto hide resize handle with
+                                  //!< OpaqueSplitterResize and live resizing a
+                                  //!< floating widget only stretch a snapshot
+                                  //!< of the content and relayout the content
+                                  //!< once when the resize ends. This flag is
+                                  //!< not part of the default configuration
+        DeduplicatedPerspectives = 0x40,  //!< If this flag is set, perspectives
+                                          //!< that are held in memory are
+                                          //!< stored as a pool of shared layout
+                                          //!< nodes, so that equal parts of
+                                          //!< different perspectives are stored
+                                          //!< only once. perspectives() returns
+                                          //!< the pooled perspectives in the
+                                          //!< current state format. This flag
+                                          //!< is not part of the default
+                                          //!< configuration
+        DefaultPerformanceConfig = CoalesceDropOverlayUpdates
+                                   | AsyncDragPreviewSnapshot
+                                   | BatchedFocusStyleUpdates  //!< the default performance configuration
+    };
+    Q_DECLARE_FLAGS(PerformanceFlags, ePerformanceFlag)
+
     /**
      * Default Constructor.
      * If the given parent is a QMainWindow, the dock manager sets itself as the
@@ -359,6 +491,11 @@ public:
      */
     static AutoHideFlags autoHideConfigFlags();
 
+    /**
+     * This function returns the performance configuration flags
+     */
+    static PerformanceFlags performanceConfigFlags();
+
     /**
      * Sets the global configuration flags for the whole docking system.
      * Call this function before you create the dock manager and before
@@ -373,6 +510,13 @@ public:
      */
     static void setAutoHideConfigFlags(const AutoHideFlags Flags);
 
+    /**
+     * Sets the performance configuration flags for the whole docking system.
+     * Call this function before you create the dock manager and before
+     * your create the first dock widget.
+     */
+    static void setPerformanceConfigFlags(const PerformanceFlags Flags);
+
     /**
      * Set a certain config flag.
      * \see setConfigFlags()
@@ -385,6 +529,12 @@ public:
      */
     static void setAutoHideConfigFlag(eAutoHideFlag Flag, bool On = true);
 
+    /**
+     * Set a certain performance config flag.
+     * \see setPerformanceConfigFlags()
+     */
+    static void setPerformanceConfigFlag(ePerformanceFlag Flag, bool On = true);
+
     /**
      * Returns true if the given config flag is set
      */
@@ -395,6 +545,44 @@ public:
      */
     static bool testAutoHideConfigFlag(eAutoHideFlag Flag);
 
+    /**
+     * Returns true if the given performance config flag is set
+     */
+    static bool testPerformanceConfigFlag(ePerformanceFlag Flag);
+
+    /**
+     * Enables or disables the recording of timings and counts for the
+     * expensive internals of the docking system, like state restoring, drop
+     * overlay updates, style repolishing and floating widget creation.
+     * The instrumentation is disabled by default and only costs a single
+     * flag test per instrumented scope while it is disabled. Enabling the
+     * instrumentation clears all data recorded before.
+     */
+    static void setInstrumentationEnabled(bool Enabled);
+
+    /**
+     * Returns true, if the instrumentation is enabled
+     */
+    static bool isInstrumentationEnabled();
+
+    /**
+     * Clears all recorded instrumentation data
+     */
+    static void resetInstrumentation();
+
+    /**
+     * Returns the aggregated count and timing statistics of all instrumented
+     * scopes. Use DockInstrumentationStatistics::toString() for logging.
+     */
+    static DockInstrumentationStatistics instrumentationStatistics();
+
+    /**
+     * Returns the recorded instrumented scopes in the Chrome trace event
+     * JSON format. Save the data into a file and load it into
+     * chrome://tracing or https://ui.perfetto.dev
+     */
+    static QByteArray instrumentationChromeTrace();
+
     /**
      * Returns the global icon provider.
      * The icon provider enables the use of custom icons in case using
@@ -485,7 +673,9 @@ public:
 
     /**
      * This function returns a readable reference to the internal dock
-     * widgets map so that it is possible to iterate over all dock widgets
+     * widgets map so that it is possible to iterate over all dock widgets.
+     * The returned map is implicitly shared with the internal map, so this
+     * function does not copy the map as long as the result is not modified.
      */
     QMap<QString, CDockWidget*> dockWidgetsMap() const;
 
@@ -495,6 +685,64 @@ public:
      */
     const QList<CDockContainerWidget*> dockContainers() const;
 
+    /**
+     * Returns the top most visible dock container at the given global
+     * position or nullptr, if there is no container at this position.
+     * The container given in Exclude is ignored. The containers are kept
+     * sorted by z-order, so the search stops at the first hit.
+     */
+    CDockContainerWidget* dockContainerAt(const QPoint& GlobalPos,
+        const CDockContainerWidget* Exclude = nullptr) const;
+
+    /**
+     * Returns the number of drop overlay updates that have been performed
+     * while dragging floating widgets or drag previews
+     */
+    quint64 dropOverlayUpdateCount() const;
+
+    /**
+     * Returns the number of drop overlay updates that have been skipped,
+     * because they have been coalesced into a single update per display
+     * frame or because the hovered drop target did not change.
+     * \see CoalesceDropOverlayUpdates
+     */
+    quint64 skippedDropOverlayUpdateCount() const;
+
+    /**
+     * Resets the counters returned by dropOverlayUpdateCount() and
+     * skippedDropOverlayUpdateCount()
+     */
+    void resetDropOverlayUpdateCounters();
+
+    /**
+     * Returns the number of focus style repolish operations of the focus
+     * highlighting. Returns 0, if the FocusHighlighting flag is not set.
+     * \see BatchedFocusStyleUpdates
+     */
+    quint64 focusStylePolishCount() const;
+
+    /**
+     * Resets the counter returned by focusStylePolishCount()
+     */
+    void resetFocusStylePolishCount();
+
+    /**
+     * Sets the maximum number of hidden dock widgets that keep their factory
+     * created content widget alive. If more dock widget contents are hidden,
+     * the content of the dock widgets that have been hidden for the longest
+     * time is deleted and created again via the widget factory when the
+     * dock widget is shown the next time. A negative value (the default)
+     * disables the budget. The budget only has an effect, if the
+     * LazyDockWidgetContent performance flag is set. Hidden content is
+     * released from the event loop and not while a state is restored.
+     */
+    void setLazyContentBudget(int MaxHiddenContents);
+
+    /**
+     * Returns the budget set via setLazyContentBudget()
+     */
+    int lazyContentBudget() const;
+
     /**
      * Returns the list of all floating widgets
      */
@@ -513,9 +761,12 @@ public:
      * If auto formatting is enabled, the output is intended and line wrapped.
      * The XmlMode XmlAutoFormattingDisabled is better if you would like to have
      * a more compact XML output - i.e. for storage in ini files.
+     * If the BinaryStateFormat config flag is set, the state is saved in
+     * a compact binary format instead of XML.
      * The version number is stored as part of the data.
      * To restore the saved state, pass the return value and version number
      * to restoreState().
+     * Returns an empty byte array while a state is restored.
      * \see restoreState()
      */
     QByteArray saveState(int version = 0) const;
@@ -530,14 +781,113 @@ public:
      */
     bool restoreState(const QByteArray& state, int version = 0);
 
+    /**
+     * Asynchronous version of saveState().
+     * The layout tree is copied into a plain state snapshot on the calling
+     * GUI thread. Serializing and compressing the snapshot is done on a
+     * worker thread. When the data is ready, the given Callback is called on
+     * the GUI thread with the same data that saveState() would have
+     * returned. The callbacks of all asynchronous save and restore requests
+     * are called in the order of the requests. Use this function i.e. for
+     * an autosave that should not block the user interface. If it is called
+     * while a time sliced restore is running, the snapshot is taken when the
+     * restore is complete.
+     * \see saveState()
+     */
+    void saveStateAsync(const std::function<void(const QByteArray& State)>& Callback,
+        int version = 0) const;
+
+    /**
+     * Prepares restoring the given state asynchronously.
+     * Uncompressing, parsing and validating the state is done on a worker
+     * thread. When the state is ready, the given Callback is called on the
+     * GUI thread with a layout plan. If the plan is valid, it can be
+     * applied via restoreState(const CDockLayoutPlan&) - this only creates
+     * and arranges the widgets.
+     */
+    void prepareRestoreAsync(const QByteArray& state,
+        const std::function<void(const CDockLayoutPlan& Plan)>& Callback,
+        int version = 0);
+
+    /**
+     * Restores the state from a layout plan that has been prepared via
+     * prepareRestoreAsync(). Returns false, if the plan is invalid or if it
+     * does not fit to this dock manager. The function emits the same
+     * signals like restoreState(const QByteArray&).
+     */
+    bool restoreState(const CDockLayoutPlan& Plan);
+
+    /**
+     * Restores the state in time slices across several event loop
+     * iterations instead of blocking the event loop until the whole layout
+     * is restored.
+     * Each slice runs restore steps until the time slice set via
+     * setRestoreTimeSlice() is used up. A step restores one dock container
+     * or the open state of one dock widget. The dock manager is only hidden
+     * while its own container is restored. The function returns
+     * immediately - it returns false, if the state is invalid or if a
+     * restore is already running. The restoringState() signal is emitted
+     * before the first step, stateRestoreProgress() is emitted after each
+     * slice and stateRestored() is emitted when the restore is complete.
+     * The final state is the same like the state restored by
+     * restoreState(). The application should not change the layout until
+     * the restore is complete. If a floating widget is deleted before the
+     * restore is complete, the restore starts again with the first step.
+     * While the restore is running, saveState() returns an empty byte
+     * array, saveStateAsync() takes its snapshot when the restore is
+     * complete and restoreState(), restoreStateTimeSliced(),
+     * openPerspective() and addPerspective() without data do nothing.
+     */
+    bool restoreStateTimeSliced(const QByteArray& state, int version = 0);
+
+    /**
+     * Time sliced restore of a layout plan that has been prepared via
+     * prepareRestoreAsync().
+     * \see restoreStateTimeSliced()
+     */
+    bool restoreStateTimeSliced(const CDockLayoutPlan& Plan);
+
+    /**
+     * Sets the time in milliseconds that a time sliced restore may block
+     * the event loop per slice. A single step may take longer than the time
+     * slice. The default value is 10 ms.
+     */
+    void setRestoreTimeSlice(int Msec);
+
+    /**
+     * Returns the time slice set via setRestoreTimeSlice()
+     */
+    int restoreTimeSlice() const;
+
 	bool checkFormat(const QByteArray& state, int version = 0);
 
 	/**
 	 * Returns a copy of the perspectives registered in the dock manager,
-	 * and the corresponding state with them
+	 * and the corresponding state with them. The copy is implicitly shared
+	 * and does not allocate as long as it is not modified.
+	 * If a perspective store is open, the data of all perspectives is read
+	 * from the store. Use perspectiveNames() and perspectiveData() to get
+	 * the names from the store index and to read only the data of the
+	 * perspectives that are really needed.
 	 */
 	QMap<QString, QByteArray> perspectives() const;
 
+	/**
+	 * Returns the state data of the perspective with the given name or an
+	 * empty byte array, if there is no such perspective. If a perspective
+	 * store is open, only the data of this perspective is read from the
+	 * store.
+	 */
+	QByteArray perspectiveData(const QString& Name) const;
+
+    /**
+     * Returns the memory and disk usage of the perspectives.
+     * FullSize is the size of the perspectives as independent state data.
+     * If the DeduplicatedPerspectives flag is set, MemorySize and DiskSize
+     * show how much of it is saved by sharing equal layout nodes.
+     */
+    PerspectiveStorageUsage perspectiveStorageUsage() const;
+
     /**
      * Saves the current perspective to the internal list of perspectives.
      * A perspective is the current state of the dock manager assigned
@@ -545,6 +895,8 @@ public:
      * to switch between different perspectives quickly.
      * If a perspective with the given name already exists, then
      * it will be overwritten with the new state.
+     * The dock manager keeps the parsed layout of each perspective, so
+     * openPerspective() does not need to uncompress and parse the state.
      */
     void addPerspective(const QString& UniquePrespectiveName);
 
@@ -568,14 +920,90 @@ public:
 
     /**
      * Saves the perspectives to the given settings file.
+     * If the DeduplicatedPerspectives flag is set, the pooled perspectives
+     * are written as a single PerspectivePool value that versions without
+     * this flag can not read. If the flag is not set, all perspectives are
+     * written as separate entries.
      */
     void savePerspectives(QSettings& Settings) const;
 
     /**
-     * Loads the perspectives from the given settings file
+     * Loads the perspectives from the given settings file.
+     * The loaded perspectives replace all perspectives held in memory. If a
+     * perspective store is open, the perspectives in the store are kept and
+     * the loaded perspectives are written into the store.
      */
     void loadPerspectives(QSettings& Settings);
 
+    /**
+     * Opens the perspective store file with the given name.
+     * As long as the store is open, all perspectives are kept in the store
+     * file instead of memory. Opening the store only reads the index of the
+     * perspectives - the data of a perspective is read when it is opened.
+     * Adding or removing a perspective writes only the changed perspective
+     * to the file, so savePerspectives() is not required.
+     * Perspectives that have been added before are moved into the store.
+     * Returns false, if the file can not be opened or if it is already open
+     * in another perspective store.
+     * \see CPerspectiveStore
+     */
+    bool openPerspectiveStore(const QString& FileName);
+
+    /**
+     * Closes the perspective store. The perspectives of the store are not
+     * available in the dock manager anymore.
+     */
+    void closePerspectiveStore();
+
+    /**
+     * Returns the open perspective store or nullptr
+     */
+    CPerspectiveStore* perspectiveStore() const;
+
+    /**
+     * Opens the layout journal file with the given name for autosaving.
+     * The file is replaced by a snapshot of the current layout. After that
+     * the dock manager records which parts of the layout change - docking,
+     * undocking, floating, pinning to an auto hide side bar, toggling,
+     * reordering tabs and resizing splitters. Each flushLayoutJournal()
+     * call appends only the changed containers, dock areas and splitter
+     * sizes to the file, so the cost of an autosave depends on the size of
+     * the change and not on the size of the layout.
+     * Returns false, if the file can not be written.
+     * \see CLayoutJournal, restoreLayoutJournal()
+     */
+    bool openLayoutJournal(const QString& FileName, int version = 0);
+
+    /**
+     * Flushes and closes the layout journal
+     */
+    void closeLayoutJournal();
+
+    /**
+     * Appends the layout changes since the last flush to the layout journal.
+     * Call this function from your autosave timer. If nothing changed,
+     * nothing is written. The journal is compacted into a new snapshot
+     * automatically, if its records get larger than the snapshot.
+     */
+    bool flushLayoutJournal();
+
+    /**
+     * Replaces the layout journal with a snapshot of the current layout
+     */
+    bool compactLayoutJournal();
+
+    /**
+     * Returns the open layout journal or nullptr
+     */
+    CLayoutJournal* layoutJournal() const;
+
+    /**
+     * Restores the layout from the snapshot and the records of the given
+     * layout journal file, i.e. after a crash.
+     * Call openLayoutJournal() afterwards to continue journaling.
+     */
+    bool restoreLayoutJournal(const QString& FileName, int version = 0);
+
     /**
      * This function returns managers central widget or nullptr if no central
      * widget is set.
@@ -658,6 +1086,35 @@ public:
      */
     bool isRestoringState() const;
 
+    /**
+     * Starts a layout update transaction.
+     * Use this if you add or remove many dock widgets from code, e.g. to
+     * build a workspace programmatically. Inside the transaction, the
+     * splitter stretch factors, the dock area title bar visibility, the
+     * top level dock widget state and the dockAreasAdded() and
+     * dockAreasRemoved() signals of the dock containers are not updated
+     * for each single change. All this work is done once when the
+     * transaction is committed with endLayoutUpdate().
+     * The dockWidgetAdded() and dockWidgetRemoved() signals are still
+     * emitted for each dock widget. Transactions can be nested - the
+     * layout is updated when the outermost transaction ends.
+     * \see CDockLayoutUpdateGuard
+     */
+    void beginLayoutUpdate();
+
+    /**
+     * Ends a layout update transaction started with beginLayoutUpdate().
+     * If this ends the outermost transaction, all deferred layout updates
+     * are applied and the coalesced signals are emitted.
+     */
+    void endLayoutUpdate();
+
+    /**
+     * Returns true between beginLayoutUpdate() and the matching
+     * endLayoutUpdate() call.
+     */
+    bool isLayoutUpdateInProgress() const;
+
     /**
      * This function returns true, if the DockManager window is restoring from
      * minimized state.
@@ -850,6 +1307,13 @@ Q_SIGNALS:
      */
     void stateRestored();
 
+    /**
+     * This signal is emitted after each time slice of a time sliced restore.
+     * Step is the number of finished restore steps.
+     * \see restoreStateTimeSliced()
+     */
+    void stateRestoreProgress(int Step, int StepCount);
+
     /**
      * This signal is emitted, if the dock manager starts opening a
      * perspective.
@@ -910,8 +1374,35 @@ Q_SIGNALS:
 	void aboutToRestoreDockWidget(const QString& objectName, bool testing);
 
 };  // class DockManager
+
+
+/**
+ * Scoped layout update transaction. The constructor calls
+ * CDockManager::beginLayoutUpdate() and the destructor calls
+ * CDockManager::endLayoutUpdate().
+ * \code
+ * {
+ *     CDockLayoutUpdateGuard LayoutUpdate(DockManager);
+ *     for (auto DockWidget : DockWidgets)
+ *     {
+ *         DockManager->addDockWidgetTab(CenterDockWidgetArea, DockWidget);
+ *     }
+ * }
+ * \endcode
+ */
+class ADS_EXPORT CDockLayoutUpdateGuard
+{
+public:
+    explicit CDockLayoutUpdateGuard(CDockManager* DockManager);
+    ~CDockLayoutUpdateGuard();
+
+private:
+    Q_DISABLE_COPY(CDockLayoutUpdateGuard)
+    QPointer<CDockManager> DockManager;
+};
 }  // namespace ads
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(ads::CDockManager::ConfigFlags)
+Q_DECLARE_OPERATORS_FOR_FLAGS(ads::CDockManager::PerformanceFlags)
 //-----------------------------------------------------------------------------
 #endif  // DockManagerH
@@ -30,6 +30,7 @@
 #include <QMoveEvent>
 #include <QPaintEvent>
 #include <QPainter>
+#include <QPixmapCache>
 #include <QPointer>
 #include <QResizeEvent>
 #include <QWindow>
@@ -62,12 +63,28 @@ struct DockOverlayPrivate
     CDockOverlay::eMode Mode = CDockOverlay::ModeDockAreaOverlay;
     QRect DropAreaRect;
     int TabIndex = InvalidTabIndex;
+    QPen DropPreviewPen;
+    QBrush DropPreviewBrush;
+    bool DropPreviewStyleValid = false;
 
     /**
      * Private data constructor
      */
     DockOverlayPrivate(CDockOverlay* _public) : _this(_public) {}
 
+    /**
+     * Returns the rectangle of the drop preview for the given drop area in
+     * overlay coordinates or an invalid rectangle, if the area has no
+     * drop preview
+     */
+    QRect dropPreviewRect(DockWidgetArea Area);
+
+    /**
+     * Creates the pen and the brush for the drop preview from the current
+     * palette
+     */
+    void updateDropPreviewStyle();
+
     /**
      * Returns the overlay width / height depending on the visibility
      * of the sidebar
@@ -223,8 +240,31 @@ struct DockOverlayCrossPrivate
 #else
         double DevicePixelRatio = _this->window()->devicePixelRatio();
 #endif
+        // The icon only depends on the colors, the device pixel ratio, the
+        // size, the area and the mode. All overlay crosses share the rendered
+        // icons via the global pixmap cache
+        QString CacheKey = QString("ads_drop_indicator_%1_%2_%3x%4_%5")
+                               .arg(int(DockWidgetArea))
+                               .arg(int(Mode))
+                               .arg(size.width())
+                               .arg(size.height())
+                               .arg(DevicePixelRatio);
+        for (int i = CDockOverlayCross::FrameColor;
+             i <= CDockOverlayCross::ShadowColor; ++i)
+        {
+            CacheKey += QString("_%1").arg(
+                iconColor(static_cast<CDockOverlayCross::eIconColor>(i)).rgba(),
+                0, 16);
+        }
+
+        QPixmap pm;
+        if (QPixmapCache::find(CacheKey, &pm))
+        {
+            return pm;
+        }
+
         QSizeF PixmapSize = size * DevicePixelRatio;
-        QPixmap pm(PixmapSize.toSize());
+        pm = QPixmap(PixmapSize.toSize());
         pm.fill(QColor(0, 0, 0, 0));
 
         QPainter p(&pm);
@@ -353,8 +393,10 @@ struct DockOverlayCrossPrivate
 
             p.drawPolygon(Arrow);
         }
+        p.end();
 
         pm.setDevicePixelRatio(DevicePixelRatio);
+        QPixmapCache::insert(CacheKey, pm);
         return pm;
     }
 };
@@ -391,6 +433,47 @@ int DockOverlayPrivate::sideBarMouseZone(SideBarLocation sideBarLocation)
 	}
 }
 
+//============================================================================
+QRect DockOverlayPrivate::dropPreviewRect(DockWidgetArea Area)
+{
+    QRect r = _this->rect();
+    double Factor = (CDockOverlay::ModeContainerOverlay == Mode) ? 4 : 2;
+
+    switch (Area)
+    {
+    case TopDockWidgetArea: r.setHeight(r.height() / Factor); break;
+    case RightDockWidgetArea: r.setX(r.width() * (1 - 1 / Factor)); break;
+    case BottomDockWidgetArea: r.setY(r.height() * (1 - 1 / Factor)); break;
+    case LeftDockWidgetArea: r.setWidth(r.width() / Factor); break;
+    case CenterDockWidgetArea: r = _this->rect(); break;
+    case LeftAutoHideArea: r.setWidth(sideBarOverlaySize(SideBarLeft)); break;
+    case RightAutoHideArea:
+        r.setX(r.width() - sideBarOverlaySize(SideBarRight));
+        break;
+    case TopAutoHideArea: r.setHeight(sideBarOverlaySize(SideBarTop)); break;
+    case BottomAutoHideArea:
+        r.setY(r.height() - sideBarOverlaySize(SideBarBottom));
+        break;
+    default: return QRect();
+    }
+
+    return r;
+}
+
+//============================================================================
+void DockOverlayPrivate::updateDropPreviewStyle()
+{
+    QColor Color = _this->palette().color(QPalette::Active, QPalette::Highlight);
+    DropPreviewPen = QPen(Color.darker(120));
+    DropPreviewPen.setStyle(Qt::SolidLine);
+    DropPreviewPen.setWidth(1);
+    DropPreviewPen.setCosmetic(true);
+    Color = Color.lighter(130);
+    Color.setAlpha(64);
+    DropPreviewBrush = QBrush(Color);
+    DropPreviewStyleValid = true;
+}
+
 //============================================================================
 CDockOverlay::CDockOverlay(QWidget* parent, eMode Mode)
     : QFrame(nullptr), d(new DockOverlayPrivate(this))
@@ -548,14 +631,24 @@ DockWidgetArea CDockOverlay::showOverlay(QWidget* target)
     {
         // Hint: We could update geometry of overlay here.
         DockWidgetArea da = dropAreaUnderCursor();
-        if (da != d->LastLocation)
+        QPoint TopLeft = target->mapToGlobal(target->rect().topLeft());
+        if (da != d->LastLocation && isVisible() && pos() == TopLeft
+            && size() == target->size())
+        {
+            // The overlay is still in place - only the drop preview changed,
+            // so we just repaint the old and the new preview rectangle
+            QRegion DirtyRegion(d->DropAreaRect);
+            DirtyRegion += d->dropPreviewRect(da);
+            update(DirtyRegion);
+            d->LastLocation = da;
+        }
+        else if (da != d->LastLocation)
         {
 			setUpdatesEnabled(false);
 			d->Cross->setUpdatesEnabled(false);
 			hide();
 			d->Cross->updateOverlayIcons();
 			resize(target->size());
-			QPoint TopLeft = target->mapToGlobal(target->rect().topLeft());
 			move(TopLeft);
 			show();
 			d->Cross->setUpdatesEnabled(true);
@@ -594,6 +687,11 @@ void CDockOverlay::hideOverlay()
 //============================================================================
 void CDockOverlay::enableDropPreview(bool Enable)
 {
+    if (d->DropPreviewEnabled == Enable)
+    {
+        return;
+    }
+
     d->DropPreviewEnabled = Enable;
     update();
 }
@@ -616,39 +714,20 @@ void CDockOverlay::paintEvent(QPaintEvent* event)
         return;
     }
 
-    QRect r = rect();
-    const DockWidgetArea da = dropAreaUnderCursor();
-    double Factor = (CDockOverlay::ModeContainerOverlay == d->Mode) ? 4 : 2;
+    const QRect r = d->dropPreviewRect(dropAreaUnderCursor());
+    if (!r.isValid())
+    {
+        return;
+    }
 
-    switch (da)
+    if (!d->DropPreviewStyleValid)
     {
-    case TopDockWidgetArea: r.setHeight(r.height() / Factor); break;
-    case RightDockWidgetArea: r.setX(r.width() * (1 - 1 / Factor)); break;
-    case BottomDockWidgetArea: r.setY(r.height() * (1 - 1 / Factor)); break;
-    case LeftDockWidgetArea: r.setWidth(r.width() / Factor); break;
-    case CenterDockWidgetArea: r = rect(); break;
-    case LeftAutoHideArea: r.setWidth(d->sideBarOverlaySize(SideBarLeft)); break;
-    case RightAutoHideArea:
-        r.setX(r.width() - d->sideBarOverlaySize(SideBarRight));
-        break;
-    case TopAutoHideArea: r.setHeight(d->sideBarOverlaySize(SideBarTop)); break;
-    case BottomAutoHideArea:
-        r.setY(r.height() - d->sideBarOverlaySize(SideBarBottom));
-        break;
-    default: return;
+        d->updateDropPreviewStyle();
     }
 
     QPainter painter(this);
-    QColor Color = palette().color(QPalette::Active, QPalette::Highlight);
-    QPen Pen = painter.pen();
-    Pen.setColor(Color.darker(120));
-    Pen.setStyle(Qt::SolidLine);
-    Pen.setWidth(1);
-    Pen.setCosmetic(true);
-    painter.setPen(Pen);
-    Color = Color.lighter(130);
-    Color.setAlpha(64);
-    painter.setBrush(Color);
+    painter.setPen(d->DropPreviewPen);
+    painter.setBrush(d->DropPreviewBrush);
     painter.drawRect(r.adjusted(0, 0, -1, -1));
     d->DropAreaRect = r;
 }
@@ -677,9 +756,12 @@ void CDockOverlay::hideEvent(QHideEvent* e)
 bool CDockOverlay::event(QEvent* e)
 {
     bool Result = Super::event(e);
-    if (e->type() == QEvent::Polish)
+    switch (e->type())
     {
-        d->Cross->setupOverlayCross(d->Mode);
+    case QEvent::Polish: d->Cross->setupOverlayCross(d->Mode); break;
+    case QEvent::PaletteChange:
+    case QEvent::StyleChange: d->DropPreviewStyleValid = false; break;
+    default: break;
     }
     return Result;
 }
@@ -30,9 +30,12 @@
 
 #include <QChildEvent>
 #include <QDebug>
+#include <QMouseEvent>
 #include <QVariant>
 
 #include "DockAreaWidget.h"
+#include "DockContainerWidget.h"
+#include "LiveResizeFreezer.h"
 
 namespace ads
 {
@@ -43,10 +46,145 @@ struct DockSplitterPrivate
 {
     CDockSplitter* _this;
     int VisibleContentCount = 0;
+    bool FrozenLiveResize = false;
+    CLiveResizeFreezer* Freezer = nullptr;
 
     DockSplitterPrivate(CDockSplitter* _public) : _this(_public) {}
+
+    /**
+     * Returns the position component of the given point
+     */
+    int pick(const QPoint& Pos) const
+    {
+        return _this->orientation() == Qt::Horizontal ? Pos.x() : Pos.y();
+    }
+
+    /**
+     * Returns the rectangle that spans the range From - To in the splitter
+     * orientation and the range of Cross in the other direction
+     */
+    QRect span(const QRect& Cross, int From, int To) const
+    {
+        int Length = qMax(0, To - From);
+        return _this->orientation() == Qt::Horizontal ?
+                   QRect(From, Cross.top(), Length, Cross.height()) :
+                   QRect(Cross.left(), From, Cross.width(), Length);
+    }
+
+    /**
+     * Freezes the splitter and stretches the snapshots of the widgets next
+     * to the given handle as if the handle was moved to Pos.
+     * Returns the legal position of the handle.
+     */
+    int moveFrozenHandle(QSplitterHandle* Handle, int Pos);
+};
+
+/**
+ * Splitter handle that does not move the splitter while it is dragged, if
+ * the splitter uses frozen live resizing. It only updates the stretched
+ * snapshot and moves the splitter once, when the handle is released.
+ */
+class CDockSplitterHandle : public QSplitterHandle
+{
+public:
+    using Super = QSplitterHandle;
+
+    CDockSplitterHandle(Qt::Orientation Orientation, CDockSplitter* Splitter)
+        : Super(Orientation, Splitter), Splitter(Splitter)
+    {}
+
+protected:
+    virtual void mousePressEvent(QMouseEvent* e) override
+    {
+        if (e->button() == Qt::LeftButton)
+        {
+            MouseOffset = Splitter->d->pick(e->pos());
+        }
+        Super::mousePressEvent(e);
+    }
+
+    virtual void mouseMoveEvent(QMouseEvent* e) override
+    {
+        if (!isFrozenDrag(e->buttons()))
+        {
+            Super::mouseMoveEvent(e);
+            return;
+        }
+        Splitter->d->moveFrozenHandle(this, handlePosition(e));
+    }
+
+    virtual void mouseReleaseEvent(QMouseEvent* e) override
+    {
+        auto Freezer = Splitter->d->Freezer;
+        if (e->button() == Qt::LeftButton && Freezer && Freezer->isFrozen())
+        {
+            int Pos = Splitter->d->moveFrozenHandle(this, handlePosition(e));
+            Freezer->unfreeze();
+            moveSplitter(Pos);
+        }
+        Super::mouseReleaseEvent(e);
+    }
+
+private:
+    CDockSplitter* Splitter;
+    int MouseOffset = 0;
+
+    bool isFrozenDrag(Qt::MouseButtons Buttons) const
+    {
+        return (Buttons & Qt::LeftButton) && Splitter->frozenLiveResize()
+               && Splitter->opaqueResize()
+               && !(orientation() == Qt::Horizontal
+                    && Splitter->isRightToLeft());
+    }
+
+    int handlePosition(QMouseEvent* e) const
+    {
+        return Splitter->d->pick(
+                   Splitter->mapFromGlobal(internal::globalPositionOf(e)))
+               - MouseOffset;
+    }
 };
 
+//============================================================================
+int DockSplitterPrivate::moveFrozenHandle(QSplitterHandle* Handle, int Pos)
+{
+    int Index = _this->indexOf(Handle);
+    int PrevIndex = Index - 1;
+    while (PrevIndex >= 0 && _this->widget(PrevIndex)->isHidden())
+    {
+        --PrevIndex;
+    }
+    if (PrevIndex < 0 || Index >= _this->count())
+    {
+        return Pos;
+    }
+
+    Pos = _this->closestLegalPosition(Pos, Index);
+    if (!Freezer)
+    {
+        Freezer = new CLiveResizeFreezer(_this);
+    }
+    Freezer->freeze(_this, false);
+
+    // The snapshot is painted unchanged, only the widget before the handle,
+    // the handle itself and the widget after the handle are stretched to
+    // their new positions
+    auto PrevGeometry = _this->widget(PrevIndex)->geometry();
+    auto NextGeometry = _this->widget(Index)->geometry();
+    auto HandleGeometry = Handle->geometry();
+    int Start = pick(PrevGeometry.topLeft());
+    int End = pick(NextGeometry.bottomRight()) + 1;
+    int HandleEnd = Pos + pick(QPoint(HandleGeometry.width(),
+                                      HandleGeometry.height()));
+    Freezer->setPieces({
+        {_this->rect(), _this->rect()},
+        {PrevGeometry, span(PrevGeometry, Start, Pos)},
+        {HandleGeometry, span(HandleGeometry, Pos, HandleEnd)},
+        {NextGeometry, span(NextGeometry, HandleEnd, End)},
+    });
+    return Pos;
+}
+
 //============================================================================
 CDockSplitter::CDockSplitter(QWidget* parent)
     : QSplitter(parent), d(new DockSplitterPrivate(this))
@@ -67,6 +205,28 @@ CDockSplitter::~CDockSplitter()
     delete d;
 }
 
+//============================================================================
+QSplitterHandle* CDockSplitter::createHandle()
+{
+    return new CDockSplitterHandle(orientation(), this);
+}
+
+//============================================================================
+void CDockSplitter::setFrozenLiveResize(bool Enabled)
+{
+    d->FrozenLiveResize = Enabled;
+    if (!Enabled && d->Freezer)
+    {
+        d->Freezer->unfreeze();
+    }
+}
+
+//============================================================================
+bool CDockSplitter::frozenLiveResize() const
+{
+    return d->FrozenLiveResize;
+}
+
 //============================================================================
 bool CDockSplitter::hasVisibleContent() const
 {
@@ -108,6 +268,25 @@ bool CDockSplitter::isResizingWithContainer() const
     return false;
 }
 
+//============================================================================
+bool CDockSplitter::event(QEvent* e)
+{
+    switch (e->type())
+    {
+    case QEvent::Move:
+    case QEvent::Resize:
+        if (auto DockContainer = internal::findParent<CDockContainerWidget*>(this))
+        {
+            DockContainer->invalidateDockAreaIndex();
+        }
+        break;
+
+    default: break;
+    }
+
+    return QSplitter::event(e);
+}
+
 }  // namespace ads
 
 //---------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 namespace ads
 {
 struct DockSplitterPrivate;
+class CDockSplitterHandle;
 
 /**
  * Splitter used internally instead of QSplitter with some additional
@@ -46,6 +47,7 @@ class ADS_EXPORT CDockSplitter : public QSplitter
 private:
     DockSplitterPrivate* d;
     friend struct DockSplitterPrivate;
+    friend class CDockSplitterHandle;
 
 public:
     CDockSplitter(QWidget* parent = Q_NULLPTR);
@@ -75,6 +77,28 @@ public:
      * Returns true if the splitter contains central widget of dock manager.
      */
     bool isResizingWithContainer() const;
+
+    /**
+     * Enables or disables frozen live resizing. If it is enabled and the
+     * splitter resizes opaquely, dragging a handle only stretches a snapshot
+     * of the widgets next to the handle. The widgets are resized once, when
+     * the handle is released.
+     * \see CDockManager::FrozenLiveResize
+     */
+    void setFrozenLiveResize(bool Enabled);
+
+    /**
+     * Returns true, if frozen live resizing is enabled
+     */
+    bool frozenLiveResize() const;
+
+protected:
+    /**
+     * Invalidates the hit test index of the dock container if the
+     * splitter is moved or resized, because this moves all dock areas
+     * in the splitter relative to the container
+     */
+    virtual bool event(QEvent* e) override;
 };  // class CDockSplitter
 
 }  // namespace ads
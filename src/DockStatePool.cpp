@@ -0,0 +1,574 @@
+//============================================================================
+/// \file   DockStatePool.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockStatePool
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockStatePool.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+
+#include "DockingStateReader.h"
+
+namespace ads
+{
+static const quint32 StatePoolMagic = 0x41445344; // "ADSD"
+static const quint32 StatePoolVersion = 1;
+static const QDataStream::Version StatePoolStreamVersion = QDataStream::Qt_5_0;
+static const int MaxNodeDepth = 256;
+
+
+/**
+ * Writes the list of dock widget states to the given stream
+ */
+static void writeDockWidgets(QDataStream& Stream,
+    const QList<DockWidgetState>& DockWidgets)
+{
+    Stream << quint32(DockWidgets.count());
+    for (const auto& WidgetState : DockWidgets)
+    {
+        Stream << WidgetState.Name << WidgetState.Closed << qint32(WidgetState.Size);
+    }
+}
+
+
+/**
+ * Reads the list of dock widget states written by writeDockWidgets()
+ */
+static bool readDockWidgets(QDataStream& Stream, QList<DockWidgetState>& DockWidgets)
+{
+    quint32 Count = 0;
+    Stream >> Count;
+    for (quint32 i = 0; i < Count && Stream.status() == QDataStream::Ok; ++i)
+    {
+        DockWidgetState WidgetState;
+        qint32 Size;
+        Stream >> WidgetState.Name >> WidgetState.Closed >> Size;
+        WidgetState.Size = Size;
+        DockWidgets.append(WidgetState);
+    }
+    return Stream.status() == QDataStream::Ok;
+}
+
+
+//============================================================================
+QByteArray CDockStatePool::addChunk(ChunkHash& NewChunks, const QByteArray& Data,
+    const QList<QByteArray>& Children)
+{
+    QCryptographicHash Hash(QCryptographicHash::Sha1);
+    Hash.addData(Data);
+    for (const auto& Child : Children)
+    {
+        Hash.addData(Child);
+    }
+
+    QByteArray Result = Hash.result();
+    if (!NewChunks.contains(Result))
+    {
+        DockStatePoolChunk Chunk;
+        Chunk.Data = Data;
+        Chunk.Children = Children;
+        NewChunks.insert(Result, Chunk);
+    }
+    return Result;
+}
+
+
+//============================================================================
+QByteArray CDockStatePool::encodeNode(const DockStateNode& Node, ChunkHash& NewChunks)
+{
+    QByteArray Data;
+    QList<QByteArray> Children;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setVersion(StatePoolStreamVersion);
+    Stream << quint8(Node.Type);
+    if (Node.Type == DockStateNode::SplitterNode)
+    {
+        Stream << quint8(Node.Orientation) << Node.Sizes;
+        for (const auto& Child : Node.Children)
+        {
+            Children.append(encodeNode(Child, NewChunks));
+        }
+    }
+    else
+    {
+        Stream << Node.CurrentDockWidget << qint32(Node.AllowedAreas)
+            << qint32(Node.Flags);
+        writeDockWidgets(Stream, Node.DockWidgets);
+    }
+
+    return addChunk(NewChunks, Data, Children);
+}
+
+
+//============================================================================
+QByteArray CDockStatePool::encodeContainer(const ContainerState& Container,
+    ChunkHash& NewChunks)
+{
+    QByteArray Data;
+    QList<QByteArray> Children;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setVersion(StatePoolStreamVersion);
+    Stream << Container.Independent << Container.Floating << Container.Geometry
+        << Container.HasRootNode << quint32(Container.SideBars.count());
+    for (const auto& SideBar : Container.SideBars)
+    {
+        Stream << qint32(SideBar.Area);
+        writeDockWidgets(Stream, SideBar.DockWidgets);
+    }
+
+    if (Container.HasRootNode)
+    {
+        Children.append(encodeNode(Container.RootNode, NewChunks));
+    }
+
+    return addChunk(NewChunks, Data, Children);
+}
+
+
+//============================================================================
+QByteArray CDockStatePool::encodeState(const DockingState& State, ChunkHash& NewChunks)
+{
+    QByteArray Data;
+    QList<QByteArray> Children;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setVersion(StatePoolStreamVersion);
+    Stream << qint32(State.Version) << State.HasUserVersion
+        << qint32(State.UserVersion) << State.CentralWidget;
+    for (const auto& Container : State.Containers)
+    {
+        Children.append(encodeContainer(Container, NewChunks));
+    }
+
+    return addChunk(NewChunks, Data, Children);
+}
+
+
+//============================================================================
+bool CDockStatePool::decodeNode(const QByteArray& Hash, DockStateNode& Node,
+    int Depth) const
+{
+    auto it = Chunks.constFind(Hash);
+    if (it == Chunks.constEnd() || Depth > MaxNodeDepth)
+    {
+        return false;
+    }
+
+    QDataStream Stream(it->Data);
+    Stream.setVersion(StatePoolStreamVersion);
+    quint8 Type;
+    Stream >> Type;
+    if (Type == DockStateNode::SplitterNode)
+    {
+        quint8 Orientation;
+        Stream >> Orientation >> Node.Sizes;
+        Node.Type = DockStateNode::SplitterNode;
+        Node.Orientation = Qt::Orientation(Orientation);
+        Node.Children.resize(it->Children.count());
+        for (int i = 0; i < it->Children.count(); ++i)
+        {
+            if (!decodeNode(it->Children[i], Node.Children[i], Depth + 1))
+            {
+                return false;
+            }
+        }
+        return Stream.status() == QDataStream::Ok;
+    }
+
+    qint32 AllowedAreas;
+    qint32 Flags;
+    Stream >> Node.CurrentDockWidget >> AllowedAreas >> Flags;
+    Node.Type = DockStateNode::AreaNode;
+    Node.AllowedAreas = AllowedAreas;
+    Node.Flags = Flags;
+    return readDockWidgets(Stream, Node.DockWidgets);
+}
+
+
+//============================================================================
+bool CDockStatePool::decodeContainer(const QByteArray& Hash,
+    ContainerState& Container) const
+{
+    auto it = Chunks.constFind(Hash);
+    if (it == Chunks.constEnd())
+    {
+        return false;
+    }
+
+    QDataStream Stream(it->Data);
+    Stream.setVersion(StatePoolStreamVersion);
+    quint32 SideBarCount = 0;
+    Stream >> Container.Independent >> Container.Floating >> Container.Geometry
+        >> Container.HasRootNode >> SideBarCount;
+    for (quint32 i = 0; i < SideBarCount && Stream.status() == QDataStream::Ok; ++i)
+    {
+        SideBarState SideBar;
+        qint32 Area;
+        Stream >> Area;
+        SideBar.Area = SideBarLocation(Area);
+        if (!readDockWidgets(Stream, SideBar.DockWidgets))
+        {
+            return false;
+        }
+        Container.SideBars.append(SideBar);
+    }
+
+    if (Stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    if (Container.HasRootNode)
+    {
+        return !it->Children.isEmpty()
+            && decodeNode(it->Children.first(), Container.RootNode, 0);
+    }
+    return true;
+}
+
+
+//============================================================================
+void CDockStatePool::addRef(const QByteArray& Hash, const ChunkHash& NewChunks)
+{
+    auto it = Chunks.find(Hash);
+    if (it != Chunks.end())
+    {
+        // An existing chunk already references its children
+        it->RefCount++;
+        return;
+    }
+
+    DockStatePoolChunk Chunk = NewChunks.value(Hash);
+    Chunk.RefCount = 1;
+    Chunks.insert(Hash, Chunk);
+    for (const auto& Child : Chunk.Children)
+    {
+        addRef(Child, NewChunks);
+    }
+}
+
+
+//============================================================================
+void CDockStatePool::release(const QByteArray& Hash)
+{
+    auto it = Chunks.find(Hash);
+    if (it == Chunks.end() || --it->RefCount > 0)
+    {
+        return;
+    }
+
+    const QList<QByteArray> Children = it->Children;
+    Chunks.erase(it);
+    for (const auto& Child : Children)
+    {
+        release(Child);
+    }
+}
+
+
+//============================================================================
+void CDockStatePool::insert(const QString& Name, const DockingState& State,
+    qint64 FullSize)
+{
+    ChunkHash NewChunks;
+    const QByteArray Root = encodeState(State, NewChunks);
+    // Reference the new state before the old state is released, so that the
+    // chunks shared by both states are not deleted and recreated
+    addRef(Root, NewChunks);
+    auto it = Roots.find(Name);
+    if (it != Roots.end())
+    {
+        release(*it);
+    }
+    Roots.insert(Name, Root);
+    FullSizes.insert(Name, FullSize);
+    CachedData.remove(Name);
+}
+
+
+//============================================================================
+bool CDockStatePool::remove(const QString& Name)
+{
+    auto it = Roots.find(Name);
+    if (it == Roots.end())
+    {
+        return false;
+    }
+
+    release(*it);
+    Roots.erase(it);
+    FullSizes.remove(Name);
+    CachedData.remove(Name);
+    return true;
+}
+
+
+//============================================================================
+void CDockStatePool::clear()
+{
+    Chunks.clear();
+    Roots.clear();
+    FullSizes.clear();
+    CachedData.clear();
+}
+
+
+//============================================================================
+bool CDockStatePool::contains(const QString& Name) const
+{
+    return Roots.contains(Name);
+}
+
+
+//============================================================================
+QStringList CDockStatePool::names() const
+{
+    return Roots.keys();
+}
+
+
+//============================================================================
+int CDockStatePool::count() const
+{
+    return Roots.count();
+}
+
+
+//============================================================================
+bool CDockStatePool::state(const QString& Name, DockingState& State) const
+{
+    auto Root = Chunks.constFind(Roots.value(Name));
+    if (Root == Chunks.constEnd())
+    {
+        return false;
+    }
+
+    QDataStream Stream(Root->Data);
+    Stream.setVersion(StatePoolStreamVersion);
+    qint32 Version;
+    qint32 UserVersion;
+    Stream >> Version >> State.HasUserVersion >> UserVersion >> State.CentralWidget;
+    State.Version = Version;
+    State.UserVersion = UserVersion;
+    if (Stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    State.Containers.clear();
+    for (const auto& Child : Root->Children)
+    {
+        ContainerState Container;
+        if (!decodeContainer(Child, Container))
+        {
+            return false;
+        }
+        State.Containers.append(Container);
+    }
+    return true;
+}
+
+
+//============================================================================
+int CDockStatePool::chunkCount() const
+{
+    return Chunks.count();
+}
+
+
+//============================================================================
+qint64 CDockStatePool::memoryUsage() const
+{
+    qint64 Result = 0;
+    for (auto it = Chunks.constBegin(); it != Chunks.constEnd(); ++it)
+    {
+        Result += it.key().size() + it->Data.size();
+        for (const auto& Child : it->Children)
+        {
+            Result += Child.size();
+        }
+    }
+
+    for (auto it = Roots.constBegin(); it != Roots.constEnd(); ++it)
+    {
+        Result += it.key().size() * qint64(sizeof(QChar)) + it->size();
+    }
+
+    for (const auto& Data : CachedData)
+    {
+        Result += Data.size();
+    }
+    return Result;
+}
+
+
+//============================================================================
+qint64 CDockStatePool::fullSize() const
+{
+    qint64 Result = 0;
+    for (auto Size : FullSizes)
+    {
+        Result += Size;
+    }
+    return Result;
+}
+
+
+//============================================================================
+qint64 CDockStatePool::fullSize(const QString& Name) const
+{
+    return FullSizes.value(Name);
+}
+
+
+//============================================================================
+QByteArray CDockStatePool::cachedData(const QString& Name) const
+{
+    return CachedData.value(Name);
+}
+
+
+//============================================================================
+void CDockStatePool::setCachedData(const QString& Name, const QByteArray& Data)
+{
+    if (Roots.contains(Name))
+    {
+        CachedData.insert(Name, Data);
+    }
+}
+
+
+//============================================================================
+QByteArray CDockStatePool::save() const
+{
+    QByteArray Result;
+    QDataStream Stream(&Result, QIODevice::WriteOnly);
+    Stream.setVersion(StatePoolStreamVersion);
+    Stream << StatePoolMagic << StatePoolVersion << quint32(Chunks.count());
+    for (auto it = Chunks.constBegin(); it != Chunks.constEnd(); ++it)
+    {
+        Stream << it.key() << it->Data << it->Children;
+    }
+
+    Stream << quint32(Roots.count());
+    for (auto it = Roots.constBegin(); it != Roots.constEnd(); ++it)
+    {
+        Stream << it.key() << it.value() << FullSizes.value(it.key());
+    }
+    return Result;
+}
+
+
+//============================================================================
+qint64 CDockStatePool::savedSize() const
+{
+    // QDataStream writes byte arrays, strings and lists with a quint32
+    // length prefix
+    const qint64 PrefixSize = sizeof(quint32);
+    qint64 Result = 3 * PrefixSize;  // magic, version and chunk count
+    for (auto it = Chunks.constBegin(); it != Chunks.constEnd(); ++it)
+    {
+        Result += PrefixSize + it.key().size() + PrefixSize + it->Data.size()
+            + PrefixSize;
+        for (const auto& Child : it->Children)
+        {
+            Result += PrefixSize + Child.size();
+        }
+    }
+
+    Result += PrefixSize;  // state count
+    for (auto it = Roots.constBegin(); it != Roots.constEnd(); ++it)
+    {
+        Result += PrefixSize + it.key().size() * qint64(sizeof(QChar))
+            + PrefixSize + it->size() + qint64(sizeof(qint64));
+    }
+    return Result;
+}
+
+
+//============================================================================
+bool CDockStatePool::restore(const QByteArray& Data)
+{
+    QDataStream Stream(Data);
+    Stream.setVersion(StatePoolStreamVersion);
+    quint32 Magic = 0;
+    quint32 Version = 0;
+    quint32 ChunkCount = 0;
+    Stream >> Magic >> Version >> ChunkCount;
+    if (Stream.status() != QDataStream::Ok || Magic != StatePoolMagic
+     || Version > StatePoolVersion)
+    {
+        return false;
+    }
+
+    ChunkHash NewChunks;
+    for (quint32 i = 0; i < ChunkCount && Stream.status() == QDataStream::Ok; ++i)
+    {
+        QByteArray Hash;
+        QByteArray ChunkData;
+        QList<QByteArray> Children;
+        Stream >> Hash >> ChunkData >> Children;
+        // Rehashing detects corrupted chunks
+        if (addChunk(NewChunks, ChunkData, Children) != Hash)
+        {
+            return false;
+        }
+    }
+
+    // Each chunk needs to reference existing chunks only, otherwise the
+    // reference counting would create empty chunks
+    for (const auto& Chunk : NewChunks)
+    {
+        for (const auto& Child : Chunk.Children)
+        {
+            if (!NewChunks.contains(Child))
+            {
+                return false;
+            }
+        }
+    }
+
+    quint32 RootCount = 0;
+    Stream >> RootCount;
+    QMap<QString, QByteArray> NewRoots;
+    QMap<QString, qint64> NewFullSizes;
+    for (quint32 i = 0; i < RootCount && Stream.status() == QDataStream::Ok; ++i)
+    {
+        QString Name;
+        QByteArray Root;
+        qint64 FullSize;
+        Stream >> Name >> Root >> FullSize;
+        if (!NewChunks.contains(Root))
+        {
+            return false;
+        }
+        NewRoots.insert(Name, Root);
+        NewFullSizes.insert(Name, FullSize);
+    }
+
+    if (Stream.status() != QDataStream::Ok)
+    {
+        return false;
+    }
+
+    // The reference counts are rebuilt from the roots - chunks that are not
+    // used by any state are dropped
+    clear();
+    for (const auto& Root : NewRoots)
+    {
+        addRef(Root, NewChunks);
+    }
+    Roots = NewRoots;
+    FullSizes = NewFullSizes;
+    return true;
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockStatePool.cpp
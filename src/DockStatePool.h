@@ -0,0 +1,174 @@
+#ifndef DockStatePoolH
+#define DockStatePoolH
+//============================================================================
+/// \file   DockStatePool.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockStatePool
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockingState;
+struct DockStateNode;
+struct ContainerState;
+
+/**
+ * Memory and disk usage of the perspectives of a dock manager
+ * \see CDockManager::perspectiveStorageUsage()
+ */
+struct PerspectiveStorageUsage
+{
+    int PerspectiveCount = 0;
+    qint64 MemorySize = 0;  ///< bytes of perspective data held in memory
+    qint64 DiskSize = 0;    ///< bytes of perspective data written to disk
+    qint64 FullSize = 0;    ///< bytes of the perspectives as independent state data
+    int UniqueNodeCount = 0;  ///< distinct layout nodes of deduplicated perspectives
+};
+
+/**
+ * A single content addressed node of a CDockStatePool
+ */
+struct DockStatePoolChunk
+{
+    QByteArray Data;
+    QList<QByteArray> Children;  ///< hashes of the child chunks
+    int RefCount = 0;
+};
+
+/**
+ * Stores many docking states with structural sharing.
+ * Each dock area, splitter, container and state is stored as a chunk that
+ * is addressed by the hash of its content and of the hashes of its child
+ * chunks. Equal subtrees of different states are stored only once - if two
+ * perspectives differ only in the sizes of one splitter, they only differ
+ * in the chunks of this splitter and of its parents.
+ */
+class ADS_EXPORT CDockStatePool
+{
+private:
+    QHash<QByteArray, DockStatePoolChunk> Chunks;
+    QMap<QString, QByteArray> Roots;
+    QMap<QString, qint64> FullSizes;
+    QMap<QString, QByteArray> CachedData;
+
+    using ChunkHash = QHash<QByteArray, DockStatePoolChunk>;
+    static QByteArray addChunk(ChunkHash& NewChunks, const QByteArray& Data,
+        const QList<QByteArray>& Children);
+    static QByteArray encodeNode(const DockStateNode& Node, ChunkHash& NewChunks);
+    static QByteArray encodeContainer(const ContainerState& Container,
+        ChunkHash& NewChunks);
+    static QByteArray encodeState(const DockingState& State, ChunkHash& NewChunks);
+    bool decodeNode(const QByteArray& Hash, DockStateNode& Node, int Depth) const;
+    bool decodeContainer(const QByteArray& Hash, ContainerState& Container) const;
+    void addRef(const QByteArray& Hash, const ChunkHash& NewChunks);
+    void release(const QByteArray& Hash);
+
+public:
+    /**
+     * Adds the given state with the given name or replaces the state with
+     * the given name. FullSize is the size of the state data that is
+     * reported by fullSize()
+     */
+    void insert(const QString& Name, const DockingState& State, qint64 FullSize);
+
+    /**
+     * Removes the state with the given name. Chunks that are not used by
+     * another state anymore are deleted.
+     */
+    bool remove(const QString& Name);
+
+    /**
+     * Removes all states
+     */
+    void clear();
+
+    /**
+     * Returns true, if the pool contains a state with the given name
+     */
+    bool contains(const QString& Name) const;
+
+    /**
+     * Returns the names of all states
+     */
+    QStringList names() const;
+
+    /**
+     * Returns the number of states
+     */
+    int count() const;
+
+    /**
+     * Rebuilds the state with the given name from its chunks
+     */
+    bool state(const QString& Name, DockingState& State) const;
+
+    /**
+     * Returns the number of distinct chunks
+     */
+    int chunkCount() const;
+
+    /**
+     * Returns the number of bytes used by the chunks, the state names and
+     * the cached serialized data
+     */
+    qint64 memoryUsage() const;
+
+    /**
+     * Returns the sum of the full sizes passed to insert()
+     */
+    qint64 fullSize() const;
+
+    /**
+     * Returns the full size passed to insert() for the state with the given
+     * name
+     */
+    qint64 fullSize(const QString& Name) const;
+
+    /**
+     * Returns the serialized data of the state with the given name that has
+     * been cached via setCachedData() or an empty byte array
+     */
+    QByteArray cachedData(const QString& Name) const;
+
+    /**
+     * Caches the serialized Data of the state with the given name, so the
+     * state does not need to be rebuilt and serialized again. The cached
+     * data is dropped, if the state is replaced or removed.
+     */
+    void setCachedData(const QString& Name, const QByteArray& Data);
+
+    /**
+     * Serializes all chunks and states
+     */
+    QByteArray save() const;
+
+    /**
+     * Returns the size of the data that save() would return without
+     * serializing the pool
+     */
+    qint64 savedSize() const;
+
+    /**
+     * Replaces the content of this pool with the content serialized via
+     * save(). Returns false, if the data is not a valid serialized pool.
+     */
+    bool restore(const QByteArray& Data);
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // DockStatePoolH
@@ -34,6 +34,7 @@
 #include <QDebug>
 #include <QEvent>
 #include <QGuiApplication>
+#include <QMetaMethod>
 #include <QPointer>
 #include <QScreen>
 #include <QScrollArea>
@@ -42,7 +43,6 @@
 #include <QTextStream>
 #include <QToolBar>
 #include <QWindow>
-#include <QXmlStreamWriter>
 
 #include <AutoHideDockContainer.h>
 #include <AutoHideSideBar.h>
@@ -58,6 +58,8 @@
 #include "DockManager.h"
 #include "DockSplitter.h"
 #include "DockWidgetTab.h"
+#include "DockingStateReader.h"
+#include "DockingStateWriter.h"
 #include "FloatingDockContainer.h"
 #include "ads_globals.h"
 
@@ -100,12 +102,29 @@ struct DockWidgetPrivate
     CDockWidget::eToolBarStyleSource ToolBarStyleSource =
         CDockWidget::ToolBarStyleFromDockManager;
     QList<CDockWidget::CustomButtonData*> CustomButtons = {};
+    CDockWidget::PreviewPixmapFunc PreviewPixmapProvider;
+    QPixmap CachedPreviewPixmap;
+    QSize CachedPreviewContentSize;
+    bool ContentFromFactory = false;
+    CDockWidget::eVisibilityLevel VisibilityLevel = CDockWidget::VisibilityHidden;
 
     /**
      * Private data constructor
      */
     DockWidgetPrivate(CDockWidget* _public);
 
+    /**
+     * Requests a coalesced update of the visibility levels from the dock
+     * manager
+     */
+    void scheduleVisibilityLevelUpdate()
+    {
+        if (DockManager)
+        {
+            DockManager->scheduleVisibilityLevelUpdate();
+        }
+    }
+
     ~DockWidgetPrivate();
 
     /**
@@ -148,6 +167,13 @@ struct DockWidgetPrivate
      */
     bool createWidgetFromFactory();
 
+    /**
+     * Creates the content widget lazily if the dock widget becomes visible
+     * and reports the visibility of factory created content to the dock
+     * manager, if the LazyDockWidgetContent performance flag is set
+     */
+    void updateLazyContent(bool Visible);
+
     /**
      * Use the dock manager toolbar style and icon size for the different states
      */
@@ -172,7 +198,12 @@ DockWidgetPrivate::~DockWidgetPrivate()
 //============================================================================
 void DockWidgetPrivate::showDockWidget()
 {
-    if (!Widget)
+    // While a state is restored, lazy content is created by the Show event
+    // of the dock widget, so hidden tabs do not build their content
+    const bool DeferContent = CDockManager::testPerformanceConfigFlag(
+            CDockManager::LazyDockWidgetContent)
+        && DockManager && DockManager->isRestoringState();
+    if (!Widget && !DeferContent)
     {
         if (!createWidgetFromFactory())
         {
@@ -249,8 +280,13 @@ void DockWidgetPrivate::hideDockWidget()
             delete ScrollArea;
             ScrollArea = nullptr;
         }
-        Widget->deleteLater();
-        Widget = nullptr;
+        // With lazy content, the widget may not have been created yet
+        if (Widget)
+        {
+            Widget->deleteLater();
+            Widget = nullptr;
+        }
+        ContentFromFactory = false;
     }
 }
 
@@ -339,7 +375,9 @@ void DockWidgetPrivate::setupScrollArea()
 //============================================================================
 bool DockWidgetPrivate::createWidgetFromFactory()
 {
-    if (!Features.testFlag(CDockWidget::DeleteContentOnClose))
+    if (!Features.testFlag(CDockWidget::DeleteContentOnClose)
+        && !CDockManager::testPerformanceConfigFlag(
+            CDockManager::LazyDockWidgetContent))
     {
         return false;
     }
@@ -356,9 +394,41 @@ bool DockWidgetPrivate::createWidgetFromFactory()
     }
 
     _this->setWidget(w, Factory->insertMode);
+    ContentFromFactory = true;
     return true;
 }
 
+//============================================================================
+void DockWidgetPrivate::updateLazyContent(bool Visible)
+{
+    if (!CDockManager::testPerformanceConfigFlag(
+            CDockManager::LazyDockWidgetContent))
+    {
+        return;
+    }
+
+    if (Visible && !Widget && Factory)
+    {
+        if (!createWidgetFromFactory())
+        {
+            return;
+        }
+
+        // The dock widget is already visible, so the new content needs to
+        // be shown explicitly
+        QWidget* Content = ScrollArea ? static_cast<QWidget*>(ScrollArea) : Widget;
+        if (!Content->testAttribute(Qt::WA_WState_ExplicitShowHide))
+        {
+            Content->show();
+        }
+    }
+
+    if (ContentFromFactory && DockManager)
+    {
+        DockManager->notifyDockWidgetContentVisible(_this, Visible);
+    }
+}
+
 //============================================================================
 void DockWidgetPrivate::setToolBarStyleFromDockManager()
 {
@@ -444,6 +514,7 @@ void CDockWidget::setWidget(QWidget* widget, eInsertMode InsertMode)
     {
         takeWidget();
     }
+    d->ContentFromFactory = false;
 
     auto ScrollAreaWidget = qobject_cast<QAbstractScrollArea*>(widget);
     if (ScrollAreaWidget || ForceNoScrollArea == InsertMode)
@@ -479,6 +550,33 @@ void CDockWidget::setWidgetFactory(FactoryFunc createWidget,
     d->Factory = new DockWidgetPrivate::WidgetFactory{createWidget, insertMode};
 }
 
+//============================================================================
+void CDockWidget::setPreviewPixmapProvider(PreviewPixmapFunc Provider)
+{
+    d->PreviewPixmapProvider = Provider;
+}
+
+//============================================================================
+CDockWidget::PreviewPixmapFunc CDockWidget::previewPixmapProvider() const
+{
+    return d->PreviewPixmapProvider;
+}
+
+//============================================================================
+QPixmap CDockWidget::cachedPreviewPixmap(const QSize& ContentSize) const
+{
+    return (ContentSize == d->CachedPreviewContentSize) ? d->CachedPreviewPixmap
+                                                        : QPixmap();
+}
+
+//============================================================================
+void CDockWidget::setCachedPreviewPixmap(const QSize& ContentSize,
+                                         const QPixmap& Pixmap)
+{
+    d->CachedPreviewContentSize = ContentSize;
+    d->CachedPreviewPixmap = Pixmap;
+}
+
 //============================================================================
 QWidget* CDockWidget::takeWidget()
 {
@@ -501,9 +599,27 @@ QWidget* CDockWidget::takeWidget()
     {
         w->setParent(nullptr);
     }
+    d->ContentFromFactory = false;
     return w;
 }
 
+//============================================================================
+bool CDockWidget::releaseFactoryContent()
+{
+    if (!d->ContentFromFactory || isVisible())
+    {
+        return false;
+    }
+
+    ADS_PRINT("CDockWidget::releaseFactoryContent " << objectName());
+    QWidget* w = takeWidget();
+    if (w)
+    {
+        w->deleteLater();
+    }
+    return true;
+}
+
 //============================================================================
 QWidget* CDockWidget::widget() const
 {
@@ -752,7 +868,7 @@ void CDockWidget::toggleViewInternal(bool Open)
     CDockWidget* TopLevelDockWidgetBefore =
         DockContainer ? DockContainer->topLevelDockWidget() : nullptr;
 
-    d->Closed = !Open;
+    setClosedState(!Open);
 
     if (Open)
     {
@@ -794,6 +910,11 @@ void CDockWidget::toggleViewInternal(bool Open)
         FloatingContainer->updateWindowTitle();
     }
 
+    if (d->DockManager)
+    {
+        d->DockManager->notifyLayoutMutation(this);
+    }
+
     if (!Open)
     {
         Q_EMIT closed();
@@ -812,32 +933,90 @@ void CDockWidget::setDockArea(CDockAreaWidget* DockArea)
 //============================================================================
 void CDockWidget::saveState(QXmlStreamWriter& s) const
 {
-    s.writeStartElement("Widget");
-    s.writeAttribute("Name", objectName());
-    s.writeAttribute("Closed", QString::number(d->Closed ? 1 : 0));
-    s.writeEndElement();
+    DockWidgetState State;
+    saveState(State);
+    CDockingStateWriter::writeDockWidget(s, State);
+}
+
+//============================================================================
+void CDockWidget::saveState(DockWidgetState& State) const
+{
+    State.Name = objectName();
+    State.Closed = d->Closed;
 }
 
 //============================================================================
 void CDockWidget::flagAsUnassigned()
 {
-    d->Closed = true;
+    setClosedState(true);
     setParent(d->DockManager);
     setVisible(false);
     setDockArea(nullptr);
     tabWidget()->setParent(this);
 }
 
+//============================================================================
+CDockWidget::eVisibilityLevel CDockWidget::visibilityLevel() const
+{
+    // Without receivers of visibilityLevelChanged() the dock manager does
+    // not update the levels in the background
+    if (d->DockManager)
+    {
+        d->DockManager->updatePendingVisibilityLevels();
+    }
+    return d->VisibilityLevel;
+}
+
+//============================================================================
+bool CDockWidget::hasVisibilityLevelReceivers() const
+{
+    static const QMetaMethod Signal =
+        QMetaMethod::fromSignal(&CDockWidget::visibilityLevelChanged);
+    return isSignalConnected(Signal);
+}
+
+//============================================================================
+void CDockWidget::connectNotify(const QMetaMethod& Signal)
+{
+    Super::connectNotify(Signal);
+    if (Signal == QMetaMethod::fromSignal(&CDockWidget::visibilityLevelChanged))
+    {
+        d->scheduleVisibilityLevelUpdate();
+    }
+}
+
+//============================================================================
+void CDockWidget::setVisibilityLevel(eVisibilityLevel Level)
+{
+    if (d->VisibilityLevel == Level)
+    {
+        return;
+    }
+
+    d->VisibilityLevel = Level;
+    Q_EMIT visibilityLevelChanged(Level);
+}
+
 //============================================================================
 bool CDockWidget::event(QEvent* e)
 {
     switch (e->type())
     {
-    case QEvent::Hide: Q_EMIT visibilityChanged(false); break;
+    case QEvent::Hide:
+        // A minimized window does not make the content inactive
+        if (!e->spontaneous())
+        {
+            d->updateLazyContent(false);
+        }
+        Q_EMIT visibilityChanged(false);
+        d->scheduleVisibilityLevelUpdate();
+        break;
 
     case QEvent::Show:
+        d->updateLazyContent(true);
         Q_EMIT visibilityChanged(geometry().right() >= 0
                                  && geometry().bottom() >= 0);
+        d->scheduleVisibilityLevelUpdate();
         break;
 
     case QEvent::WindowTitleChange:
@@ -1055,7 +1234,16 @@ void CDockWidget::emitTopLevelChanged(bool Floating)
 //============================================================================
 void CDockWidget::setClosedState(bool Closed)
 {
+    if (d->Closed == Closed)
+    {
+        return;
+    }
+
     d->Closed = Closed;
+    if (d->DockArea)
+    {
+        d->DockArea->invalidateDockWidgetLists();
+    }
 }
 
 //============================================================================
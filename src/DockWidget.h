@@ -48,6 +48,7 @@ class CAutoHideTab;
 class CAutoHideDockContainer;
 class CAutoHideSideBar;
 class CTitleBarButton;
+struct DockWidgetState;
 
 /**
  * The QDockWidget class provides a widget that can be docked inside a
@@ -56,6 +57,7 @@ class CTitleBarButton;
 class ADS_EXPORT CDockWidget : public QFrame
 {
     Q_OBJECT
+    Q_PROPERTY(int visibilityLevel READ visibilityLevel NOTIFY visibilityLevelChanged)
 private:
     DockWidgetPrivate* d;  ///< private data (pimpl)
     friend struct DockWidgetPrivate;
@@ -79,6 +81,8 @@ protected:
     friend struct DockAreaTitleBarPrivate;
     friend class CAutoHideDockContainer;
     friend CAutoHideSideBar;
+    friend class CFloatingDragPreview;
+    friend struct FloatingDragPreviewPrivate;
 
     /**
      * Assigns the dock manager that manages this dock widget
@@ -104,6 +108,11 @@ protected:
      */
     void saveState(QXmlStreamWriter& Stream) const;
 
+    /**
+     * Saves the state into the given in-memory dock widget state
+     */
+    void saveState(DockWidgetState& State) const;
+
     /**
      * This is a helper function for the dock manager to flag this widget
      * as unassigned.
@@ -135,6 +144,23 @@ protected:
      */
     void setClosedState(bool Closed);
 
+    /**
+     * Sets the visibility level and emits visibilityLevelChanged(), if the
+     * level changed. Called by the dock manager
+     */
+    void setVisibilityLevel(eVisibilityLevel Level);
+
+    /**
+     * Returns true, if the visibilityLevelChanged() signal is connected
+     */
+    bool hasVisibilityLevelReceivers() const;
+
+    /**
+     * Requests a visibility level update, if a receiver is connected to the
+     * visibilityLevelChanged() signal
+     */
+    virtual void connectNotify(const QMetaMethod& Signal) override;
+
     /**
      * Internal toggle view function that does not check if the widget
      * already is in the given state
@@ -147,6 +173,28 @@ protected:
      */
     bool closeDockWidgetInternal(bool ForceClose = false);
 
+    /**
+     * Returns the drag preview pixmap of the last drag operation, if it has
+     * been created for the given content size. Otherwise a null pixmap is
+     * returned
+     */
+    QPixmap cachedPreviewPixmap(const QSize& ContentSize) const;
+
+    /**
+     * Stores the drag preview pixmap that has been created for the given
+     * content size, so that the next drag operation can show it immediately
+     */
+    void setCachedPreviewPixmap(const QSize& ContentSize, const QPixmap& Pixmap);
+
+    /**
+     * Deletes the content widget if it has been created by the widget
+     * factory and if the dock widget is hidden. The content is created again
+     * via the factory the next time the dock widget is shown.
+     * Returns true, if the content has been released
+     * \see CDockManager::setLazyContentBudget()
+     */
+    bool releaseFactoryContent();
+
 	bool eventFilter(QObject* watched, QEvent* event) override;
 	virtual bool focusNextPrevChild(bool next) override;
 public:
@@ -266,6 +314,21 @@ public:
         MinimumSizeHintFromContentMinimumSize,
     };
 
+    /**
+     * Describes how visible the content of a dock widget is for the user.
+     * The levels are ordered, so a content widget can compare the level,
+     * e.g. to pause rendering below VisibilityVisible.
+     * \see visibilityLevel()
+     */
+    enum eVisibilityLevel
+    {
+        VisibilityHidden,  ///< closed, in a non-current tab, in a collapsed auto hide container or in a hidden or minimized window
+        VisibilityOccluded,  ///< shown, but completely covered by a floating widget in front of it
+        VisibilityBackground,  ///< shown, but the application is not active
+        VisibilityVisible,  ///< visible in the active application, but not focused
+        VisibilityFocused  ///< visible and the dock widget or its content has the focus
+    };
+
     /**
      * This mode configures the behavior of the toggle view action.
      * If the mode if ActionModeToggle, then the toggle view action is
@@ -333,11 +396,32 @@ public:
      * which deletes the dock widget itself. Since we keep the dock widget, all
      * regular features of ADS should work as normal, including saving and
      * restoring the state of the docking system and using perspectives.
+     * If the performance flag CDockManager::LazyDockWidgetContent is set,
+     * the factory is also used to create the content widget the first time
+     * the dock widget is shown, if no widget has been set.
      */
     using FactoryFunc = std::function<QWidget*(QWidget*)>;
     void setWidgetFactory(FactoryFunc createWidget,
                           eInsertMode InsertMode = AutoScrollArea);
 
+    /**
+     * Sets a function that provides a cheap preview image of the content
+     * for the drag preview of non-opaque undocking.
+     * The function receives the maximum size of the preview in device
+     * independent pixels. If it returns a null pixmap, the content is
+     * rendered into the preview like without a provider. Use this for
+     * content widgets that are expensive to render, like charts or large
+     * tables, that can provide a thumbnail cheaply.
+     * \see CDockManager::AsyncDragPreviewSnapshot
+     */
+    using PreviewPixmapFunc = std::function<QPixmap(const QSize&)>;
+    void setPreviewPixmapProvider(PreviewPixmapFunc Provider);
+
+    /**
+     * Returns the preview pixmap provider set via setPreviewPixmapProvider()
+     */
+    PreviewPixmapFunc previewPixmapProvider() const;
+
     /**
      * Remove the widget from the dock and give ownership back to the caller
      */
@@ -452,6 +536,18 @@ public:
      */
     bool isClosed() const;
 
+    /**
+     * Returns the visibility level of this dock widget.
+     * The dock manager updates the levels with a short delay, after tabs,
+     * auto hide containers, floating widgets, window states, the z-order or
+     * the focus changed. If no dock widget has a receiver for
+     * visibilityLevelChanged(), the levels are only updated when this
+     * function is called. Content widgets can use the level to throttle
+     * timers or rendering, if nobody can see them.
+     * \see visibilityLevelChanged()
+     */
+    eVisibilityLevel visibilityLevel() const;
+
     /**
      * Returns a checkable action that can be used to show or close this dock
      * widget. The action's text is set to the dock widget's window title.
@@ -758,6 +854,14 @@ Q_SIGNALS:
      * The features parameter gives the new value of the property.
      */
     void featuresChanged(ads::CDockWidget::DockWidgetFeatures features);
+
+    /**
+     * This signal is emitted when the visibility level of the dock widget
+     * changes. Level is a value of eVisibilityLevel. Multiple changes within
+     * the update delay of the dock manager are coalesced into a single
+     * signal.
+     */
+    void visibilityLevelChanged(int Level);
 };  // class DockWidget
 }  // namespace ads
 
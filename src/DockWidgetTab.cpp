@@ -34,10 +34,12 @@
 #include <QLabel>
 #include <QMenu>
 #include <QMouseEvent>
+#include <QPainter>
 #include <QPushButton>
 #include <QSplitter>
 #include <QStyle>
 #include <QToolButton>
+#include <QToolTip>
 
 #include <AutoHideDockContainer.h>
 
@@ -65,7 +67,7 @@ struct DockWidgetTabPrivate
     CDockWidgetTab* _this;
     CDockWidget* DockWidget;
     QLabel* IconLabel = nullptr;
-    tTabLabel* TitleLabel;
+    tTabLabel* TitleLabel = nullptr;
     QPoint GlobalDragStartMousePosition;
     QPoint DragStartMousePosition;
     bool IsActiveTab = false;
@@ -78,6 +80,19 @@ struct DockWidgetTabPrivate
     QPoint TabDragStartPosition;
     QSize IconSize;
     bool MouseOver = false;
+    CDockWidgetTab::eRenderMode RenderMode = CDockWidgetTab::WidgetRendering;
+
+    // State of the painted tab that replaces the child widgets
+    QString Text;
+    QString ElidedText;
+    Qt::TextElideMode ElideMode = Qt::ElideRight;
+    bool IsElided = false;
+    bool TextVisible = true;
+    bool CloseButtonVisible = false;
+    bool CloseButtonRetainsSize = false;
+    bool CloseButtonHovered = false;
+    bool CloseButtonPressed = false;
+    QIcon CloseIcon;
 
     /**
      * Private data constructor
@@ -89,6 +104,96 @@ struct DockWidgetTabPrivate
      */
     void createLayout();
 
+    /**
+     * Initializes the painted tab that does not have any child widgets
+     */
+    void createPaintedTab();
+
+    /**
+     * Returns true, if this tab paints its content itself
+     */
+    bool isPainted() const
+    {
+        return CDockWidgetTab::PaintedRendering == RenderMode;
+    }
+
+    /**
+     * Spacing of the painted tab, that matches the spacing of the layout
+     * of the widget tab
+     */
+    int paintedSpacing() const
+    {
+        return qRound(_this->fontMetrics().height() / 4.0);
+    }
+
+    /**
+     * Returns the size of the icon of the painted tab or an empty size if
+     * the tab has no icon
+     */
+    QSize paintedIconSize() const
+    {
+        if (Icon.isNull())
+        {
+            return QSize(0, 0);
+        }
+        if (IconSize.isValid())
+        {
+            return IconSize;
+        }
+        int Size = _this->style()->pixelMetric(QStyle::PM_SmallIconSize,
+                                               nullptr, _this);
+        return QSize(Size, Size);
+    }
+
+    /**
+     * Returns true, if the painted tab reserves space for the close button
+     */
+    bool hasCloseButtonSpace() const
+    {
+        return CloseButtonVisible || CloseButtonRetainsSize;
+    }
+
+    /**
+     * Rectangles of the painted tab components
+     */
+    QRect iconRect() const;
+    QRect textRect() const;
+    QRect closeButtonRect() const;
+
+    /**
+     * Returns the size hint of the painted tab
+     */
+    QSize paintedSizeHint(bool Minimum) const;
+
+    /**
+     * Elides the title of the painted tab to the available width
+     */
+    void elidePaintedText();
+
+    /**
+     * Updates geometry, elided text and the painting of the painted tab
+     */
+    void updatePaintedTab()
+    {
+        _this->updateGeometry();
+        elidePaintedText();
+        _this->update();
+    }
+
+    /**
+     * Returns the close icon of the painted tab
+     */
+    QIcon createCloseIcon() const
+    {
+        QIcon Icon = CDockManager::iconProvider().customIcon(TabCloseIcon);
+        if (Icon.isNull())
+        {
+            Icon = _this->style()->standardIcon(QStyle::SP_TitleBarCloseButton,
+                                                nullptr, _this);
+        }
+        return Icon;
+    }
+
     /**
      * Moves the tab depending on the position in the given mouse event
      */
@@ -147,6 +252,15 @@ struct DockWidgetTabPrivate
             testConfigFlag(CDockManager::AllTabsHaveCloseButton);
         bool TabHasCloseButton = (ActiveTabHasCloseButton && active)
                                  | AllTabsHaveCloseButton;
+        if (isPainted())
+        {
+            if (CloseButtonVisible != (DockWidgetClosable && TabHasCloseButton))
+            {
+                CloseButtonVisible = DockWidgetClosable && TabHasCloseButton;
+                updatePaintedTab();
+            }
+            return;
+        }
         CloseButton->setVisible(DockWidgetClosable && TabHasCloseButton);
     }
 
@@ -157,10 +271,16 @@ struct DockWidgetTabPrivate
     void updateCloseButtonSizePolicy()
     {
         auto Features = DockWidget->features();
-        auto SizePolicy = CloseButton->sizePolicy();
-        SizePolicy.setRetainSizeWhenHidden(
+        bool RetainSize =
             Features.testFlag(CDockWidget::DockWidgetClosable)
-            && testConfigFlag(CDockManager::RetainTabSizeWhenCloseButtonHidden));
+            && testConfigFlag(CDockManager::RetainTabSizeWhenCloseButtonHidden);
+        if (isPainted())
+        {
+            CloseButtonRetainsSize = RetainSize;
+            return;
+        }
+        auto SizePolicy = CloseButton->sizePolicy();
+        SizePolicy.setRetainSizeWhenHidden(RetainSize);
         CloseButton->setSizePolicy(SizePolicy);
     }
 
@@ -288,6 +408,121 @@ void DockWidgetTabPrivate::createLayout()
     TitleLabel->setVisible(true);
 }
 
+//============================================================================
+void DockWidgetTabPrivate::createPaintedTab()
+{
+    if (CDockManager::testConfigFlag(CDockManager::DisableTabTextEliding))
+    {
+        ElideMode = Qt::ElideNone;
+    }
+    Text = DockWidget->windowTitle();
+    ElidedText = Text;
+    CloseIcon = createCloseIcon();
+    updateCloseButtonSizePolicy();
+    // We need mouse tracking for the hover state of the close button
+    _this->setMouseTracking(true);
+}
+
+//============================================================================
+QRect DockWidgetTabPrivate::iconRect() const
+{
+    auto Rect = _this->contentsRect();
+    auto Size = paintedIconSize();
+    return QRect(Rect.left() + 2 * paintedSpacing(),
+                 Rect.top() + (Rect.height() - Size.height()) / 2,
+                 Size.width(), Size.height());
+}
+
+//============================================================================
+QRect DockWidgetTabPrivate::closeButtonRect() const
+{
+    if (!hasCloseButtonSpace())
+    {
+        return QRect();
+    }
+    auto Rect = _this->contentsRect();
+    const int Size = 17;
+    int Right = Rect.right() + 1 - qRound(paintedSpacing() * 4.0 / 3.0);
+    return QRect(Right - Size, Rect.top() + (Rect.height() - Size) / 2, Size,
+                 Size);
+}
+
+//============================================================================
+QRect DockWidgetTabPrivate::textRect() const
+{
+    auto Rect = _this->contentsRect();
+    int Spacing = paintedSpacing();
+    int Left = Rect.left() + 2 * Spacing;
+    if (!Icon.isNull())
+    {
+        Left += paintedIconSize().width() + qRound(1.5 * Spacing);
+    }
+    int Right = Rect.right() + 1 - qRound(Spacing * 4.0 / 3.0) - Spacing;
+    if (hasCloseButtonSpace())
+    {
+        Right -= closeButtonRect().width();
+    }
+    return QRect(Left, Rect.top(), qMax(0, Right - Left), Rect.height());
+}
+
+//============================================================================
+QSize DockWidgetTabPrivate::paintedSizeHint(bool Minimum) const
+{
+    const auto fm = _this->fontMetrics();
+    int Spacing = paintedSpacing();
+    int TextWidth = 0;
+    if (TextVisible)
+    {
+        bool Elidable = Minimum && (ElideMode != Qt::ElideNone);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 11, 0))
+        TextWidth = fm.horizontalAdvance(Elidable ? Text.left(2) + "…" : Text);
+#else
+        TextWidth = fm.width(Elidable ? Text.left(2) + "…" : Text);
+#endif
+    }
+
+    auto IconSize = paintedIconSize();
+    int Width = 2 * Spacing + TextWidth + Spacing
+                + qRound(Spacing * 4.0 / 3.0);
+    int Height = qMax(fm.height(), IconSize.height());
+    if (!Icon.isNull())
+    {
+        Width += IconSize.width() + qRound(1.5 * Spacing);
+    }
+    if (hasCloseButtonSpace())
+    {
+        Width += 17;
+        Height = qMax(Height, 17);
+    }
+
+    // Add frame and contents margins
+    QSize Decoration = _this->size() - _this->contentsRect().size();
+    return QSize(Width, Height) + Decoration;
+}
+
+//============================================================================
+void DockWidgetTabPrivate::elidePaintedText()
+{
+    bool WasElided = IsElided;
+    if (ElideMode == Qt::ElideNone)
+    {
+        ElidedText = Text;
+        IsElided = false;
+    }
+    else
+    {
+        ElidedText = internal::elidedText(Text, _this->fontMetrics(),
+                                          _this->font(), _this->logicalDpiX(),
+                                          ElideMode, textRect().width());
+        IsElided = (ElidedText != Text);
+    }
+
+    if (IsElided != WasElided)
+    {
+        Q_EMIT _this->elidedChanged(IsElided);
+    }
+}
+
 //============================================================================
 void DockWidgetTabPrivate::moveTab(QMouseEvent* ev)
 {
@@ -368,11 +603,25 @@ bool DockWidgetTabPrivate::startFloating(eDragState DraggingState)
 
 //============================================================================
 CDockWidgetTab::CDockWidgetTab(CDockWidget* DockWidget, QWidget* parent)
+    : CDockWidgetTab(DockWidget, WidgetRendering, parent)
+{}
+
+//============================================================================
+CDockWidgetTab::CDockWidgetTab(CDockWidget* DockWidget, eRenderMode RenderMode,
+                               QWidget* parent)
     : QFrame(parent), d(new DockWidgetTabPrivate(this))
 {
     setAttribute(Qt::WA_NoMousePropagation, true);
     d->DockWidget = DockWidget;
-    d->createLayout();
+    d->RenderMode = RenderMode;
+    if (d->isPainted())
+    {
+        d->createPaintedTab();
+    }
+    else
+    {
+        d->createLayout();
+    }
     setFocusPolicy(Qt::NoFocus);
 }
 
@@ -389,9 +638,25 @@ bool CDockWidgetTab::mouseOver() const
     return d->MouseOver;
 }
 
+//============================================================================
+CDockWidgetTab::eRenderMode CDockWidgetTab::renderMode() const
+{
+    return d->RenderMode;
+}
+
 //============================================================================
 void CDockWidgetTab::mousePressEvent(QMouseEvent* ev)
 {
+    // The painted close button takes the press like a real button does
+    if (d->CloseButtonVisible && ev->button() == Qt::LeftButton
+        && d->closeButtonRect().contains(ev->pos()))
+    {
+        ev->accept();
+        d->CloseButtonPressed = true;
+        update(d->closeButtonRect());
+        return;
+    }
+
     if (ev->button() == Qt::LeftButton)
     {
         ev->accept();
@@ -411,6 +676,18 @@ void CDockWidgetTab::mousePressEvent(QMouseEvent* ev)
 //============================================================================
 void CDockWidgetTab::mouseReleaseEvent(QMouseEvent* ev)
 {
+    if (d->CloseButtonPressed && ev->button() == Qt::LeftButton)
+    {
+        ev->accept();
+        d->CloseButtonPressed = false;
+        update(d->closeButtonRect());
+        if (d->CloseButtonVisible && d->closeButtonRect().contains(ev->pos()))
+        {
+            Q_EMIT closeRequested();
+        }
+        return;
+    }
+
     if (ev->button() == Qt::LeftButton)
     {
         auto CurrentDragState = d->DragState;
@@ -464,6 +741,22 @@ void CDockWidgetTab::mouseReleaseEvent(QMouseEvent* ev)
 //============================================================================
 void CDockWidgetTab::mouseMoveEvent(QMouseEvent* ev)
 {
+    if (d->isPainted())
+    {
+        bool Hovered = d->CloseButtonVisible
+                       && d->closeButtonRect().contains(ev->pos());
+        if (Hovered != d->CloseButtonHovered)
+        {
+            d->CloseButtonHovered = Hovered;
+            update(d->closeButtonRect());
+        }
+        if (d->CloseButtonPressed)
+        {
+            ev->accept();
+            return;
+        }
+    }
+
     if (!(ev->buttons() & Qt::LeftButton) || d->isDraggingState(DraggingInactive))
     {
         d->DragState = DraggingInactive;
@@ -604,10 +897,72 @@ void CDockWidgetTab::enterEvent(QEnterEvent* ev)
 void CDockWidgetTab::leaveEvent(QEvent* ev)
 {
     d->MouseOver = false;
+    d->CloseButtonHovered = false;
     QFrame::leaveEvent(ev);
     update();
 }
 
+//============================================================================
+void CDockWidgetTab::paintEvent(QPaintEvent* ev)
+{
+    Super::paintEvent(ev);
+    if (!d->isPainted())
+    {
+        return;
+    }
+
+    QPainter Painter(this);
+    if (!d->Icon.isNull())
+    {
+        d->Icon.paint(&Painter, d->iconRect(), Qt::AlignCenter,
+                      isEnabled() ? QIcon::Normal : QIcon::Disabled);
+    }
+
+    if (d->TextVisible)
+    {
+        // Mimics the default style sheet of the QLabel of widget tabs
+        Painter.setPen(palette().color(d->IsActiveTab ? QPalette::WindowText :
+                                                        QPalette::Dark));
+        Painter.drawText(d->textRect(), Qt::AlignCenter, d->ElidedText);
+    }
+
+    if (d->CloseButtonVisible)
+    {
+        auto Rect = d->closeButtonRect();
+        if (d->CloseButtonHovered || d->CloseButtonPressed)
+        {
+            Painter.setPen(QColor(0, 0, 0, 32));
+            Painter.setBrush(QColor(0, 0, 0, d->CloseButtonPressed ? 32 : 16));
+            Painter.drawRect(Rect.adjusted(0, 0, -1, -1));
+        }
+        d->CloseIcon.paint(&Painter, Rect, Qt::AlignCenter,
+                           isEnabled() ? QIcon::Normal : QIcon::Disabled);
+    }
+}
+
+//============================================================================
+void CDockWidgetTab::resizeEvent(QResizeEvent* ev)
+{
+    Super::resizeEvent(ev);
+    if (d->isPainted())
+    {
+        d->elidePaintedText();
+    }
+}
+
+//============================================================================
+QSize CDockWidgetTab::sizeHint() const
+{
+    return d->isPainted() ? d->paintedSizeHint(false) : Super::sizeHint();
+}
+
+//============================================================================
+QSize CDockWidgetTab::minimumSizeHint() const
+{
+    return d->isPainted() ? d->paintedSizeHint(true) :
+                            Super::minimumSizeHint();
+}
+
 //============================================================================
 bool CDockWidgetTab::isActiveTab() const
 {
@@ -622,7 +977,12 @@ void CDockWidgetTab::setActiveTab(bool active)
     if (CDockManager::testConfigFlag(CDockManager::ShowTabTextOnlyForActiveTab)
         && !d->Icon.isNull())
     {
-        if (active)
+        if (d->isPainted())
+        {
+            d->TextVisible = active;
+            d->updatePaintedTab();
+        }
+        else if (active)
             d->TitleLabel->setVisible(true);
         else
             d->TitleLabel->setVisible(false);
@@ -683,6 +1043,13 @@ CDockAreaWidget* CDockWidgetTab::dockAreaWidget() const
 //============================================================================
 void CDockWidgetTab::setIcon(const QIcon& Icon)
 {
+    if (d->isPainted())
+    {
+        d->Icon = Icon;
+        d->updatePaintedTab();
+        return;
+    }
+
     QBoxLayout* Layout = qobject_cast<QBoxLayout*>(layout());
     if (!d->IconLabel && Icon.isNull())
     {
@@ -721,7 +1088,7 @@ const QIcon& CDockWidgetTab::icon() const
 //============================================================================
 QString CDockWidgetTab::text() const
 {
-    return d->TitleLabel->text();
+    return d->isPainted() ? d->Text : d->TitleLabel->text();
 }
 
 //============================================================================
@@ -758,13 +1125,19 @@ void CDockWidgetTab::setVisible(bool visible)
 //============================================================================
 void CDockWidgetTab::setText(const QString& title)
 {
+    if (d->isPainted())
+    {
+        d->Text = title;
+        d->updatePaintedTab();
+        return;
+    }
     d->TitleLabel->setText(title);
 }
 
 //============================================================================
 bool CDockWidgetTab::isTitleElided() const
 {
-    return d->TitleLabel->isElided();
+    return d->isPainted() ? d->IsElided : d->TitleLabel->isElided();
 }
 
 //============================================================================
@@ -803,7 +1176,35 @@ void CDockWidgetTab::onAutoHideToActionClicked()
 bool CDockWidgetTab::event(QEvent* e)
 {
 #ifndef QT_NO_TOOLTIP
-    if (e->type() == QEvent::ToolTipChange)
+    if (e->type() == QEvent::ToolTip && d->isPainted())
+    {
+        // Painted tabs show the tool tips of the close button and of the
+        // elided title like the child widgets of widget tabs do
+        auto HelpEvent = static_cast<QHelpEvent*>(e);
+        QString Text = toolTip();
+        if (d->CloseButtonVisible
+            && d->closeButtonRect().contains(HelpEvent->pos()))
+        {
+            Text = tr("Close Tab");
+        }
+        else if (Text.isEmpty() && d->IsElided)
+        {
+            Text = d->Text;
+        }
+
+        if (Text.isEmpty())
+        {
+            QToolTip::hideText();
+            e->ignore();
+        }
+        else
+        {
+            QToolTip::showText(HelpEvent->globalPos(), Text, this);
+        }
+        return true;
+    }
+
+    if (e->type() == QEvent::ToolTipChange && !d->isPainted())
     {
         const auto text = toolTip();
         d->TitleLabel->setToolTip(text);
@@ -817,6 +1218,15 @@ bool CDockWidgetTab::event(QEvent* e)
     {
         d->updateIcon();
     }
+    if (d->isPainted()
+        && (e->type() == QEvent::StyleChange || e->type() == QEvent::FontChange))
+    {
+        if (e->type() == QEvent::StyleChange)
+        {
+            d->CloseIcon = d->createCloseIcon();
+        }
+        d->updatePaintedTab();
+    }
     return Super::event(e);
 }
 
@@ -830,6 +1240,12 @@ void CDockWidgetTab::onDockWidgetFeaturesChanged()
 //============================================================================
 void CDockWidgetTab::setElideMode(Qt::TextElideMode mode)
 {
+    if (d->isPainted())
+    {
+        d->ElideMode = mode;
+        d->updatePaintedTab();
+        return;
+    }
     d->TitleLabel->setElideMode(mode);
 }
 
@@ -850,6 +1266,10 @@ void CDockWidgetTab::setIconSize(const QSize& Size)
 {
     d->IconSize = Size;
     d->updateIcon();
+    if (d->isPainted())
+    {
+        d->updatePaintedTab();
+    }
 }
 
 }  // namespace ads
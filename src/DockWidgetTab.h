@@ -43,7 +43,11 @@ class CDockManager;
 /**
  * A dock widget tab that shows a title and an icon.
  * The dock widget tab is shown in the dock area title bar to switch between
- * tabbed dock widgets
+ * tabbed dock widgets.
+ * By default the title, the icon and the close button are child widgets of
+ * the tab. A tab that is created with the PaintedRendering mode has no child
+ * widgets - it paints the title, the icon and the close button itself and
+ * does the hit testing of the close button internally.
  */
 class ADS_EXPORT CDockWidgetTab : public QFrame
 {
@@ -72,6 +76,8 @@ protected:
     virtual void contextMenuEvent(QContextMenuEvent* ev) override;
     virtual void enterEvent(QEnterEvent* ev) override;
     virtual void leaveEvent(QEvent* ev) override; 
+    virtual void paintEvent(QPaintEvent* ev) override;
+    virtual void resizeEvent(QResizeEvent* ev) override;
 
 
     /**
@@ -81,6 +87,16 @@ protected:
 
 public:
     using Super = QFrame;
+
+    /**
+     * Defines how the tab renders its title, icon and close button
+     */
+    enum eRenderMode
+    {
+        WidgetRendering,  ///< title, icon and close button are child widgets
+        PaintedRendering  ///< the tab paints everything in its paintEvent()
+    };
+
     /**
      * Default Constructor
      * param[in] DockWidget The dock widget this title bar belongs to
@@ -88,6 +104,16 @@ public:
      */
     CDockWidgetTab(CDockWidget* DockWidget, QWidget* parent = nullptr);
 
+    /**
+     * Creates a tab with the given render mode.
+     * Painted tabs use the palette of the tab to draw the title - the
+     * WindowText color for the active tab and the Dark color for all other
+     * tabs. Style sheet rules for the tab itself apply, rules for the QLabel
+     * and the tabCloseButton children do not.
+     */
+    CDockWidgetTab(CDockWidget* DockWidget, eRenderMode RenderMode,
+                   QWidget* parent = nullptr);
+
     /**
      * Virtual Destructor
      */
@@ -95,6 +121,11 @@ public:
 
 	bool mouseOver() const;
 
+    /**
+     * Returns the render mode of this tab
+     */
+    eRenderMode renderMode() const;
+
     /**
      * Returns true, if this is the active tab
      */
@@ -182,6 +213,9 @@ public:
      */
     void setIconSize(const QSize& Size);
 
+    virtual QSize sizeHint() const override;
+    virtual QSize minimumSizeHint() const override;
+
 public Q_SLOTS:
     virtual void setVisible(bool visible) override;
 
@@ -0,0 +1,424 @@
+//============================================================================
+/// \file   DockingStateBinaryFormat.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockingStateBinaryFormat
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingStateBinaryFormat.h"
+
+#include <QDataStream>
+#include <QHash>
+#include <QStringList>
+
+#include "DockManager.h"
+#include "DockingStateReader.h"
+
+namespace ads
+{
+static const quint32 BinaryStateMagic = 0x41445342; // "ADSB"
+static const QDataStream::Version BinaryStreamVersion = QDataStream::Qt_5_0;
+static const int MaxNodeDepth = 256;
+
+enum eContainerFlag
+{
+    ContainerIndependent = 0x01,
+    ContainerFloating = 0x02,
+    ContainerHasRootNode = 0x04
+};
+
+/**
+ * Writes the state body and collects all object names in a string table
+ */
+struct BinaryStateWriter
+{
+    QDataStream& Stream;
+    QStringList Names;
+    QHash<QString, qint32> NameIndices;
+
+    BinaryStateWriter(QDataStream& Stream) : Stream(Stream) {}
+
+    /**
+     * Returns the string table index of the given name - an empty name
+     * is stored as -1
+     */
+    qint32 intern(const QString& Name)
+    {
+        if (Name.isEmpty())
+        {
+            return -1;
+        }
+
+        auto it = NameIndices.constFind(Name);
+        if (it != NameIndices.constEnd())
+        {
+            return it.value();
+        }
+
+        qint32 Index = Names.count();
+        Names.append(Name);
+        NameIndices.insert(Name, Index);
+        return Index;
+    }
+
+    void writeNode(const DockStateNode& Node);
+    void writeContainer(const ContainerState& Container);
+};
+
+/**
+ * Reads the state body and resolves all name references
+ */
+struct BinaryStateReader
+{
+    QDataStream& Stream;
+    QStringList Names;
+
+    BinaryStateReader(QDataStream& Stream) : Stream(Stream) {}
+
+    bool ok() const
+    {
+        return Stream.status() == QDataStream::Ok;
+    }
+
+    /**
+     * Reads a name reference. If Required is true, the name must not
+     * be empty
+     */
+    bool readName(QString& Name, bool Required)
+    {
+        qint32 Index;
+        Stream >> Index;
+        if (!ok() || Index < -1 || Index >= Names.count())
+        {
+            return false;
+        }
+
+        Name = (Index < 0) ? QString() : Names.at(Index);
+        return !Required || !Name.isEmpty();
+    }
+
+    bool readNode(DockStateNode& Node, int Depth);
+    bool readContainer(ContainerState& Container);
+};
+
+//============================================================================
+void BinaryStateWriter::writeNode(const DockStateNode& Node)
+{
+    Stream << quint8(Node.Type);
+    if (Node.Type == DockStateNode::SplitterNode)
+    {
+        Stream << quint8(Node.Orientation) << quint32(Node.Children.size());
+        for (const auto& Child : Node.Children)
+        {
+            writeNode(Child);
+        }
+
+        Stream << quint32(Node.Sizes.count());
+        for (auto Size : Node.Sizes)
+        {
+            Stream << qint32(Size);
+        }
+    }
+    else
+    {
+        Stream << intern(Node.CurrentDockWidget) << qint32(Node.AllowedAreas)
+               << qint32(Node.Flags) << quint32(Node.DockWidgets.count());
+        for (const auto& WidgetState : Node.DockWidgets)
+        {
+            Stream << intern(WidgetState.Name) << quint8(WidgetState.Closed);
+        }
+    }
+}
+
+//============================================================================
+void BinaryStateWriter::writeContainer(const ContainerState& Container)
+{
+    quint8 Flags = 0;
+    if (Container.Independent)
+    {
+        Flags |= ContainerIndependent;
+    }
+    if (Container.Floating)
+    {
+        Flags |= ContainerFloating;
+    }
+    if (Container.HasRootNode)
+    {
+        Flags |= ContainerHasRootNode;
+    }
+
+    Stream << Flags;
+    if (Container.Floating)
+    {
+        Stream << Container.Geometry;
+    }
+
+    if (Container.HasRootNode)
+    {
+        writeNode(Container.RootNode);
+    }
+
+    Stream << quint32(Container.SideBars.count());
+    for (const auto& SideBar : Container.SideBars)
+    {
+        Stream << quint8(SideBar.Area) << quint32(SideBar.DockWidgets.count());
+        for (const auto& WidgetState : SideBar.DockWidgets)
+        {
+            Stream << intern(WidgetState.Name) << quint8(WidgetState.Closed)
+                   << qint32(WidgetState.Size);
+        }
+    }
+}
+
+//============================================================================
+bool BinaryStateReader::readNode(DockStateNode& Node, int Depth)
+{
+    if (Depth > MaxNodeDepth)
+    {
+        return false;
+    }
+
+    quint8 Type;
+    Stream >> Type;
+    if (!ok())
+    {
+        return false;
+    }
+
+    if (Type == DockStateNode::SplitterNode)
+    {
+        Node.Type = DockStateNode::SplitterNode;
+        quint8 Orientation;
+        quint32 ChildCount;
+        Stream >> Orientation >> ChildCount;
+        if (!ok()
+            || (Orientation != Qt::Horizontal && Orientation != Qt::Vertical))
+        {
+            return false;
+        }
+
+        Node.Orientation = static_cast<Qt::Orientation>(Orientation);
+        for (quint32 i = 0; i < ChildCount; ++i)
+        {
+            Node.Children.emplace_back();
+            if (!readNode(Node.Children.back(), Depth + 1))
+            {
+                return false;
+            }
+        }
+
+        quint32 SizeCount;
+        Stream >> SizeCount;
+        if (!ok() || SizeCount != ChildCount)
+        {
+            return false;
+        }
+
+        for (quint32 i = 0; i < SizeCount; ++i)
+        {
+            qint32 Size;
+            Stream >> Size;
+            Node.Sizes.append(Size);
+        }
+        return ok();
+    }
+    else if (Type == DockStateNode::AreaNode)
+    {
+        Node.Type = DockStateNode::AreaNode;
+        if (!readName(Node.CurrentDockWidget, false))
+        {
+            return false;
+        }
+
+        qint32 AllowedAreas;
+        qint32 Flags;
+        quint32 WidgetCount;
+        Stream >> AllowedAreas >> Flags >> WidgetCount;
+        Node.AllowedAreas = AllowedAreas;
+        Node.Flags = Flags;
+        for (quint32 i = 0; ok() && i < WidgetCount; ++i)
+        {
+            DockWidgetState WidgetState;
+            quint8 Closed;
+            if (!readName(WidgetState.Name, true))
+            {
+                return false;
+            }
+            Stream >> Closed;
+            WidgetState.Closed = Closed;
+            Node.DockWidgets.append(WidgetState);
+        }
+        return ok();
+    }
+
+    return false;
+}
+
+//============================================================================
+bool BinaryStateReader::readContainer(ContainerState& Container)
+{
+    quint8 Flags;
+    Stream >> Flags;
+    if (!ok())
+    {
+        return false;
+    }
+
+    Container.Independent = Flags & ContainerIndependent;
+    Container.Floating = Flags & ContainerFloating;
+    Container.HasRootNode = Flags & ContainerHasRootNode;
+    if (Container.Floating)
+    {
+        Stream >> Container.Geometry;
+        if (!ok() || Container.Geometry.isEmpty())
+        {
+            return false;
+        }
+    }
+
+    if (Container.HasRootNode && !readNode(Container.RootNode, 0))
+    {
+        return false;
+    }
+
+    // Simply ignore side bar auto hide widgets from saved state if
+    // auto hide support is disabled
+    const bool AutoHideEnabled = CDockManager::testAutoHideConfigFlag(
+        CDockManager::AutoHideFeatureEnabled);
+    quint32 SideBarCount;
+    Stream >> SideBarCount;
+    for (quint32 i = 0; ok() && i < SideBarCount; ++i)
+    {
+        SideBarState SideBar;
+        quint8 Area;
+        quint32 WidgetCount;
+        Stream >> Area >> WidgetCount;
+        if (!ok() || Area >= SideBarNone)
+        {
+            return false;
+        }
+
+        SideBar.Area = static_cast<SideBarLocation>(Area);
+        for (quint32 j = 0; ok() && j < WidgetCount; ++j)
+        {
+            DockWidgetState WidgetState;
+            quint8 Closed;
+            qint32 Size;
+            if (!readName(WidgetState.Name, true))
+            {
+                return false;
+            }
+            Stream >> Closed >> Size;
+            WidgetState.Closed = Closed;
+            WidgetState.Size = Size;
+            SideBar.DockWidgets.append(WidgetState);
+        }
+
+        if (AutoHideEnabled)
+        {
+            Container.SideBars.append(SideBar);
+        }
+    }
+
+    return ok();
+}
+
+//============================================================================
+bool CDockingStateBinaryFormat::isBinaryState(const QByteArray& Data)
+{
+    if (Data.size() < int(sizeof(BinaryStateMagic)))
+    {
+        return false;
+    }
+
+    QDataStream Stream(Data);
+    Stream.setVersion(BinaryStreamVersion);
+    quint32 Magic;
+    Stream >> Magic;
+    return Magic == BinaryStateMagic;
+}
+
+//============================================================================
+QByteArray CDockingStateBinaryFormat::write(const DockingState& State)
+{
+    // The body is written first, because the string table needs to be
+    // complete before it can be written in front of the body
+    QByteArray Body;
+    QDataStream BodyStream(&Body, QIODevice::WriteOnly);
+    BodyStream.setVersion(BinaryStreamVersion);
+    BinaryStateWriter Writer(BodyStream);
+    BodyStream << Writer.intern(State.CentralWidget)
+               << quint32(State.Containers.count());
+    for (const auto& Container : State.Containers)
+    {
+        Writer.writeContainer(Container);
+    }
+
+    QByteArray Data;
+    QDataStream Stream(&Data, QIODevice::WriteOnly);
+    Stream.setVersion(BinaryStreamVersion);
+    Stream << BinaryStateMagic << quint8(CurrentFormatVersion)
+           << qint32(State.Version) << qint32(State.UserVersion)
+           << quint32(Writer.Names.count());
+    for (const auto& Name : Writer.Names)
+    {
+        Stream << Name;
+    }
+    Stream.writeRawData(Body.constData(), Body.size());
+    return Data;
+}
+
+//============================================================================
+bool CDockingStateBinaryFormat::read(const QByteArray& Data, DockingState& State)
+{
+    QDataStream Stream(Data);
+    Stream.setVersion(BinaryStreamVersion);
+    quint32 Magic;
+    quint8 FormatVersion;
+    qint32 Version;
+    qint32 UserVersion;
+    quint32 NameCount;
+    Stream >> Magic >> FormatVersion >> Version >> UserVersion >> NameCount;
+    if (Stream.status() != QDataStream::Ok || Magic != BinaryStateMagic
+        || FormatVersion > CurrentFormatVersion)
+    {
+        return false;
+    }
+
+    State.Version = Version;
+    State.HasUserVersion = true;
+    State.UserVersion = UserVersion;
+
+    BinaryStateReader Reader(Stream);
+    for (quint32 i = 0; Reader.ok() && i < NameCount; ++i)
+    {
+        QString Name;
+        Stream >> Name;
+        Reader.Names.append(Name);
+    }
+
+    quint32 ContainerCount;
+    if (!Reader.readName(State.CentralWidget, false))
+    {
+        return false;
+    }
+    Stream >> ContainerCount;
+    for (quint32 i = 0; Reader.ok() && i < ContainerCount; ++i)
+    {
+        ContainerState Container;
+        if (!Reader.readContainer(Container))
+        {
+            return false;
+        }
+        State.Containers.append(std::move(Container));
+    }
+
+    return Reader.ok();
+}
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockingStateBinaryFormat.cpp
@@ -0,0 +1,62 @@
+#ifndef DockingStateBinaryFormatH
+#define DockingStateBinaryFormatH
+//============================================================================
+/// \file   DockingStateBinaryFormat.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockingStateBinaryFormat
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockingState;
+
+/**
+ * Compact binary serialization of a parsed docking state.
+ * The binary format is an alternative to the XML format. It is written via
+ * QDataStream and stores each object name only once in a string table -
+ * all dock widgets and dock areas reference the names by index.
+ * Binary states always start with a magic number, so restoreState() can
+ * detect the format automatically.
+ */
+class ADS_EXPORT CDockingStateBinaryFormat
+{
+public:
+    /**
+     * Version of the binary container format
+     */
+    enum eFormatVersion
+    {
+        FormatVersion1 = 1,
+        CurrentFormatVersion = FormatVersion1
+    };
+
+    /**
+     * Returns true, if the given data starts with the magic number of
+     * the binary docking state format
+     */
+    static bool isBinaryState(const QByteArray& Data);
+
+    /**
+     * Serializes the given state into the binary format
+     */
+    static QByteArray write(const DockingState& State);
+
+    /**
+     * Parses the given binary data into State.
+     * Returns false, if the data is not a valid binary docking state
+     */
+    static bool read(const QByteArray& Data, DockingState& State);
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // DockingStateBinaryFormatH
@@ -10,6 +10,10 @@
 //============================================================================
 #include "DockingStateReader.h"
 
+#include <QTextStream>
+
+#include "DockManager.h"
+
 namespace ads
 {
 
@@ -24,6 +28,297 @@ int CDockingStateReader::fileVersion() const
 {
     return m_FileVersion;
 }
+
+//============================================================================
+bool CDockingStateReader::readState(DockingState& State)
+{
+    readNextStartElement();
+    if (name() != QLatin1String("QtAdvancedDockingSystem"))
+    {
+        return false;
+    }
+    ADS_PRINT(attributes().value("Version"));
+    bool Ok;
+    State.Version = attributes().value("Version").toInt(&Ok);
+    if (!Ok)
+    {
+        return false;
+    }
+    setFileVersion(State.Version);
+
+    ADS_PRINT(attributes().value("UserVersion"));
+    // Older files do not support UserVersion but we still want to load them so
+    // we first test if the attribute exists
+    const auto UserVersionAttribute = attributes().value("UserVersion");
+    State.HasUserVersion = !UserVersionAttribute.isEmpty();
+    if (State.HasUserVersion)
+    {
+        State.UserVersion = UserVersionAttribute.toInt(&Ok);
+        if (!Ok)
+        {
+            return false;
+        }
+    }
+    ADS_PRINT(attributes().value("Containers").toInt());
+    State.CentralWidget = attributes().value("CentralWidget").toString();
+
+    while (readNextStartElement())
+    {
+        if (name() == QLatin1String("Container"))
+        {
+            ContainerState Container;
+            if (!readContainer(Container))
+            {
+                return false;
+            }
+            State.Containers.append(std::move(Container));
+        }
+    }
+
+    return true;
+}
+
+//============================================================================
+bool CDockingStateReader::readContainer(ContainerState& Container)
+{
+    Container.Independent = attributes().value("Independent").toInt();
+    Container.Floating = attributes().value("Floating").toInt();
+    ADS_PRINT("Read Container Floating " << Container.Floating);
+    if (Container.Floating)
+    {
+        if (!readNextStartElement() || name() != QLatin1String("Geometry"))
+        {
+            return false;
+        }
+
+        QByteArray GeometryString =
+            readElementText(ErrorOnUnexpectedElement).toLocal8Bit();
+        Container.Geometry = QByteArray::fromHex(GeometryString);
+        if (Container.Geometry.isEmpty())
+        {
+            return false;
+        }
+    }
+
+    while (readNextStartElement())
+    {
+        bool Result = true;
+        if (name() == QLatin1String("Splitter")
+            || name() == QLatin1String("Area"))
+        {
+            // There is only one root node - if the data contains more than
+            // one, then the last one wins
+            Container.RootNode = DockStateNode();
+            Result = readChildNode(Container.RootNode);
+            Container.HasRootNode = true;
+        }
+        else if (name() == QLatin1String("SideBar"))
+        {
+            Result = readSideBar(Container);
+        }
+        else
+        {
+            skipCurrentElement();
+            ADS_PRINT("Unknown element");
+        }
+
+        if (!Result)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//============================================================================
+bool CDockingStateReader::readChildNode(DockStateNode& Node)
+{
+    if (name() == QLatin1String("Splitter"))
+    {
+        return readSplitter(Node);
+    }
+    else
+    {
+        return readDockArea(Node);
+    }
+}
+
+//============================================================================
+bool CDockingStateReader::readSplitter(DockStateNode& Node)
+{
+    Node.Type = DockStateNode::SplitterNode;
+    QString OrientationStr = attributes().value("Orientation").toString();
+
+    // Check if the orientation string is right
+    if (!OrientationStr.startsWith("|") && !OrientationStr.startsWith("-"))
+    {
+        return false;
+    }
+
+    // The "|" shall indicate a vertical splitter handle which in turn means
+    // a Horizontal orientation of the splitter layout.
+    bool HorizontalSplitter = OrientationStr.startsWith("|");
+    // In version 0 we had a small bug. The "|" indicated a vertical orientation,
+    // but this is wrong, because only the splitter handle is vertical, the
+    // layout of the splitter is a horizontal layout. We fix this here
+    if (fileVersion() == 0)
+    {
+        HorizontalSplitter = !HorizontalSplitter;
+    }
+    Node.Orientation = HorizontalSplitter ? Qt::Horizontal : Qt::Vertical;
+
+    bool Ok;
+    int WidgetCount = attributes().value("Count").toInt(&Ok);
+    if (!Ok || WidgetCount < 0)
+    {
+        return false;
+    }
+    ADS_PRINT("Read NodeSplitter Orientation: "
+              << Node.Orientation << " WidgetCount: " << WidgetCount);
+    while (readNextStartElement())
+    {
+        if (name() == QLatin1String("Splitter")
+            || name() == QLatin1String("Area"))
+        {
+            Node.Children.emplace_back();
+            if (!readChildNode(Node.Children.back()))
+            {
+                return false;
+            }
+        }
+        else if (name() == QLatin1String("Sizes"))
+        {
+            QString sSizes = readElementText().trimmed();
+            ADS_PRINT("Sizes: " << sSizes);
+            QTextStream TextStream(&sSizes);
+            while (!TextStream.atEnd())
+            {
+                int value;
+                TextStream >> value;
+                Node.Sizes.append(value);
+            }
+        }
+        else
+        {
+            skipCurrentElement();
+        }
+    }
+
+    return Node.Sizes.count() == WidgetCount;
+}
+
+//============================================================================
+bool CDockingStateReader::readDockArea(DockStateNode& Node)
+{
+    Node.Type = DockStateNode::AreaNode;
+    bool Ok;
+#ifdef ADS_DEBUG_PRINT
+    int Tabs = attributes().value("Tabs").toInt(&Ok);
+    if (!Ok)
+    {
+        return false;
+    }
+#endif
+
+    Node.CurrentDockWidget = attributes().value("Current").toString();
+    ADS_PRINT("Read NodeDockArea Tabs: " << Tabs
+                                         << " Current: " << Node.CurrentDockWidget);
+
+    const auto AllowedAreasAttribute = attributes().value("AllowedAreas");
+    if (!AllowedAreasAttribute.isEmpty())
+    {
+        Node.AllowedAreas = AllowedAreasAttribute.toInt(nullptr, 16);
+    }
+
+    const auto FlagsAttribute = attributes().value("Flags");
+    if (!FlagsAttribute.isEmpty())
+    {
+        Node.Flags = FlagsAttribute.toInt(nullptr, 16);
+    }
+
+    while (readNextStartElement())
+    {
+        if (name() != QLatin1String("Widget"))
+        {
+            skipCurrentElement();
+            continue;
+        }
+
+        DockWidgetState DockWidget;
+        DockWidget.Name = attributes().value("Name").toString();
+        if (DockWidget.Name.isEmpty())
+        {
+            return false;
+        }
+
+        DockWidget.Closed = attributes().value("Closed").toInt(&Ok);
+        if (!Ok)
+        {
+            return false;
+        }
+
+        skipCurrentElement();
+        Node.DockWidgets.append(DockWidget);
+    }
+
+    return true;
+}
+
+//============================================================================
+bool CDockingStateReader::readSideBar(ContainerState& Container)
+{
+    // Simply ignore side bar auto hide widgets from saved state if
+    // auto hide support is disabled
+    if (!CDockManager::testAutoHideConfigFlag(
+            CDockManager::AutoHideFeatureEnabled))
+    {
+        skipCurrentElement();
+        return true;
+    }
+
+    bool Ok;
+    SideBarState SideBar;
+    SideBar.Area = (ads::SideBarLocation)attributes().value("Area").toInt(&Ok);
+    if (!Ok)
+    {
+        return false;
+    }
+
+    while (readNextStartElement())
+    {
+        if (name() != QLatin1String("Widget"))
+        {
+            skipCurrentElement();
+            continue;
+        }
+
+        DockWidgetState DockWidget;
+        DockWidget.Name = attributes().value("Name").toString();
+        if (DockWidget.Name.isEmpty())
+        {
+            return false;
+        }
+
+        DockWidget.Closed = attributes().value("Closed").toInt(&Ok);
+        if (!Ok)
+        {
+            return false;
+        }
+
+        DockWidget.Size = attributes().value("Size").toInt(&Ok);
+        if (!Ok)
+        {
+            return false;
+        }
+
+        skipCurrentElement();
+        SideBar.DockWidgets.append(DockWidget);
+    }
+
+    Container.SideBars.append(SideBar);
+    return true;
+}
 }  // namespace ads
 
 //---------------------------------------------------------------------------
@@ -10,11 +10,92 @@
 //============================================================================
 //                                   INCLUDES
 //============================================================================
+#include <QByteArray>
+#include <QList>
+#include <QString>
 #include <QXmlStreamReader>
 
+#include <vector>
+
+#include "ads_globals.h"
+
 namespace ads
 {
 
+/**
+ * Saved state of a single dock widget in a dock area or in an auto hide
+ * side bar
+ */
+struct DockWidgetState
+{
+    QString Name;
+    bool Closed = false;
+    int Size = 0;  ///< only used for auto hide side bar widgets
+};
+
+/**
+ * A node of the saved splitter tree of a dock container.
+ * A node is either a splitter with child nodes or a dock area with
+ * dock widgets.
+ */
+struct DockStateNode
+{
+    enum eNodeType
+    {
+        SplitterNode,
+        AreaNode
+    };
+
+    eNodeType Type = AreaNode;
+
+    // Splitter data
+    Qt::Orientation Orientation = Qt::Horizontal;
+    QList<int> Sizes;
+    std::vector<DockStateNode> Children;
+
+    // Dock area data
+    QString CurrentDockWidget;
+    int AllowedAreas = -1;  ///< -1 if the state does not contain allowed areas
+    int Flags = -1;         ///< -1 if the state does not contain area flags
+    QList<DockWidgetState> DockWidgets;
+};
+
+/**
+ * Saved state of an auto hide side bar
+ */
+struct SideBarState
+{
+    SideBarLocation Area = SideBarNone;
+    QList<DockWidgetState> DockWidgets;
+};
+
+/**
+ * Saved state of a dock container
+ */
+struct ContainerState
+{
+    bool Independent = false;
+    bool Floating = false;
+    QByteArray Geometry;  ///< geometry of floating containers
+    bool HasRootNode = false;
+    DockStateNode RootNode;
+    QList<SideBarState> SideBars;
+};
+
+/**
+ * The complete parsed and validated state of a dock manager.
+ * The state is parsed once by CDockingStateReader::readState() and then
+ * used for checking and restoring without any further XML parsing.
+ */
+struct DockingState
+{
+    int Version = 0;
+    bool HasUserVersion = false;
+    int UserVersion = 0;
+    QString CentralWidget;
+    QList<ContainerState> Containers;
+};
+
 /**
  * Extends QXmlStreamReader with file version information
  */
@@ -23,6 +104,10 @@ class CDockingStateReader : public QXmlStreamReader
 private:
     int m_FileVersion;
 
+    bool readChildNode(DockStateNode& Node);
+    bool readSplitter(DockStateNode& Node);
+    bool readSideBar(ContainerState& Container);
+
 public:
     using QXmlStreamReader::QXmlStreamReader;
 
@@ -35,6 +120,27 @@ public:
      * Returns the file version set via setFileVersion
      */
     int fileVersion() const;
+
+    /**
+     * Parses the complete docking state into the given State.
+     * Returns false, if the data is not a valid docking state. The function
+     * only validates the structure of the data. Checking the version numbers
+     * and the central widget is up to the caller.
+     */
+    bool readState(DockingState& State);
+
+    /**
+     * Parses a single Container element into the given Container.
+     * The reader needs to be positioned on the start of the Container
+     * element.
+     */
+    bool readContainer(ContainerState& Container);
+
+    /**
+     * Parses a single Area element into the given Node.
+     * The reader needs to be positioned on the start of the Area element.
+     */
+    bool readDockArea(DockStateNode& Node);
 };
 
 }  // namespace ads
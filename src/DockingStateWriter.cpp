@@ -0,0 +1,153 @@
+//============================================================================
+/// \file   DockingStateWriter.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockingStateWriter
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingStateWriter.h"
+
+#if QT_VERSION < 0x050900
+// Implemented in DockContainerWidget.cpp
+QByteArray qByteArrayToHex(const QByteArray& src, char separator);
+#endif
+
+namespace ads
+{
+
+//============================================================================
+void CDockingStateWriter::writeState(const DockingState& State)
+{
+    writeStartDocument();
+    writeStartElement("QtAdvancedDockingSystem");
+    writeAttribute("Version", QString::number(State.Version));
+    if (State.HasUserVersion)
+    {
+        writeAttribute("UserVersion", QString::number(State.UserVersion));
+    }
+    writeAttribute("Containers", QString::number(State.Containers.count()));
+    if (!State.CentralWidget.isEmpty())
+    {
+        writeAttribute("CentralWidget", State.CentralWidget);
+    }
+    for (const auto& Container : State.Containers)
+    {
+        writeContainer(*this, Container);
+    }
+    writeEndElement();
+    writeEndDocument();
+}
+
+//============================================================================
+void CDockingStateWriter::writeContainer(QXmlStreamWriter& Stream,
+    const ContainerState& Container)
+{
+    Stream.writeStartElement("Container");
+    Stream.writeAttribute("Independent", QString::number(Container.Independent ? 1 : 0));
+    Stream.writeAttribute("Floating", QString::number(Container.Floating ? 1 : 0));
+    if (Container.Floating)
+    {
+#if QT_VERSION < 0x050900
+        Stream.writeTextElement("Geometry", qByteArrayToHex(Container.Geometry, ' '));
+#else
+        Stream.writeTextElement("Geometry", Container.Geometry.toHex(' '));
+#endif
+    }
+
+    if (Container.HasRootNode)
+    {
+        writeChildNode(Stream, Container.RootNode);
+    }
+
+    for (const auto& SideBar : Container.SideBars)
+    {
+        writeSideBar(Stream, SideBar);
+    }
+    Stream.writeEndElement();
+}
+
+//============================================================================
+void CDockingStateWriter::writeChildNode(QXmlStreamWriter& Stream,
+    const DockStateNode& Node)
+{
+    if (Node.Type == DockStateNode::SplitterNode)
+    {
+        Stream.writeStartElement("Splitter");
+        Stream.writeAttribute("Orientation",
+                              (Node.Orientation == Qt::Horizontal) ? "|" : "-");
+        Stream.writeAttribute("Count", QString::number(int(Node.Children.size())));
+        for (const auto& Child : Node.Children)
+        {
+            writeChildNode(Stream, Child);
+        }
+
+        Stream.writeStartElement("Sizes");
+        for (auto Size : Node.Sizes)
+        {
+            Stream.writeCharacters(QString::number(Size) + " ");
+        }
+        Stream.writeEndElement();
+        Stream.writeEndElement();
+        return;
+    }
+
+    Stream.writeStartElement("Area");
+    Stream.writeAttribute("Tabs", QString::number(Node.DockWidgets.count()));
+    Stream.writeAttribute("Current", Node.CurrentDockWidget);
+    if (Node.AllowedAreas >= 0)
+    {
+        Stream.writeAttribute("AllowedAreas", QString::number(Node.AllowedAreas, 16));
+    }
+
+    if (Node.Flags >= 0)
+    {
+        Stream.writeAttribute("Flags", QString::number(Node.Flags, 16));
+    }
+
+    for (const auto& WidgetState : Node.DockWidgets)
+    {
+        writeDockWidget(Stream, WidgetState);
+    }
+    Stream.writeEndElement();
+}
+
+//============================================================================
+void CDockingStateWriter::writeSideBar(QXmlStreamWriter& Stream,
+    const SideBarState& SideBar)
+{
+    if (SideBar.DockWidgets.isEmpty())
+    {
+        return;
+    }
+
+    Stream.writeStartElement("SideBar");
+    Stream.writeAttribute("Area", QString::number(SideBar.Area));
+    Stream.writeAttribute("Tabs", QString::number(SideBar.DockWidgets.count()));
+    for (const auto& WidgetState : SideBar.DockWidgets)
+    {
+        writeDockWidget(Stream, WidgetState, true);
+    }
+    Stream.writeEndElement();
+}
+
+//============================================================================
+void CDockingStateWriter::writeDockWidget(QXmlStreamWriter& Stream,
+    const DockWidgetState& WidgetState, bool WriteSize)
+{
+    Stream.writeStartElement("Widget");
+    Stream.writeAttribute("Name", WidgetState.Name);
+    Stream.writeAttribute("Closed", QString::number(WidgetState.Closed ? 1 : 0));
+    if (WriteSize)
+    {
+        Stream.writeAttribute("Size", QString::number(WidgetState.Size));
+    }
+    Stream.writeEndElement();
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockingStateWriter.cpp
@@ -0,0 +1,69 @@
+#ifndef DockingStateWriterH
+#define DockingStateWriterH
+//============================================================================
+/// \file   DockingStateWriter.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockingStateWriter
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QXmlStreamWriter>
+
+#include "DockingStateReader.h"
+
+namespace ads
+{
+
+/**
+ * Writes a parsed docking state as XML.
+ * This is the counterpart of CDockingStateReader. The writer only works on
+ * the plain DockingState tree and never touches any widget, so it can be
+ * used from a worker thread. The written XML is identical to the XML that
+ * the saveState() functions of the dock widgets write.
+ */
+class CDockingStateWriter : public QXmlStreamWriter
+{
+public:
+    using QXmlStreamWriter::QXmlStreamWriter;
+
+    /**
+     * Writes the complete XML document for the given state
+     */
+    void writeState(const DockingState& State);
+
+    /**
+     * Writes the Container element of the given container state into
+     * the given stream
+     */
+    static void writeContainer(QXmlStreamWriter& Stream,
+        const ContainerState& Container);
+
+    /**
+     * Writes the Splitter or Area element of the given node and all its
+     * child nodes into the given stream
+     */
+    static void writeChildNode(QXmlStreamWriter& Stream,
+        const DockStateNode& Node);
+
+    /**
+     * Writes the SideBar element of the given side bar state into the
+     * given stream. Nothing is written for an empty side bar.
+     */
+    static void writeSideBar(QXmlStreamWriter& Stream,
+        const SideBarState& SideBar);
+
+    /**
+     * Writes the Widget element of the given dock widget state into the
+     * given stream. The size is only written for auto hide dock widgets.
+     */
+    static void writeDockWidget(QXmlStreamWriter& Stream,
+        const DockWidgetState& WidgetState, bool WriteSize = false);
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // DockingStateWriterH
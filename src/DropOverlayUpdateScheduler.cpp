@@ -0,0 +1,144 @@
+//============================================================================
+/// \file   DropOverlayUpdateScheduler.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDropOverlayUpdateScheduler
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DropOverlayUpdateScheduler.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+#include "DockManager.h"
+
+namespace ads
+{
+/**
+ * Returns the duration of one display frame of the primary screen in ms
+ */
+static int frameInterval()
+{
+    QScreen* Screen = QGuiApplication::primaryScreen();
+    qreal RefreshRate = Screen ? Screen->refreshRate() : 60.0;
+    if (RefreshRate < 1.0)
+    {
+        RefreshRate = 60.0;
+    }
+    return qMax(1, qRound(1000.0 / RefreshRate));
+}
+
+//============================================================================
+CDropOverlayUpdateScheduler::CDropOverlayUpdateScheduler(UpdateFunction Function)
+    : Function(std::move(Function))
+{
+    FrameTimer.setSingleShot(true);
+    FrameTimer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&FrameTimer, &QTimer::timeout,
+                     [this]() { onFrameTimeout(); });
+}
+
+//============================================================================
+void CDropOverlayUpdateScheduler::setDockManager(CDockManager* DockManager)
+{
+    this->DockManager = DockManager;
+}
+
+//============================================================================
+void CDropOverlayUpdateScheduler::schedule(const QPoint& GlobalPos)
+{
+    if (!CDockManager::testPerformanceConfigFlag(
+            CDockManager::CoalesceDropOverlayUpdates))
+    {
+        Function(GlobalPos);
+        return;
+    }
+
+    // Inside of a frame we only remember the last position for the
+    // trailing update
+    if (FrameTimer.isActive())
+    {
+        if (UpdatePending && DockManager)
+        {
+            DockManager->countDropOverlayUpdate(true);
+        }
+        PendingPos = GlobalPos;
+        UpdatePending = true;
+        return;
+    }
+
+    FrameTimer.start(frameInterval());
+    Function(GlobalPos);
+}
+
+//============================================================================
+void CDropOverlayUpdateScheduler::flush()
+{
+    if (!UpdatePending)
+    {
+        return;
+    }
+
+    UpdatePending = false;
+    Function(PendingPos);
+}
+
+//============================================================================
+void CDropOverlayUpdateScheduler::cancel()
+{
+    FrameTimer.stop();
+    UpdatePending = false;
+    resetHoverState();
+}
+
+//============================================================================
+void CDropOverlayUpdateScheduler::onFrameTimeout()
+{
+    if (!UpdatePending)
+    {
+        return;
+    }
+
+    // Restart the frame, so that moves during the trailing update are
+    // coalesced again
+    FrameTimer.start(frameInterval());
+    flush();
+}
+
+//============================================================================
+bool CDropOverlayUpdateScheduler::setHoverState(
+    const DropOverlayHoverState& State)
+{
+    if (!CDockManager::testPerformanceConfigFlag(
+            CDockManager::CoalesceDropOverlayUpdates))
+    {
+        if (DockManager)
+        {
+            DockManager->countDropOverlayUpdate(false);
+        }
+        return true;
+    }
+
+    bool Changed = !HoverStateValid || !(State == LastHoverState);
+    LastHoverState = State;
+    HoverStateValid = true;
+    if (DockManager)
+    {
+        DockManager->countDropOverlayUpdate(!Changed);
+    }
+    return Changed;
+}
+
+//============================================================================
+void CDropOverlayUpdateScheduler::resetHoverState()
+{
+    HoverStateValid = false;
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DropOverlayUpdateScheduler.cpp
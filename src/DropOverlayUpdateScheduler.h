@@ -0,0 +1,121 @@
+#ifndef DropOverlayUpdateSchedulerH
+#define DropOverlayUpdateSchedulerH
+//============================================================================
+/// \file   DropOverlayUpdateScheduler.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDropOverlayUpdateScheduler
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QPoint>
+#include <QPointer>
+#include <QTimer>
+
+#include <functional>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+class CDockManager;
+class CDockContainerWidget;
+class CDockAreaWidget;
+
+/**
+ * The drop target that is hovered by the mouse cursor during dragging.
+ * If the hover state does not change between two mouse moves, then the
+ * drop overlays do not need to be updated.
+ */
+struct DropOverlayHoverState
+{
+    CDockContainerWidget* Container = nullptr;
+    CDockAreaWidget* DockArea = nullptr;
+    DockWidgetArea ContainerDropArea = InvalidDockWidgetArea;
+    DockWidgetArea DockDropArea = InvalidDockWidgetArea;
+    int ContainerTabIndex = -1;
+    int DockAreaTabIndex = -1;
+
+    bool operator==(const DropOverlayHoverState& Other) const
+    {
+        return Container == Other.Container && DockArea == Other.DockArea
+               && ContainerDropArea == Other.ContainerDropArea
+               && DockDropArea == Other.DockDropArea
+               && ContainerTabIndex == Other.ContainerTabIndex
+               && DockAreaTabIndex == Other.DockAreaTabIndex;
+    }
+};
+
+/**
+ * Coalesces the drop overlay updates of a dragged floating widget or drag
+ * preview.
+ * Mouse move events arrive at the mouse polling rate, which may be much
+ * higher than the display refresh rate. If the CoalesceDropOverlayUpdates
+ * performance flag is set, the first move in a display frame updates the
+ * overlays immediately and all following moves in the same frame are
+ * merged into one trailing update at the end of the frame.
+ */
+class CDropOverlayUpdateScheduler
+{
+public:
+    using UpdateFunction = std::function<void(const QPoint&)>;
+
+    /**
+     * Creates a scheduler that calls the given function to update the
+     * drop overlays
+     */
+    CDropOverlayUpdateScheduler(UpdateFunction Function);
+
+    /**
+     * Sets the dock manager that receives the update statistics
+     */
+    void setDockManager(CDockManager* DockManager);
+
+    /**
+     * Requests an overlay update for the given global cursor position
+     */
+    void schedule(const QPoint& GlobalPos);
+
+    /**
+     * Immediately performs a pending update. Call this function before the
+     * drop target is evaluated to ensure that the overlays reflect the
+     * last cursor position
+     */
+    void flush();
+
+    /**
+     * Discards a pending update and resets the last hover state
+     */
+    void cancel();
+
+    /**
+     * Stores the given hover state and returns true, if it differs from
+     * the hover state of the last update. If the state did not change, the
+     * update is counted as skipped and the caller can skip the overlay update
+     */
+    bool setHoverState(const DropOverlayHoverState& State);
+
+    /**
+     * Resets the last hover state, so that the next update is always
+     * performed
+     */
+    void resetHoverState();
+
+private:
+    UpdateFunction Function;
+    QPointer<CDockManager> DockManager;
+    QTimer FrameTimer;
+    QPoint PendingPos;
+    bool UpdatePending = false;
+    DropOverlayHoverState LastHoverState;
+    bool HoverStateValid = false;
+
+    void onFrameTimeout();
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // DropOverlayUpdateSchedulerH
@@ -28,10 +28,141 @@
 //============================================================================
 #include "ElidingLabel.h"
 
+#include <QHash>
 #include <QMouseEvent>
 
 namespace ads
 {
+namespace
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+using tHashValue = size_t;
+#else
+using tHashValue = uint;
+#endif
+
+/**
+ * Maximum number of texts in the elided text cache. If the cache grows
+ * beyond this size, it is cleared
+ */
+const int MaxElidedTextCacheTexts = 2048;
+
+/**
+ * Maximum number of cached widths per text
+ */
+const int MaxElidedTextCacheWidths = 128;
+
+/**
+ * Identifies a text, its font and the elide mode in the elided text cache
+ */
+struct ElidedTextKey
+{
+    QString Text;
+    QFont Font;
+    int Dpi;
+    int Mode;
+
+    bool operator==(const ElidedTextKey& Other) const
+    {
+        return Mode == Other.Mode && Dpi == Other.Dpi && Text == Other.Text
+               && Font == Other.Font;
+    }
+};
+
+tHashValue qHash(const ElidedTextKey& Key, tHashValue Seed = 0)
+{
+    return ::qHash(Key.Text, Seed) ^ ::qHash(Key.Font, Seed)
+           ^ tHashValue(Key.Dpi * 31 + Key.Mode);
+}
+
+/**
+ * The elided texts of one key. All widths that are wide enough for the
+ * complete text share one bucket, so only widths that really elide the text
+ * get their own entry.
+ */
+struct ElidedTextEntry
+{
+    int TextWidth = 0;
+    QHash<int, QString> ElidedTexts;
+};
+
+/**
+ * The elided text cache shared by all eliding labels and painted tabs
+ */
+struct ElidedTextCache
+{
+    QHash<ElidedTextKey, ElidedTextEntry> Entries;
+    quint64 HitCount = 0;
+    quint64 MissCount = 0;
+    quint64 SkippedSetTextCount = 0;
+};
+
+//============================================================================
+ElidedTextCache& elidedTextCache()
+{
+    static ElidedTextCache Cache;
+    return Cache;
+}
+}  // namespace
+
+//============================================================================
+QString internal::elidedText(const QString& Text, const QFontMetrics& Metrics,
+                             const QFont& Font, int Dpi, Qt::TextElideMode Mode,
+                             int Width)
+{
+    auto& Cache = elidedTextCache();
+    ElidedTextKey Key{Text, Font, Dpi, int(Mode)};
+    auto Entry = Cache.Entries.find(Key);
+    bool Miss = false;
+    if (Entry == Cache.Entries.end())
+    {
+        if (Cache.Entries.size() >= MaxElidedTextCacheTexts)
+        {
+            Cache.Entries.clear();
+        }
+        Entry = Cache.Entries.insert(Key, ElidedTextEntry());
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 11, 0))
+        Entry->TextWidth = Metrics.horizontalAdvance(Text);
+#else
+        Entry->TextWidth = Metrics.width(Text);
+#endif
+        Miss = true;
+    }
+
+    if (Width >= Entry->TextWidth)
+    {
+        if (Miss)
+        {
+            ++Cache.MissCount;
+        }
+        else
+        {
+            ++Cache.HitCount;
+        }
+        return Text;
+    }
+
+    auto ElidedText = Entry->ElidedTexts.constFind(Width);
+    if (ElidedText != Entry->ElidedTexts.constEnd())
+    {
+        ++Cache.HitCount;
+        return *ElidedText;
+    }
+
+    ++Cache.MissCount;
+    QString Result = Metrics.elidedText(Text, Mode, Width);
+    if (Result == "…")
+    {
+        Result = Text.left(1);
+    }
+    if (Entry->ElidedTexts.size() >= MaxElidedTextCacheWidths)
+    {
+        Entry->ElidedTexts.clear();
+    }
+    Entry->ElidedTexts.insert(Width, Result);
+    return Result;
+}
+
 /**
  * Private data of public CClickableLabel
  */
@@ -59,19 +190,23 @@ void ElidingLabelPrivate::elideText(int Width)
     {
         return;
     }
-    QFontMetrics fm = _this->fontMetrics();
-    QString str = fm.elidedText(Text, ElideMode,
-                                Width - _this->margin() * 2 - _this->indent());
-    if (str == "…")
-    {
-        str = Text.at(0);
-    }
+    QString str = internal::elidedText(
+        Text, _this->fontMetrics(), _this->font(), _this->logicalDpiX(),
+        ElideMode, Width - _this->margin() * 2 - _this->indent());
     bool WasElided = IsElided;
     IsElided = str != Text;
     if (IsElided != WasElided)
     {
         Q_EMIT _this->elidedChanged(IsElided);
     }
+
+    // QLabel::setText() clears the label contents and triggers a relayout
+    // and repaint, even if the text did not change
+    if (str == _this->QLabel::text())
+    {
+        ++elidedTextCache().SkippedSetTextCount;
+        return;
+    }
     _this->QLabel::setText(str);
 }
 
@@ -114,6 +249,39 @@ bool CElidingLabel::isElided() const
     return d->IsElided;
 }
 
+//============================================================================
+quint64 CElidingLabel::elidedTextCacheHitCount()
+{
+    return elidedTextCache().HitCount;
+}
+
+//============================================================================
+quint64 CElidingLabel::elidedTextCacheMissCount()
+{
+    return elidedTextCache().MissCount;
+}
+
+//============================================================================
+quint64 CElidingLabel::skippedSetTextCount()
+{
+    return elidedTextCache().SkippedSetTextCount;
+}
+
+//============================================================================
+void CElidingLabel::resetElidedTextCacheCounters()
+{
+    auto& Cache = elidedTextCache();
+    Cache.HitCount = 0;
+    Cache.MissCount = 0;
+    Cache.SkippedSetTextCount = 0;
+}
+
+//============================================================================
+void CElidingLabel::clearElidedTextCache()
+{
+    elidedTextCache().Entries.clear();
+}
+
 //============================================================================
 void CElidingLabel::mouseReleaseEvent(QMouseEvent* event)
 {
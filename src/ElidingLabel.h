@@ -36,6 +36,21 @@ namespace ads
 {
 struct ElidingLabelPrivate;
 
+namespace internal
+{
+/**
+ * Returns the elided version of Text for the given font metrics, elide mode
+ * and available width. The results are kept in an elided text cache that is
+ * shared by all eliding labels and painted tabs. If the elided text would
+ * only consist of the ellipsis, the first character of Text is returned.
+ * Font and Dpi identify the font metrics in the cache. The cache may only be
+ * used from the GUI thread.
+ */
+ADS_EXPORT QString elidedText(const QString& Text, const QFontMetrics& Metrics,
+                              const QFont& Font, int Dpi,
+                              Qt::TextElideMode Mode, int Width);
+}  // namespace internal
+
 /**
  * A QLabel that supports eliding text.
  * Because the functions setText() and text() are no virtual functions setting
@@ -79,6 +94,34 @@ public:
      */
     bool isElided() const;
 
+    /**
+     * Returns the number of elided text requests that have been answered
+     * from the elided text cache shared by all eliding labels
+     */
+    static quint64 elidedTextCacheHitCount();
+
+    /**
+     * Returns the number of elided text requests that required a call of
+     * QFontMetrics::elidedText()
+     */
+    static quint64 elidedTextCacheMissCount();
+
+    /**
+     * Returns the number of QLabel::setText() calls that have been skipped,
+     * because the elided text of a label did not change
+     */
+    static quint64 skippedSetTextCount();
+
+    /**
+     * Resets the counters of the elided text cache
+     */
+    static void resetElidedTextCacheCounters();
+
+    /**
+     * Removes all entries from the elided text cache
+     */
+    static void clearElidedTextCache();
+
 public:  // reimplements QLabel ----------------------------------------------
     virtual QSize minimumSizeHint() const override;
     virtual QSize sizeHint() const override;
@@ -43,18 +43,20 @@
 #include <QTime>
 #include <QTimer>
 #include <QWindow>
-#include <QXmlStreamWriter>
 
 #include <iostream>
 
 #include "DockAreaTitleBar.h"
 #include "DockAreaWidget.h"
 #include "DockContainerWidget.h"
+#include "DockInstrumentation.h"
 #include "DockManager.h"
 #include "DockOverlay.h"
 #include "DockSplitter.h"
 #include "DockWidget.h"
 #include "DockingStateReader.h"
+#include "DropOverlayUpdateScheduler.h"
+#include "LiveResizeFreezer.h"
 
 #ifdef Q_OS_WIN
 #    include <windows.h>
@@ -411,12 +413,23 @@ struct FloatingDockContainerPrivate
     QStatusBar* StatusBar = nullptr;
     CDockOverlay* IndependentDockAreaOverlay = nullptr;
     CDockOverlay* IndependentContainerOverlay = nullptr;
+    CDropOverlayUpdateScheduler DropOverlayScheduler;
+    CLiveResizeFreezer ResizeFreezer;
 
     /**
      * Private data constructor
      */
     FloatingDockContainerPrivate(CFloatingDockContainer* _public);
 
+    /**
+     * Returns true, if the content should be frozen during live resizing
+     */
+    bool freezesLiveResize() const
+    {
+        return CDockManager::testPerformanceConfigFlag(
+            CDockManager::FrozenLiveResize);
+    }
+
     void titleMouseReleaseEvent();
     void updateDropOverlays(const QPoint& GlobalPos);
 
@@ -444,6 +457,10 @@ struct FloatingDockContainerPrivate
             return;
         }
         DraggingState = StateId;
+        if (DraggingInactive == DraggingState)
+        {
+            DropOverlayScheduler.cancel();
+        }
         if (DraggingFloatingWidget == DraggingState)
         {
             qApp->postEvent(
@@ -518,12 +535,16 @@ struct FloatingDockContainerPrivate
 //============================================================================
 FloatingDockContainerPrivate::FloatingDockContainerPrivate(
     CFloatingDockContainer* _public)
-    : _this(_public)
+    : _this(_public),
+      DropOverlayScheduler([this](const QPoint& GlobalPos)
+                           { updateDropOverlays(GlobalPos); })
 {}
 
 //============================================================================
 void FloatingDockContainerPrivate::titleMouseReleaseEvent()
 {
+    // The drop target needs to reflect the last cursor position
+    DropOverlayScheduler.flush();
     setState(DraggingInactive);
     if (!DropContainer)
     {
@@ -604,6 +625,7 @@ void FloatingDockContainerPrivate::titleMouseReleaseEvent()
 //============================================================================
 void FloatingDockContainerPrivate::updateDropOverlays(const QPoint& GlobalPos)
 {
+    ADS_TRACE_SCOPE("CFloatingDockContainer::updateDropOverlays");
     if (!_this->isVisible() || !DockManager)
     {
         return;
@@ -616,35 +638,28 @@ void FloatingDockContainerPrivate::updateDropOverlays(const QPoint& GlobalPos)
         return;
     }
 
-    auto Containers = DockManager->dockContainers();
 	auto PrevTopContainer = TopContainer;
-	TopContainer = nullptr;
-    for (auto ContainerWidget : Containers)
+	TopContainer = DockManager->dockContainerAt(GlobalPos, DockContainer);
+    CDockOverlay* ContainerOverlay = _this->containerOverlay();
+    CDockOverlay* DockAreaOverlay = _this->dockAreaOverlay();
+	auto ContainerDropArea = ContainerOverlay->dropAreaUnderCursor();
+	auto DockDropArea = DockAreaOverlay->dropAreaUnderCursor();
+    auto DockArea = TopContainer ? TopContainer->dockAreaAt(GlobalPos) : nullptr;
+
+    // Nothing to do if the mouse still hovers the same drop target
+    DropOverlayHoverState HoverState;
+    HoverState.Container = TopContainer;
+    HoverState.DockArea = DockArea;
+    HoverState.ContainerDropArea = ContainerDropArea;
+    HoverState.DockDropArea = DockDropArea;
+    HoverState.ContainerTabIndex = ContainerOverlay->tabIndexUnderCursor();
+    HoverState.DockAreaTabIndex = DockAreaOverlay->tabIndexUnderCursor();
+    if (!DropOverlayScheduler.setHoverState(HoverState))
     {
-        if (!ContainerWidget->isVisible())
-        {
-            continue;
-        }
-
-        if (DockContainer == ContainerWidget)
-        {
-            continue;
-        }
-
-        QPoint MappedPos = ContainerWidget->mapFromGlobal(GlobalPos);
-        if (ContainerWidget->rect().contains(MappedPos))
-        {
-			auto oldTopContainer = TopContainer;
-            if (!TopContainer || ContainerWidget->isInFrontOf(TopContainer))
-            {
-                TopContainer = ContainerWidget;
-            }
-        }
+        return;
     }
 
     DropContainer = TopContainer;
-    CDockOverlay* ContainerOverlay = _this->containerOverlay();
-    CDockOverlay* DockAreaOverlay = _this->dockAreaOverlay();
 
 	if (!TopContainer || (DropContainer && DropContainer->window()->isMinimized()))
     {
@@ -665,12 +680,9 @@ void FloatingDockContainerPrivate::updateDropOverlays(const QPoint& GlobalPos)
 	}
 
 
-	auto ContainerDropArea = ContainerOverlay->dropAreaUnderCursor();
-	auto DockDropArea = DockAreaOverlay->dropAreaUnderCursor();
     int VisibleDockAreas = TopContainer->visibleDockAreaCount();
 	// Center dock widget area if the container has no dock area
 	DockWidgetAreas AllowedContainerAreas = (VisibleDockAreas > 1) ? OuterDockAreas : CenterDockWidgetArea;
-    auto DockArea = TopContainer->dockAreaAt(GlobalPos);
 	// no dock area for the container overlay if one area exists
     if (VisibleDockAreas == 1 && DockArea)
     {
@@ -753,6 +765,7 @@ CFloatingDockContainer::CFloatingDockContainer(CDockManager* DockManager,
                                                bool independent /*= false*/)
     : tFloatingWidgetBase(DockManager), d(new FloatingDockContainerPrivate(this))
 {
+    ADS_TRACE_SCOPE("CFloatingDockContainer::CFloatingDockContainer");
     setMouseTracking(true);
     this->installEventFilter(this);
     d->LeftMBPressed = false;
@@ -768,6 +781,7 @@ CFloatingDockContainer::CFloatingDockContainer(CDockManager* DockManager,
     }
     hide();
     d->DockManager = DockManager;
+    d->DropOverlayScheduler.setDockManager(DockManager);
     d->DockContainer = new CDockContainerWidget(DockManager, this);
     bool result = connect(d->DockContainer, SIGNAL(dockAreasAdded()), this,
                           SLOT(onDockAreasAddedOrRemoved()));
@@ -991,15 +1005,10 @@ CFloatingDockContainer* CFloatingDockContainer::moveContainerAndDelete()
 
     CFloatingDockContainer* RestoredFloatingWidget = new CFloatingDockContainer(
         d->DockManager, d->DockContainer->hasIndependentWidget());
-    QByteArray containerData;
-    QXmlStreamWriter writer(&containerData);
-    d->DockContainer->saveState(writer);
+    ContainerState State;
+    d->DockContainer->saveState(State);
     blockSignals(true);
-    CDockingStateReader reader(containerData);
-    reader.setFileVersion(1);
-    reader.readNextStartElement();
-    Q_ASSERT(RestoredFloatingWidget->restoreState(reader, false)
-             && "Restore failed!");
+    RestoredFloatingWidget->restoreState(State);
     RestoredFloatingWidget->d->DockContainer->fetchIndependentCount();
     RestoredFloatingWidget->d->DockContainer->rootSplitter()->setVisible(true);
     if (RestoredFloatingWidget->dockContainer()->dockAreaCount() == 1
@@ -1035,6 +1044,10 @@ void CFloatingDockContainer::changeEvent(QEvent* event)
     Super::changeEvent(event);
     if ((event->type() == QEvent::WindowStateChange))
     {
+        if (d->DockManager)
+        {
+            d->DockManager->scheduleVisibilityLevelUpdate();
+        }
         ADS_PRINT("FloatingWidget::changeEvent QEvent::ActivationChange");
        	if (windowState() == Qt::WindowState::WindowMinimized && d->DraggingState == DraggingFloatingWidget)
         {
@@ -1087,7 +1100,7 @@ bool CFloatingDockContainer::nativeEvent(const QByteArray& eventType,
 		}
         if (d->isState(DraggingFloatingWidget))
         {
-            d->updateDropOverlays(QCursor::pos());
+            d->DropOverlayScheduler.schedule(QCursor::pos());
         }
     }
     break;
@@ -1123,6 +1136,9 @@ bool CFloatingDockContainer::nativeEvent(const QByteArray& eventType,
     break;
     case WM_EXITSIZEMOVE:
 	{
+        // The window system resize ended, so we do not need to wait for the
+        // idle timeout to relayout the frozen content
+        d->ResizeFreezer.unfreeze();
         if (d->isState(DraggingFloatingWidget))
         {
             ADS_PRINT("CFloatingDockContainer::nativeEvent WM_EXITSIZEMOVE");
@@ -1267,10 +1283,10 @@ void CFloatingDockContainer::moveFloating()
     {
     case DraggingMousePressed:
         d->setState(DraggingFloatingWidget);
-        d->updateDropOverlays(QCursor::pos());
+        d->DropOverlayScheduler.schedule(QCursor::pos());
         break;
 
-    case DraggingFloatingWidget: d->updateDropOverlays(QCursor::pos()); break;
+    case DraggingFloatingWidget: d->DropOverlayScheduler.schedule(QCursor::pos()); break;
     default: break;
     }
 }
@@ -1376,19 +1392,14 @@ void CFloatingDockContainer::onDockAreaCurrentChanged(int Index)
 }
 
 //============================================================================
-bool CFloatingDockContainer::restoreState(CDockingStateReader& Stream,
-                                          bool Testing)
+void CFloatingDockContainer::restoreState(const ContainerState& State)
 {
-    if (!d->DockContainer->restoreState(Stream, Testing))
-    {
-        return false;
-    }
+    d->DockContainer->restoreState(State);
     onDockAreasAddedOrRemoved();
     if (d->TitleBar)
     {
         d->TitleBar->setMaximizedIcon(windowState() == Qt::WindowMaximized);
     }
-    return true;
 }
 
 //============================================================================
@@ -1549,14 +1560,18 @@ bool CFloatingDockContainer::event(QEvent* e)
 void CFloatingDockContainer::moveEvent(QMoveEvent* event)
 {
     QWidget::moveEvent(event);
+    if (d->DockManager)
+    {
+        d->DockManager->notifyLayoutMutation(d->DockContainer);
+    }
     switch (d->DraggingState)
     {
     case DraggingMousePressed:
         d->setState(DraggingFloatingWidget);
-        d->updateDropOverlays(QCursor::pos());
+        d->DropOverlayScheduler.schedule(QCursor::pos());
         break;
 
-    case DraggingFloatingWidget: d->updateDropOverlays(QCursor::pos()); break;
+    case DraggingFloatingWidget: d->DropOverlayScheduler.schedule(QCursor::pos()); break;
     default: break;
     }
     QApplication::setActiveWindow(this);
@@ -1632,7 +1647,21 @@ void CFloatingDockContainer::resizeEvent(QResizeEvent* event)
     d->IsResizing = true;
 		d->setState(DraggingInactive);
 	}
+    // The frameless resizing via the resize region freezes the content until
+    // the mouse is released, all other resizes come from the window system
+    bool RegionResize = d->LeftMBPressed
+        && d->CursorDirection != FloatingDockContainerPrivate::eDirection::NONE;
+    if (d->freezesLiveResize() && event->spontaneous() && !RegionResize
+        && isVisible())
+    {
+        d->ResizeFreezer.liveResize(d->DockContainer);
+    }
     Super::resizeEvent(event);
+    if (d->DockManager)
+    {
+        d->DockManager->scheduleVisibilityLevelUpdate();
+        d->DockManager->notifyLayoutMutation(d->DockContainer);
+    }
 }
 
 // static bool s_mousePressed = false;
@@ -1640,10 +1669,15 @@ void CFloatingDockContainer::resizeEvent(QResizeEvent* event)
 void CFloatingDockContainer::moveEvent(QMoveEvent* event)
 {
     Super::moveEvent(event);
+    if (d->DockManager)
+    {
+        d->DockManager->scheduleVisibilityLevelUpdate();
+        d->DockManager->notifyLayoutMutation(d->DockContainer);
+    }
     if (!d->IsResizing && event->spontaneous() && d->MousePressed)
     {
         d->setState(DraggingFloatingWidget);
-        d->updateDropOverlays(QCursor::pos());
+        d->DropOverlayScheduler.schedule(QCursor::pos());
         QApplication::setActiveWindow(this);
         activateWindow();
     }
@@ -1798,6 +1832,7 @@ void CFloatingDockContainer::mouseReleaseEvent(QMouseEvent* event)
         d->LeftMBPressed = false;
         if (d->CursorDirection != FloatingDockContainerPrivate::eDirection::NONE)
         {
+            d->ResizeFreezer.unfreeze();
             d->CursorDirection = FloatingDockContainerPrivate::eDirection::NONE;
             // this->releaseMouse();
             this->setCursor(QCursor(Qt::ArrowCursor));
@@ -1889,6 +1924,10 @@ void CFloatingDockContainer::mouseMoveEvent(QMouseEvent* event)
                 rMove.moveTopLeft(
                     rMove.topLeft()
                     + QPoint(d->ResizeRegionPadding, d->ResizeRegionPadding));
+                if (d->freezesLiveResize())
+                {
+                    d->ResizeFreezer.freeze(d->DockContainer);
+                }
                 this->setGeometry(rMove);
             }
             else
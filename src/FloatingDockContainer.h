@@ -53,7 +53,7 @@ struct DockManagerPrivate;
 class CDockWidgetTab;
 struct DockWidgetTabPrivate;
 class CDockOverlay;
-class CDockingStateReader;
+struct ContainerState;
 
 /**
  * Pure virtual interface for floating widgets.
@@ -170,12 +170,9 @@ protected:
     void moveFloating() override;
 
     /**
-     * Restores the state from given stream.
-     * If Testing is true, the function only parses the data from the given
-     * stream but does not restore anything. You can use this check for
-     * faulty files before you start restoring the state
+     * Restores the state from the given parsed container state
      */
-    bool restoreState(CDockingStateReader& Stream, bool Testing);
+    void restoreState(const ContainerState& State);
 
     /**
      * Call this function to update the window title
@@ -25,15 +25,23 @@
 #include "AutoHideDockContainer.h"
 #include "DockAreaWidget.h"
 #include "DockContainerWidget.h"
+#include "DockInputDispatcher.h"
+#include "DockInstrumentation.h"
 #include "DockManager.h"
 #include "DockOverlay.h"
 #include "DockWidget.h"
+#include "DropOverlayUpdateScheduler.h"
 #include "ads_globals.h"
 #ifdef Q_OS_WINDOWS
 #    include "Windows.h"
 #endif
 namespace ads
 {
+/**
+ * Maximum width and height of the downscaled content pixmap of the drag
+ * preview in device independent pixels
+ */
+static const int MaxPreviewPixmapExtent = 512;
 
 /**
  * Private data class (pimpl)
@@ -51,7 +59,10 @@ struct FloatingDragPreviewPrivate
     qreal WindowOpacity;
     bool Hidden = false;
     QPixmap ContentPreviewPixmap;
+    QSize ContentPreviewSize;
+    bool ContentPreviewPending = false;
     bool Canceled = false;
+    CDropOverlayUpdateScheduler DropOverlayScheduler;
 
     /**
      * Private data constructor
@@ -59,6 +70,23 @@ struct FloatingDragPreviewPrivate
     FloatingDragPreviewPrivate(CFloatingDragPreview* _public);
     void updateDropOverlays(const QPoint& GlobalPos);
 
+    /**
+     * Creates the downscaled content pixmap. If the content is a dock widget
+     * with a preview pixmap provider, the provider creates the pixmap
+     */
+    void createContentPreviewPixmap();
+
+    /**
+     * The only safe way to receive escape key presses is to filter the
+     * events of the application object. The input dispatcher of the dock
+     * manager forwards the key presses to the drag preview
+     */
+    void registerInputClient()
+    {
+        DockManager->dockInputDispatcher()->registerClient(_this,
+            CDockInputDispatcher::KeyPressEvents);
+    }
+
     void setHidden(bool Value)
     {
         Hidden = Value;
@@ -71,6 +99,7 @@ struct FloatingDragPreviewPrivate
     void cancelDragging()
     {
         Canceled = true;
+        DropOverlayScheduler.cancel();
         Q_EMIT _this->draggingCanceled();
         if (ContentSourceArea && ContentSourceArea->dockContainer()->isFloating())
         {
@@ -135,6 +164,7 @@ struct FloatingDragPreviewPrivate
 //============================================================================
 void FloatingDragPreviewPrivate::updateDropOverlays(const QPoint& GlobalPos)
 {
+    ADS_TRACE_SCOPE("CFloatingDragPreview::updateDropOverlays");
     if (!_this->isVisible() || !DockManager)
     {
         return;
@@ -147,27 +177,8 @@ void FloatingDragPreviewPrivate::updateDropOverlays(const QPoint& GlobalPos)
         return;
     }
 
-    auto Containers = DockManager->dockContainers();
 	CDockContainerWidget* PrevTopContainer = TopContainer;
-    TopContainer = nullptr;
-    for (auto ContainerWidget : Containers)
-    {
-        if (!ContainerWidget->isVisible())
-        {
-            continue;
-        }
-
-        QPoint MappedPos = ContainerWidget->mapFromGlobal(GlobalPos);
-        if (ContainerWidget->rect().contains(MappedPos))
-        {
-            if (!TopContainer || ContainerWidget->isInFrontOf(TopContainer))
-            {
-                TopContainer = ContainerWidget;
-            }
-        }
-    }
-
-    DropContainer = TopContainer;
+    TopContainer = DockManager->dockContainerAt(GlobalPos);
     CDockOverlay* ContainerOverlay = 0;
     CDockOverlay* DockAreaOverlay = 0;
     if (ContentSourceArea->dockContainer()->isFloating())
@@ -185,6 +196,24 @@ void FloatingDragPreviewPrivate::updateDropOverlays(const QPoint& GlobalPos)
         DockAreaOverlay = DockManager->dockAreaOverlay();
     }
 
+    auto DockDropArea = DockAreaOverlay->dropAreaUnderCursor();
+    auto ContainerDropArea = ContainerOverlay->dropAreaUnderCursor();
+    auto DockArea = TopContainer ? TopContainer->dockAreaAt(GlobalPos) : nullptr;
+
+    // Nothing to do if the mouse still hovers the same drop target
+    DropOverlayHoverState HoverState;
+    HoverState.Container = TopContainer;
+    HoverState.DockArea = DockArea;
+    HoverState.ContainerDropArea = ContainerDropArea;
+    HoverState.DockDropArea = DockDropArea;
+    HoverState.ContainerTabIndex = ContainerOverlay->tabIndexUnderCursor();
+    HoverState.DockAreaTabIndex = DockAreaOverlay->tabIndexUnderCursor();
+    if (!DropOverlayScheduler.setHoverState(HoverState))
+    {
+        return;
+    }
+
+    DropContainer = TopContainer;
     if (!TopContainer)
     {
         ContainerOverlay->hideOverlay();
@@ -213,14 +242,11 @@ void FloatingDragPreviewPrivate::updateDropOverlays(const QPoint& GlobalPos)
 		TopContainer->raise();
 	}
 
-    auto DockDropArea = DockAreaOverlay->dropAreaUnderCursor();
-    auto ContainerDropArea = ContainerOverlay->dropAreaUnderCursor();
     int VisibleDockAreas = TopContainer->visibleDockAreaCount();
     auto dockAreaWidget = qobject_cast<CDockAreaWidget*>(Content);
 	// Center dock widget area if the container has no dock area
     DockWidgetAreas AllowedContainerAreas =
         (VisibleDockAreas > 1) ? OuterDockAreas : CenterDockWidgetArea;
-    auto DockArea = TopContainer->dockAreaAt(GlobalPos);
 	// no dock area for the container overlay if one area exists
     if (VisibleDockAreas == 1 && DockArea)
     {
@@ -301,10 +327,57 @@ void FloatingDragPreviewPrivate::updateDropOverlays(const QPoint& GlobalPos)
     }
 }
 
+//============================================================================
+void FloatingDragPreviewPrivate::createContentPreviewPixmap()
+{
+    if (!_this->isVisible() || Canceled || ContentPreviewSize.isEmpty())
+    {
+        return;
+    }
+
+    QSize PixmapSize = ContentPreviewSize;
+    if (PixmapSize.width() > MaxPreviewPixmapExtent
+        || PixmapSize.height() > MaxPreviewPixmapExtent)
+    {
+        PixmapSize.scale(MaxPreviewPixmapExtent, MaxPreviewPixmapExtent,
+                         Qt::KeepAspectRatio);
+    }
+
+    auto DockWidget = qobject_cast<CDockWidget*>(Content);
+    auto Provider = DockWidget ? DockWidget->previewPixmapProvider()
+                               : CDockWidget::PreviewPixmapFunc();
+    QPixmap Pixmap = Provider ? Provider(PixmapSize) : QPixmap();
+    if (Pixmap.isNull())
+    {
+#if QT_VERSION >= 0x050600
+        double DevicePixelRatio = _this->devicePixelRatioF();
+#else
+        double DevicePixelRatio = _this->devicePixelRatio();
+#endif
+        Pixmap = QPixmap(PixmapSize * DevicePixelRatio);
+        Pixmap.setDevicePixelRatio(DevicePixelRatio);
+        Pixmap.fill(Qt::transparent);
+        QPainter Painter(&Pixmap);
+        Painter.scale(
+            qreal(PixmapSize.width()) / ContentPreviewSize.width(),
+            qreal(PixmapSize.height()) / ContentPreviewSize.height());
+        Content->render(&Painter);
+    }
+
+    ContentPreviewPixmap = Pixmap;
+    if (DockWidget)
+    {
+        DockWidget->setCachedPreviewPixmap(ContentPreviewSize, Pixmap);
+    }
+    _this->update();
+}
+
 //============================================================================
 FloatingDragPreviewPrivate::FloatingDragPreviewPrivate(
     CFloatingDragPreview* _public)
-    : _this(_public)
+    : _this(_public),
+      DropOverlayScheduler([this](const QPoint& GlobalPos)
+                           { updateDropOverlays(GlobalPos); })
 {}
 
 //============================================================================
@@ -379,16 +452,30 @@ CFloatingDragPreview::CFloatingDragPreview(QWidget* Content, QWidget* parent)
     // operations
     if (CDockManager::testConfigFlag(CDockManager::DragPreviewShowsContentPixmap))
     {
-        d->ContentPreviewPixmap = QPixmap(Content->size());
-        Content->render(&d->ContentPreviewPixmap);
+        d->ContentPreviewSize = Content->size();
+        if (CDockManager::testPerformanceConfigFlag(
+                CDockManager::AsyncDragPreviewSnapshot))
+        {
+            // Start the drag with the pixmap of the last drag operation or
+            // with a placeholder and render the new pixmap as soon as the
+            // preview is shown - see showEvent()
+            auto DockWidget = qobject_cast<CDockWidget*>(Content);
+            if (DockWidget)
+            {
+                d->ContentPreviewPixmap =
+                    DockWidget->cachedPreviewPixmap(d->ContentPreviewSize);
+            }
+            d->ContentPreviewPending = true;
+        }
+        else
+        {
+            d->ContentPreviewPixmap = QPixmap(Content->size());
+            Content->render(&d->ContentPreviewPixmap);
+        }
     }
 
     connect(qApp, SIGNAL(applicationStateChanged(Qt::ApplicationState)),
             SLOT(onApplicationStateChanged(Qt::ApplicationState)));
-
-    // The only safe way to receive escape key presses is to install an event
-    // filter for the application object
-    qApp->installEventFilter(this);
 }
 
 //============================================================================
@@ -396,6 +483,8 @@ CFloatingDragPreview::CFloatingDragPreview(CDockWidget* Content)
     : CFloatingDragPreview((QWidget*)Content, Content)
 {
     d->DockManager = Content->dockManager();
+    d->DropOverlayScheduler.setDockManager(d->DockManager);
+    d->registerInputClient();
     d->ContentSourceArea = Content->dockAreaWidget();
     setWindowTitle(Content->windowTitle());
 }
@@ -405,6 +494,8 @@ CFloatingDragPreview::CFloatingDragPreview(CDockAreaWidget* Content)
     : CFloatingDragPreview((QWidget*)Content, Content)
 {
     d->DockManager = Content->dockManager();
+    d->DropOverlayScheduler.setDockManager(d->DockManager);
+    d->registerInputClient();
     d->ContentSourceArea = Content;
     setWindowTitle(Content->currentDockWidget()->windowTitle());
 }
@@ -422,8 +513,7 @@ void CFloatingDragPreview::moveFloating()
     const QPoint moveToPos = QCursor::pos() - d->DragStartMousePosition
                              - QPoint(BorderSize, 0);
 	move(moveToPos);
-	qInfo() << "CFloatingDragPreview::moveFloating";
-    d->updateDropOverlays(QCursor::pos());
+    d->DropOverlayScheduler.schedule(QCursor::pos());
 }
 
 //============================================================================
@@ -443,6 +533,9 @@ void CFloatingDragPreview::startFloating(const QPoint& DragStartMousePos,
 void CFloatingDragPreview::finishDragging()
 {
     ADS_PRINT("CFloatingDragPreview::finishDragging");
+    // The drop target needs to reflect the last cursor position
+    d->DropOverlayScheduler.flush();
+    d->DropOverlayScheduler.cancel();
     CDockOverlay* containerOverlay = 0;
     CDockOverlay* dockAreaOverlay = 0;
     if (d->ContentSourceArea
@@ -609,6 +702,21 @@ void CFloatingDragPreview::cleanupAutoHideContainerWidget(
     AutoHideContainer->cleanupAndDelete();
 }
 
+//============================================================================
+void CFloatingDragPreview::showEvent(QShowEvent* event)
+{
+    Super::showEvent(event);
+    if (!d->ContentPreviewPending)
+    {
+        return;
+    }
+
+    // The preview is painted once with the placeholder before the content
+    // pixmap is rendered, so the drag starts without delay
+    d->ContentPreviewPending = false;
+    QTimer::singleShot(0, this, [this]() { d->createContentPreviewPixmap(); });
+}
+
 //============================================================================
 void CFloatingDragPreview::paintEvent(QPaintEvent* event)
 {
@@ -622,7 +730,18 @@ void CFloatingDragPreview::paintEvent(QPaintEvent* event)
     painter.setOpacity(0.6);
     if (CDockManager::testConfigFlag(CDockManager::DragPreviewShowsContentPixmap))
     {
-        painter.drawPixmap(QPoint(0, 0), d->ContentPreviewPixmap);
+        if (d->ContentPreviewPixmap.isNull())
+        {
+            // Placeholder until the content pixmap is ready
+            painter.fillRect(rect(), palette().color(QPalette::Active,
+                                                     QPalette::Window));
+        }
+        else
+        {
+            painter.setRenderHint(QPainter::SmoothPixmapTransform);
+            painter.drawPixmap(QRect(QPoint(0, 0), d->ContentPreviewSize),
+                               d->ContentPreviewPixmap);
+        }
     }
 
     // If we do not have a window frame then we paint a QRubberBand like
@@ -671,7 +790,7 @@ bool CFloatingDragPreview::eventFilter(QObject* watched, QEvent* event)
         QKeyEvent* e = static_cast<QKeyEvent*>(event);
         if (e->key() == Qt::Key_Escape)
         {
-            watched->removeEventFilter(this);
+            d->DockManager->dockInputDispatcher()->unregisterClient(this);
             d->cancelDragging();
         }
     }
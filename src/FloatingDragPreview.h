@@ -45,6 +45,12 @@ protected:
      */
     virtual void paintEvent(QPaintEvent* e) override;
 
+    /**
+     * Renders the content preview pixmap, if it has been deferred until the
+     * preview is visible
+     */
+    virtual void showEvent(QShowEvent* event) override;
+
     /**
      * The content is a DockArea or a DockWidget
      */
@@ -0,0 +1,467 @@
+//============================================================================
+/// \file   LayoutJournal.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CLayoutJournal
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "LayoutJournal.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include "DockingStateBinaryFormat.h"
+#include "DockingStateReader.h"
+
+namespace ads
+{
+static const quint32 LayoutJournalMagic = 0x4144534A; // "ADSJ"
+static const quint32 LayoutJournalVersion = 1;
+static const QDataStream::Version JournalStreamVersion = QDataStream::Qt_5_0;
+static const qint64 FileHeaderSize = 8;
+static const qint64 RecordHeaderSize = 7;
+
+enum eRecordType
+{
+    SnapshotRecord = 1,
+    ContainerRecord,
+    RemoveContainerRecord,
+    SplitterSizesRecord,
+    DockAreaRecord
+};
+
+
+/**
+ * Returns the checksum that protects the payload of a record
+ */
+static quint16 recordChecksum(const QByteArray& Payload)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return qChecksum(Payload);
+#else
+    return qChecksum(Payload.constData(), uint(Payload.size()));
+#endif
+}
+
+
+/**
+ * Appends a record with the given Type and Payload to Buffer
+ */
+static void appendRecord(QByteArray& Buffer, eRecordType Type,
+    const QByteArray& Payload)
+{
+    uchar Header[RecordHeaderSize];
+    Header[0] = uchar(Type);
+    qToLittleEndian<quint32>(quint32(Payload.size()), Header + 1);
+    qToLittleEndian<quint16>(recordChecksum(Payload), Header + 5);
+    Buffer.append(reinterpret_cast<const char*>(Header), RecordHeaderSize);
+    Buffer.append(Payload);
+}
+
+
+/**
+ * Serializes a single container via the binary state format
+ */
+static QByteArray writeContainer(const ContainerState& Container)
+{
+    DockingState State;
+    State.Containers.append(Container);
+    return CDockingStateBinaryFormat::write(State);
+}
+
+
+/**
+ * Reads a single container written by writeContainer()
+ */
+static bool readContainer(const QByteArray& Data, ContainerState& Container)
+{
+    DockingState State;
+    if (!CDockingStateBinaryFormat::read(Data, State) || State.Containers.count() != 1)
+    {
+        return false;
+    }
+
+    Container = State.Containers.first();
+    return true;
+}
+
+
+/**
+ * Returns the node at the given Path in the container with the given index
+ * or nullptr, if the state does not contain such a node
+ */
+static DockStateNode* findNode(DockingState& State, int ContainerIndex,
+    const QList<int>& Path)
+{
+    if (ContainerIndex < 0 || ContainerIndex >= State.Containers.count()
+     || !State.Containers[ContainerIndex].HasRootNode)
+    {
+        return nullptr;
+    }
+
+    DockStateNode* Node = &State.Containers[ContainerIndex].RootNode;
+    for (auto ChildIndex : Path)
+    {
+        if (Node->Type != DockStateNode::SplitterNode || ChildIndex < 0
+         || ChildIndex >= int(Node->Children.size()))
+        {
+            return nullptr;
+        }
+        Node = &Node->Children[ChildIndex];
+    }
+    return Node;
+}
+
+
+/**
+ * Applies a single journal record to the given State
+ */
+static bool applyRecord(int Type, const QByteArray& Payload, DockingState& State)
+{
+    QDataStream Stream(Payload);
+    Stream.setVersion(JournalStreamVersion);
+    qint32 Index;
+    Stream >> Index;
+    switch (Type)
+    {
+    case ContainerRecord:
+    {
+        QByteArray Data;
+        Stream >> Data;
+        ContainerState Container;
+        if (!readContainer(Data, Container) || Index < 0
+         || Index > State.Containers.count())
+        {
+            return false;
+        }
+
+        if (Index == State.Containers.count())
+        {
+            State.Containers.append(Container);
+        }
+        else
+        {
+            State.Containers[Index] = Container;
+        }
+        return true;
+    }
+
+    case RemoveContainerRecord:
+        if (Index < 0 || Index >= State.Containers.count())
+        {
+            return false;
+        }
+        State.Containers.removeAt(Index);
+        return true;
+
+    case SplitterSizesRecord:
+    {
+        QList<int> Path;
+        QList<int> Sizes;
+        Stream >> Path >> Sizes;
+        auto Node = findNode(State, Index, Path);
+        if (Stream.status() != QDataStream::Ok || !Node
+         || Node->Type != DockStateNode::SplitterNode
+         || Sizes.count() != int(Node->Children.size()))
+        {
+            return false;
+        }
+        Node->Sizes = Sizes;
+        return true;
+    }
+
+    case DockAreaRecord:
+    {
+        QList<int> Path;
+        QByteArray Data;
+        Stream >> Path >> Data;
+        ContainerState Container;
+        auto Node = findNode(State, Index, Path);
+        if (!Node || Node->Type != DockStateNode::AreaNode
+         || !readContainer(Data, Container) || !Container.HasRootNode
+         || Container.RootNode.Type != DockStateNode::AreaNode)
+        {
+            return false;
+        }
+        *Node = Container.RootNode;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+
+/**
+ * Private data class of CLayoutJournal class (pimpl)
+ */
+struct LayoutJournalPrivate
+{
+    CLayoutJournal* _this;
+    QFile File;
+    QByteArray Pending;
+    qint64 SnapshotSize = 0;
+    qint64 JournalSize = 0;
+
+    /**
+     * Private data constructor
+     */
+    LayoutJournalPrivate(CLayoutJournal* _public);
+
+    /**
+     * Writes a new journal file that only contains the given Snapshot and
+     * opens it for appending
+     */
+    bool create(const QString& FileName, const DockingState& Snapshot);
+};
+// struct LayoutJournalPrivate
+
+//============================================================================
+LayoutJournalPrivate::LayoutJournalPrivate(CLayoutJournal* _public)
+    : _this(_public)
+{
+}
+
+//============================================================================
+bool LayoutJournalPrivate::create(const QString& FileName,
+    const DockingState& Snapshot)
+{
+    // The new file is written completely before it replaces the current
+    // journal, so a crash never leaves a journal without snapshot
+    uchar Header[FileHeaderSize];
+    qToLittleEndian<quint32>(LayoutJournalMagic, Header);
+    qToLittleEndian<quint32>(LayoutJournalVersion, Header + 4);
+    QByteArray Data(reinterpret_cast<const char*>(Header), FileHeaderSize);
+    appendRecord(Data, SnapshotRecord, CDockingStateBinaryFormat::write(Snapshot));
+
+    QSaveFile SaveFile(FileName);
+    if (!SaveFile.open(QIODevice::WriteOnly)
+     || SaveFile.write(Data) != Data.size() || !SaveFile.commit())
+    {
+        return false;
+    }
+
+    File.setFileName(FileName);
+    if (!File.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        return false;
+    }
+
+    SnapshotSize = Data.size();
+    JournalSize = 0;
+    return true;
+}
+
+//============================================================================
+CLayoutJournal::CLayoutJournal()
+    : d(new LayoutJournalPrivate(this))
+{
+}
+
+//============================================================================
+CLayoutJournal::~CLayoutJournal()
+{
+    close();
+    delete d;
+}
+
+//============================================================================
+bool CLayoutJournal::open(const QString& FileName, const DockingState& Snapshot)
+{
+    close();
+    if (!d->create(FileName, Snapshot))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+//============================================================================
+void CLayoutJournal::close()
+{
+    if (isOpen())
+    {
+        flush();
+    }
+    d->File.close();
+    d->Pending.clear();
+    d->SnapshotSize = 0;
+    d->JournalSize = 0;
+}
+
+//============================================================================
+bool CLayoutJournal::isOpen() const
+{
+    return d->File.isOpen();
+}
+
+//============================================================================
+QString CLayoutJournal::fileName() const
+{
+    return d->File.fileName();
+}
+
+//============================================================================
+void CLayoutJournal::appendContainer(int Index, const ContainerState& Container)
+{
+    QByteArray Payload;
+    QDataStream Stream(&Payload, QIODevice::WriteOnly);
+    Stream.setVersion(JournalStreamVersion);
+    Stream << qint32(Index) << writeContainer(Container);
+    appendRecord(d->Pending, ContainerRecord, Payload);
+}
+
+//============================================================================
+void CLayoutJournal::appendRemoveContainer(int Index)
+{
+    QByteArray Payload;
+    QDataStream Stream(&Payload, QIODevice::WriteOnly);
+    Stream.setVersion(JournalStreamVersion);
+    Stream << qint32(Index);
+    appendRecord(d->Pending, RemoveContainerRecord, Payload);
+}
+
+//============================================================================
+void CLayoutJournal::appendSplitterSizes(int ContainerIndex,
+    const QList<int>& Path, const QList<int>& Sizes)
+{
+    QByteArray Payload;
+    QDataStream Stream(&Payload, QIODevice::WriteOnly);
+    Stream.setVersion(JournalStreamVersion);
+    Stream << qint32(ContainerIndex) << Path << Sizes;
+    appendRecord(d->Pending, SplitterSizesRecord, Payload);
+}
+
+//============================================================================
+void CLayoutJournal::appendDockArea(int ContainerIndex, const QList<int>& Path,
+    const DockStateNode& Node)
+{
+    ContainerState Container;
+    Container.HasRootNode = true;
+    Container.RootNode = Node;
+    QByteArray Payload;
+    QDataStream Stream(&Payload, QIODevice::WriteOnly);
+    Stream.setVersion(JournalStreamVersion);
+    Stream << qint32(ContainerIndex) << Path << writeContainer(Container);
+    appendRecord(d->Pending, DockAreaRecord, Payload);
+}
+
+//============================================================================
+bool CLayoutJournal::hasPendingRecords() const
+{
+    return !d->Pending.isEmpty();
+}
+
+//============================================================================
+bool CLayoutJournal::flush()
+{
+    if (d->Pending.isEmpty())
+    {
+        return true;
+    }
+
+    if (!isOpen() || d->File.write(d->Pending) != d->Pending.size()
+     || !d->File.flush())
+    {
+        return false;
+    }
+
+    d->JournalSize += d->Pending.size();
+    d->Pending.clear();
+    return true;
+}
+
+//============================================================================
+bool CLayoutJournal::compact(const DockingState& Snapshot)
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    const QString FileName = fileName();
+    d->Pending.clear();
+    d->File.close();
+    return d->create(FileName, Snapshot);
+}
+
+//============================================================================
+qint64 CLayoutJournal::snapshotSize() const
+{
+    return d->SnapshotSize;
+}
+
+//============================================================================
+qint64 CLayoutJournal::journalSize() const
+{
+    return d->JournalSize;
+}
+
+//============================================================================
+bool CLayoutJournal::replay(const QString& FileName, DockingState& State)
+{
+    QFile File(FileName);
+    if (!File.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    const QByteArray Data = File.readAll();
+    const uchar* FileData = reinterpret_cast<const uchar*>(Data.constData());
+    if (Data.size() < FileHeaderSize
+     || qFromLittleEndian<quint32>(FileData) != LayoutJournalMagic
+     || qFromLittleEndian<quint32>(FileData + 4) > LayoutJournalVersion)
+    {
+        return false;
+    }
+
+    State = DockingState();
+    bool HasSnapshot = false;
+    qint64 Offset = FileHeaderSize;
+    while (Offset + RecordHeaderSize <= Data.size())
+    {
+        const int Type = FileData[Offset];
+        const quint32 Size = qFromLittleEndian<quint32>(FileData + Offset + 1);
+        const quint16 Checksum = qFromLittleEndian<quint16>(FileData + Offset + 5);
+        if (Offset + RecordHeaderSize + Size > Data.size())
+        {
+            break;
+        }
+
+        const QByteArray Payload = Data.mid(int(Offset + RecordHeaderSize), int(Size));
+        if (recordChecksum(Payload) != Checksum)
+        {
+            break;
+        }
+
+        if (!HasSnapshot)
+        {
+            if (Type != SnapshotRecord
+             || !CDockingStateBinaryFormat::read(Payload, State))
+            {
+                return false;
+            }
+            HasSnapshot = true;
+        }
+        else if (!applyRecord(Type, Payload, State))
+        {
+            break;
+        }
+        Offset += RecordHeaderSize + Size;
+    }
+
+    return HasSnapshot;
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF LayoutJournal.cpp
@@ -0,0 +1,143 @@
+#ifndef LayoutJournalH
+#define LayoutJournalH
+//============================================================================
+/// \file   LayoutJournal.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CLayoutJournal
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct LayoutJournalPrivate;
+struct DockingState;
+struct ContainerState;
+struct DockStateNode;
+
+/**
+ * Append only journal of layout mutations.
+ * The journal file starts with a snapshot of the complete docking state.
+ * Each following record describes one mutation of this state: a replaced
+ * or removed dock container, the new sizes of a splitter or the new tabs
+ * of a dock area. Splitters and dock areas are addressed by the index of
+ * their container in DockingState::Containers and by the child indices on
+ * the path from the root node of the container.
+ * Records are collected via the append functions and written to the file
+ * with a single write in flush(). Each record carries a checksum - an
+ * incomplete or corrupted record at the end of the file, i.e. caused by a
+ * crash while writing, ends the replay.
+ * compact() replaces the file with a new snapshot.
+ */
+class ADS_EXPORT CLayoutJournal
+{
+private:
+    Q_DISABLE_COPY(CLayoutJournal)
+    LayoutJournalPrivate* d; ///< private data (pimpl)
+    friend struct LayoutJournalPrivate;
+
+public:
+    /**
+     * Default Constructor
+     */
+    CLayoutJournal();
+
+    /**
+     * Virtual Destructor
+     */
+    virtual ~CLayoutJournal();
+
+    /**
+     * Creates or replaces the journal file with the given name. The file
+     * starts with the given Snapshot. Returns false, if the file can not be
+     * written.
+     */
+    bool open(const QString& FileName, const DockingState& Snapshot);
+
+    /**
+     * Writes pending records and closes the journal file
+     */
+    void close();
+
+    /**
+     * Returns true, if the journal file is open
+     */
+    bool isOpen() const;
+
+    /**
+     * Returns the name of the journal file
+     */
+    QString fileName() const;
+
+    /**
+     * Replaces the container with the given Index. If Index is the number
+     * of containers, the container is appended.
+     */
+    void appendContainer(int Index, const ContainerState& Container);
+
+    /**
+     * Removes the container with the given Index
+     */
+    void appendRemoveContainer(int Index);
+
+    /**
+     * Sets the sizes of the splitter node at the given Path in the
+     * container with the given index
+     */
+    void appendSplitterSizes(int ContainerIndex, const QList<int>& Path,
+        const QList<int>& Sizes);
+
+    /**
+     * Replaces the dock area node at the given Path in the container with
+     * the given index
+     */
+    void appendDockArea(int ContainerIndex, const QList<int>& Path,
+        const DockStateNode& Node);
+
+    /**
+     * Returns true, if there are records that have not been written yet
+     */
+    bool hasPendingRecords() const;
+
+    /**
+     * Writes all pending records to the journal file
+     */
+    bool flush();
+
+    /**
+     * Replaces the journal file with a journal that only contains the
+     * given Snapshot. Pending records are dropped.
+     */
+    bool compact(const DockingState& Snapshot);
+
+    /**
+     * Returns the size of the snapshot at the start of the journal file
+     */
+    qint64 snapshotSize() const;
+
+    /**
+     * Returns the size of the records that follow the snapshot
+     */
+    qint64 journalSize() const;
+
+    /**
+     * Reads the snapshot of the given journal file into State and applies
+     * all complete records. Returns false, if the file does not contain a
+     * valid snapshot. A record that does not match the state ends the
+     * replay like an incomplete record.
+     */
+    static bool replay(const QString& FileName, DockingState& State);
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // LayoutJournalH
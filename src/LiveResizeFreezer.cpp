@@ -0,0 +1,221 @@
+//============================================================================
+/// \file   LiveResizeFreezer.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CLiveResizeFreezer
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "LiveResizeFreezer.h"
+
+#include <QEvent>
+#include <QLayout>
+#include <QPainter>
+#include <QSplitter>
+
+#include "DockInstrumentation.h"
+
+namespace ads
+{
+static quint64 LiveResizeFreezeCount = 0;
+
+
+/**
+ * Returns the widget that hosts the snapshot of the given frozen widget.
+ * Every child widget of a QSplitter becomes a new splitter pane, so the
+ * snapshot of a splitter is placed into the first ancestor that is not a
+ * splitter.
+ */
+static QWidget* snapshotParent(QWidget* Widget)
+{
+    QWidget* Parent = Widget;
+    while (!Parent->isWindow() && qobject_cast<QSplitter*>(Parent))
+    {
+        Parent = Parent->parentWidget();
+    }
+    return Parent;
+}
+
+//============================================================================
+CLiveResizeSnapshot::CLiveResizeSnapshot(const QPixmap& Snapshot,
+                                         QWidget* Parent)
+    : Super(Parent), Snapshot(Snapshot)
+{
+    setObjectName("liveResizeSnapshot");
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+}
+
+//============================================================================
+void CLiveResizeSnapshot::setPieces(
+    const QVector<LiveResizeSnapshotPiece>& Pieces)
+{
+    this->Pieces = Pieces;
+    update();
+}
+
+//============================================================================
+void CLiveResizeSnapshot::paintEvent(QPaintEvent* Event)
+{
+    Q_UNUSED(Event)
+    QPainter Painter(this);
+    if (Pieces.isEmpty())
+    {
+        Painter.drawPixmap(rect(), Snapshot);
+        return;
+    }
+
+    // The source rectangles are given in logical coordinates, but drawPixmap()
+    // expects device pixels of the snapshot
+    Painter.fillRect(rect(), palette().window());
+    const qreal Ratio = Snapshot.devicePixelRatio();
+    for (const auto& Piece : Pieces)
+    {
+        if (Piece.Target.isEmpty())
+        {
+            continue;
+        }
+        QRectF Source(QPointF(Piece.Source.topLeft()) * Ratio,
+                      QSizeF(Piece.Source.size()) * Ratio);
+        Painter.drawPixmap(QRectF(Piece.Target), Snapshot, Source);
+    }
+}
+
+//============================================================================
+CLiveResizeFreezer::CLiveResizeFreezer(QObject* Parent) : Super(Parent)
+{
+    IdleTimer.setSingleShot(true);
+    connect(&IdleTimer, &QTimer::timeout, this, &CLiveResizeFreezer::unfreeze);
+}
+
+//============================================================================
+CLiveResizeFreezer::~CLiveResizeFreezer()
+{
+    // The freezer is usually destroyed together with the frozen widget, so
+    // we must not touch the widget here. The snapshot may be a child of an
+    // ancestor of the frozen widget and would outlive it
+    delete Snapshot;
+}
+
+//============================================================================
+void CLiveResizeFreezer::freeze(QWidget* Widget, bool DisableLayout)
+{
+    if (isFrozen() || !Widget || !Widget->isVisible())
+    {
+        return;
+    }
+
+    ADS_TRACE_SCOPE("CLiveResizeFreezer::freeze");
+    this->Widget = Widget;
+    Snapshot = new CLiveResizeSnapshot(Widget->grab(), snapshotParent(Widget));
+    updateSnapshotGeometry();
+    Snapshot->show();
+    Snapshot->raise();
+    auto Layout = Widget->layout();
+    LayoutDisabled = DisableLayout && Layout;
+    if (LayoutDisabled)
+    {
+        Layout->setEnabled(false);
+    }
+    Widget->installEventFilter(this);
+    ++LiveResizeFreezeCount;
+}
+
+//============================================================================
+void CLiveResizeFreezer::unfreeze()
+{
+    IdleTimer.stop();
+    delete Snapshot;
+
+    if (Widget)
+    {
+        ADS_TRACE_SCOPE("CLiveResizeFreezer::unfreeze");
+        Widget->removeEventFilter(this);
+        auto Layout = Widget->layout();
+        if (LayoutDisabled && Layout)
+        {
+            // The disabled layout ignored all resize events, so we need to
+            // invalidate it to force the single real relayout
+            Layout->setEnabled(true);
+            Layout->invalidate();
+            Layout->activate();
+        }
+    }
+
+    Widget = nullptr;
+    LayoutDisabled = false;
+}
+
+//============================================================================
+bool CLiveResizeFreezer::isFrozen() const
+{
+    return !Widget.isNull();
+}
+
+//============================================================================
+QWidget* CLiveResizeFreezer::frozenWidget() const
+{
+    return Widget;
+}
+
+//============================================================================
+void CLiveResizeFreezer::setPieces(
+    const QVector<LiveResizeSnapshotPiece>& Pieces)
+{
+    if (Snapshot)
+    {
+        Snapshot->setPieces(Pieces);
+    }
+}
+
+//============================================================================
+void CLiveResizeFreezer::liveResize(QWidget* Widget, int IdleMsec)
+{
+    if (!isFrozen() && LastResize.isValid() && LastResize.elapsed() < IdleMsec)
+    {
+        freeze(Widget);
+    }
+    if (isFrozen())
+    {
+        IdleTimer.start(IdleMsec);
+    }
+    LastResize.start();
+}
+
+//============================================================================
+quint64 CLiveResizeFreezer::freezeCount()
+{
+    return LiveResizeFreezeCount;
+}
+
+//============================================================================
+void CLiveResizeFreezer::updateSnapshotGeometry()
+{
+    if (!Snapshot || !Widget)
+    {
+        return;
+    }
+
+    auto Parent = Snapshot->parentWidget();
+    QPoint Pos = (Parent == Widget) ? QPoint(0, 0) : Widget->mapTo(Parent, QPoint(0, 0));
+    Snapshot->setGeometry(QRect(Pos, Widget->size()));
+}
+
+//============================================================================
+bool CLiveResizeFreezer::eventFilter(QObject* Watched, QEvent* Event)
+{
+    if (Watched == Widget
+     && (Event->type() == QEvent::Resize || Event->type() == QEvent::Move))
+    {
+        updateSnapshotGeometry();
+    }
+    return Super::eventFilter(Watched, Event);
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF LiveResizeFreezer.cpp
@@ -0,0 +1,148 @@
+#ifndef LiveResizeFreezerH
+#define LiveResizeFreezerH
+//============================================================================
+/// \file   LiveResizeFreezer.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CLiveResizeFreezer
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPixmap>
+#include <QPointer>
+#include <QRect>
+#include <QTimer>
+#include <QVector>
+#include <QWidget>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+/**
+ * A part of the frozen snapshot that is painted stretched into a target
+ * rectangle. Source and Target are in the coordinates of the frozen widget.
+ */
+struct LiveResizeSnapshotPiece
+{
+    QRect Source;
+    QRect Target;
+};
+
+/**
+ * Widget that covers a frozen widget and paints the stretched snapshot
+ * of its content
+ */
+class CLiveResizeSnapshot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    using Super = QWidget;
+
+    CLiveResizeSnapshot(const QPixmap& Snapshot, QWidget* Parent);
+
+    /**
+     * Sets the pieces of the snapshot. If the list is empty, the whole
+     * snapshot is stretched to the size of this widget
+     */
+    void setPieces(const QVector<LiveResizeSnapshotPiece>& Pieces);
+
+protected:
+    virtual void paintEvent(QPaintEvent* Event) override;
+
+private:
+    QPixmap Snapshot;
+    QVector<LiveResizeSnapshotPiece> Pieces;
+};
+
+/**
+ * Freezes the content of a widget during an interactive live resize.
+ * While a widget is frozen, its layout is disabled and a snapshot of its
+ * content covers it. The snapshot of a splitter is not a child of the
+ * splitter but of its first ancestor that is not a splitter, because
+ * QSplitter turns each child widget into a pane. Resizing the frozen widget
+ * then only stretches the snapshot instead of relayouting all nested
+ * splitters and content widgets.
+ * Unfreezing removes the snapshot and activates the layout again, so the
+ * content is relayouted exactly once.
+ * This is used by CDockSplitter, CResizeHandle and CFloatingDockContainer
+ * if the FrozenLiveResize performance flag is set.
+ */
+class CLiveResizeFreezer : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Super = QObject;
+
+    CLiveResizeFreezer(QObject* Parent = nullptr);
+    virtual ~CLiveResizeFreezer();
+
+    /**
+     * Freezes the given widget. If DisableLayout is true, the layout of the
+     * widget is disabled until unfreeze() is called. Does nothing, if the
+     * widget is already frozen
+     */
+    void freeze(QWidget* Widget, bool DisableLayout = true);
+
+    /**
+     * Removes the snapshot and relayouts the frozen widget
+     */
+    void unfreeze();
+
+    /**
+     * Returns true, if a widget is frozen
+     */
+    bool isFrozen() const;
+
+    /**
+     * Returns the frozen widget or nullptr
+     */
+    QWidget* frozenWidget() const;
+
+    /**
+     * Sets the pieces of the snapshot that are painted
+     * \see CLiveResizeSnapshot::setPieces()
+     */
+    void setPieces(const QVector<LiveResizeSnapshotPiece>& Pieces);
+
+    /**
+     * Handles a resize of a widget that is resized by the window system.
+     * The first resize does not freeze the widget, so a single resize, like
+     * maximizing a window, is applied immediately. If more resizes follow
+     * within IdleMsec, the widget is frozen until no resize arrived for
+     * IdleMsec.
+     */
+    void liveResize(QWidget* Widget, int IdleMsec = 150);
+
+    /**
+     * Returns the number of freeze operations since program start.
+     * Each freeze ends with exactly one real relayout.
+     */
+    static quint64 freezeCount();
+
+protected:
+    virtual bool eventFilter(QObject* Watched, QEvent* Event) override;
+
+private:
+    /**
+     * Places the snapshot over the frozen widget
+     */
+    void updateSnapshotGeometry();
+
+    QPointer<QWidget> Widget;
+    QPointer<CLiveResizeSnapshot> Snapshot;
+    bool LayoutDisabled = false;
+    QTimer IdleTimer;
+    QElapsedTimer LastResize;
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // LiveResizeFreezerH
@@ -0,0 +1,477 @@
+//============================================================================
+/// \file   PerspectiveStore.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CPerspectiveStore
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "PerspectiveStore.h"
+
+#include <QFile>
+#include <QLockFile>
+#include <QMap>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <memory>
+
+namespace ads
+{
+static const quint32 PerspectiveStoreMagic = 0x41445350; // "ADSP"
+static const quint32 PerspectiveStoreVersion = 1;
+static const qint64 FileHeaderSize = 8;
+static const qint64 RecordHeaderSize = 9;
+static const qint64 MinCompactionSize = 64 * 1024;
+
+enum eRecordType
+{
+    WriteRecord = 1,
+    RemoveRecord = 2
+};
+
+/**
+ * Position of the record of a perspective in the store file
+ */
+struct PerspectiveStoreEntry
+{
+    qint64 Offset = 0;
+    qint64 RecordSize = 0;
+    qint64 DataOffset = 0;
+    quint32 DataSize = 0;
+};
+
+/**
+ * Private data class of CPerspectiveStore class (pimpl)
+ */
+struct PerspectiveStorePrivate
+{
+    CPerspectiveStore* _this;
+    QFile File;
+    std::unique_ptr<QLockFile> Lock;
+    uchar* Map = nullptr;
+    qint64 MapSize = 0;
+    qint64 ValidSize = 0;
+    qint64 UnusedSize = 0;
+    QMap<QString, PerspectiveStoreEntry> Index;
+
+    /**
+     * Private data constructor
+     */
+    PerspectiveStorePrivate(CPerspectiveStore* _public);
+
+    /**
+     * Maps the valid part of the file into memory, if it is not mapped yet
+     */
+    void map();
+
+    /**
+     * Removes the memory mapping. This is required before the file size
+     * changes
+     */
+    void unmap();
+
+    /**
+     * Reads Size bytes at the given Offset from the mapped file. If the file
+     * can not be mapped, the data is read from the file
+     */
+    QByteArray readAt(qint64 Offset, qint64 Size);
+
+    /**
+     * Reads the file header and the headers of all records and builds the
+     * index of the perspectives
+     */
+    bool scan();
+
+    /**
+     * Appends a record to the file. Returns the position of the appended
+     * record in Entry.
+     */
+    bool appendRecord(eRecordType Type, const QString& Name,
+        const QByteArray& Data, PerspectiveStoreEntry& Entry);
+
+    /**
+     * Compacts the file, if more than half of the file is unused
+     */
+    void compactIfRequired();
+};
+// struct PerspectiveStorePrivate
+
+//============================================================================
+PerspectiveStorePrivate::PerspectiveStorePrivate(CPerspectiveStore* _public)
+    : _this(_public)
+{
+}
+
+//============================================================================
+void PerspectiveStorePrivate::map()
+{
+    if (Map || ValidSize <= 0)
+    {
+        return;
+    }
+
+    Map = File.map(0, ValidSize);
+    MapSize = Map ? ValidSize : 0;
+}
+
+//============================================================================
+void PerspectiveStorePrivate::unmap()
+{
+    if (Map)
+    {
+        File.unmap(Map);
+    }
+    Map = nullptr;
+    MapSize = 0;
+}
+
+//============================================================================
+QByteArray PerspectiveStorePrivate::readAt(qint64 Offset, qint64 Size)
+{
+    map();
+    if (Map && (Offset + Size) <= MapSize)
+    {
+        return QByteArray(reinterpret_cast<const char*>(Map + Offset), int(Size));
+    }
+
+    if (!File.seek(Offset))
+    {
+        return QByteArray();
+    }
+    return File.read(Size);
+}
+
+//============================================================================
+bool PerspectiveStorePrivate::scan()
+{
+    Index.clear();
+    UnusedSize = 0;
+    const qint64 FileSize = File.size();
+    if (FileSize == 0)
+    {
+        uchar Header[FileHeaderSize];
+        qToLittleEndian<quint32>(PerspectiveStoreMagic, Header);
+        qToLittleEndian<quint32>(PerspectiveStoreVersion, Header + 4);
+        if (File.write(reinterpret_cast<const char*>(Header), FileHeaderSize)
+            != FileHeaderSize)
+        {
+            return false;
+        }
+        File.flush();
+        ValidSize = FileHeaderSize;
+        return true;
+    }
+
+    // Map the complete file - only the pages with the record headers are
+    // read while scanning
+    ValidSize = FileSize;
+    QByteArray Header = readAt(0, FileHeaderSize);
+    if (Header.size() != FileHeaderSize)
+    {
+        return false;
+    }
+
+    const uchar* HeaderData = reinterpret_cast<const uchar*>(Header.constData());
+    if (qFromLittleEndian<quint32>(HeaderData) != PerspectiveStoreMagic
+     || qFromLittleEndian<quint32>(HeaderData + 4) > PerspectiveStoreVersion)
+    {
+        return false;
+    }
+
+    qint64 Offset = FileHeaderSize;
+    while (Offset + RecordHeaderSize <= FileSize)
+    {
+        QByteArray RecordHeader = readAt(Offset, RecordHeaderSize);
+        const uchar* RecordData = reinterpret_cast<const uchar*>(RecordHeader.constData());
+        const int Type = RecordData[0];
+        const quint32 NameSize = qFromLittleEndian<quint32>(RecordData + 1);
+        const quint32 DataSize = qFromLittleEndian<quint32>(RecordData + 5);
+        const qint64 RecordSize = RecordHeaderSize + NameSize + DataSize;
+        // An incomplete or unknown record marks the end of the valid data
+        if ((Type != WriteRecord && Type != RemoveRecord)
+         || (Offset + RecordSize) > FileSize)
+        {
+            break;
+        }
+
+        QString Name = QString::fromUtf8(readAt(Offset + RecordHeaderSize, NameSize));
+        auto it = Index.find(Name);
+        if (it != Index.end())
+        {
+            UnusedSize += it->RecordSize;
+            Index.erase(it);
+        }
+
+        if (Type == WriteRecord)
+        {
+            PerspectiveStoreEntry Entry;
+            Entry.Offset = Offset;
+            Entry.RecordSize = RecordSize;
+            Entry.DataOffset = Offset + RecordHeaderSize + NameSize;
+            Entry.DataSize = DataSize;
+            Index.insert(Name, Entry);
+        }
+        else
+        {
+            UnusedSize += RecordSize;
+        }
+        Offset += RecordSize;
+    }
+
+    ValidSize = Offset;
+    return true;
+}
+
+//============================================================================
+bool PerspectiveStorePrivate::appendRecord(eRecordType Type,
+    const QString& Name, const QByteArray& Data, PerspectiveStoreEntry& Entry)
+{
+    // The mapping must not be active while the file size changes
+    unmap();
+    if (File.size() != ValidSize && !File.resize(ValidSize))
+    {
+        return false;
+    }
+
+    const QByteArray NameData = Name.toUtf8();
+    uchar Header[RecordHeaderSize];
+    Header[0] = uchar(Type);
+    qToLittleEndian<quint32>(quint32(NameData.size()), Header + 1);
+    qToLittleEndian<quint32>(quint32(Data.size()), Header + 5);
+    bool Ok = File.seek(ValidSize)
+        && File.write(reinterpret_cast<const char*>(Header), RecordHeaderSize) == RecordHeaderSize
+        && File.write(NameData) == NameData.size()
+        && File.write(Data) == Data.size()
+        && File.flush();
+    if (!Ok)
+    {
+        File.resize(ValidSize);
+        return false;
+    }
+
+    Entry.Offset = ValidSize;
+    Entry.RecordSize = RecordHeaderSize + NameData.size() + Data.size();
+    Entry.DataOffset = ValidSize + RecordHeaderSize + NameData.size();
+    Entry.DataSize = quint32(Data.size());
+    ValidSize += Entry.RecordSize;
+    return true;
+}
+
+//============================================================================
+void PerspectiveStorePrivate::compactIfRequired()
+{
+    if (UnusedSize >= MinCompactionSize && UnusedSize * 2 > ValidSize)
+    {
+        _this->compact();
+    }
+}
+
+//============================================================================
+CPerspectiveStore::CPerspectiveStore()
+    : d(new PerspectiveStorePrivate(this))
+{
+}
+
+//============================================================================
+CPerspectiveStore::~CPerspectiveStore()
+{
+    close();
+    delete d;
+}
+
+//============================================================================
+bool CPerspectiveStore::open(const QString& FileName)
+{
+    close();
+    // The index of the open store is only valid as long as no other store
+    // appends to the file
+    d->Lock.reset(new QLockFile(FileName + ".lock"));
+    if (!d->Lock->tryLock())
+    {
+        d->Lock.reset();
+        return false;
+    }
+
+    d->File.setFileName(FileName);
+    if (!d->File.open(QIODevice::ReadWrite))
+    {
+        return false;
+    }
+
+    if (!d->scan())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+//============================================================================
+void CPerspectiveStore::close()
+{
+    d->unmap();
+    d->File.close();
+    d->Lock.reset();
+    d->Index.clear();
+    d->ValidSize = 0;
+    d->UnusedSize = 0;
+}
+
+//============================================================================
+bool CPerspectiveStore::isOpen() const
+{
+    return d->File.isOpen();
+}
+
+//============================================================================
+QString CPerspectiveStore::fileName() const
+{
+    return d->File.fileName();
+}
+
+//============================================================================
+QStringList CPerspectiveStore::names() const
+{
+    return d->Index.keys();
+}
+
+//============================================================================
+bool CPerspectiveStore::contains(const QString& Name) const
+{
+    return d->Index.contains(Name);
+}
+
+//============================================================================
+QByteArray CPerspectiveStore::read(const QString& Name) const
+{
+    auto it = d->Index.constFind(Name);
+    if (it == d->Index.constEnd())
+    {
+        return QByteArray();
+    }
+
+    return d->readAt(it->DataOffset, it->DataSize);
+}
+
+//============================================================================
+bool CPerspectiveStore::write(const QString& Name, const QByteArray& Data)
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    auto it = d->Index.constFind(Name);
+    if (it != d->Index.constEnd() && int(it->DataSize) == Data.size()
+     && d->readAt(it->DataOffset, it->DataSize) == Data)
+    {
+        return true;
+    }
+
+    PerspectiveStoreEntry Entry;
+    if (!d->appendRecord(WriteRecord, Name, Data, Entry))
+    {
+        return false;
+    }
+
+    if (it != d->Index.constEnd())
+    {
+        d->UnusedSize += it->RecordSize;
+    }
+    d->Index.insert(Name, Entry);
+    d->compactIfRequired();
+    return true;
+}
+
+//============================================================================
+bool CPerspectiveStore::remove(const QString& Name)
+{
+    auto it = d->Index.find(Name);
+    if (it == d->Index.end())
+    {
+        return false;
+    }
+
+    PerspectiveStoreEntry Entry;
+    if (!d->appendRecord(RemoveRecord, Name, QByteArray(), Entry))
+    {
+        return false;
+    }
+
+    d->UnusedSize += it->RecordSize + Entry.RecordSize;
+    d->Index.erase(it);
+    d->compactIfRequired();
+    return true;
+}
+
+//============================================================================
+bool CPerspectiveStore::compact()
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    // The compacted file is written completely before it replaces the
+    // current file, so a crash never leaves a partially compacted file
+    QSaveFile CompactedFile(fileName());
+    if (!CompactedFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    uchar Header[FileHeaderSize];
+    qToLittleEndian<quint32>(PerspectiveStoreMagic, Header);
+    qToLittleEndian<quint32>(PerspectiveStoreVersion, Header + 4);
+    bool Ok = CompactedFile.write(reinterpret_cast<const char*>(Header),
+        FileHeaderSize) == FileHeaderSize;
+    for (auto it = d->Index.constBegin(); Ok && it != d->Index.constEnd(); ++it)
+    {
+        const QByteArray Record = d->readAt(it->Offset, it->RecordSize);
+        Ok = (Record.size() == it->RecordSize)
+            && (CompactedFile.write(Record) == Record.size());
+    }
+
+    // The current file stays untouched, if the compacted file could not be
+    // written completely
+    if (!Ok)
+    {
+        CompactedFile.cancelWriting();
+        return false;
+    }
+
+    // The current file needs to be closed before it can be replaced on
+    // all platforms. If replacing the file fails, the current file is
+    // still valid, so the file is opened again in both cases
+    d->unmap();
+    d->File.close();
+    const bool Committed = CompactedFile.commit();
+    if (!d->File.open(QIODevice::ReadWrite) || !d->scan())
+    {
+        close();
+        return false;
+    }
+
+    return Committed;
+}
+
+//============================================================================
+qint64 CPerspectiveStore::fileSize() const
+{
+    return d->ValidSize;
+}
+
+//============================================================================
+qint64 CPerspectiveStore::unusedSize() const
+{
+    return d->UnusedSize;
+}
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF PerspectiveStore.cpp
@@ -0,0 +1,130 @@
+#ifndef PerspectiveStoreH
+#define PerspectiveStoreH
+//============================================================================
+/// \file   PerspectiveStore.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CPerspectiveStore
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct PerspectiveStorePrivate;
+
+/**
+ * File based storage for perspectives.
+ * The file is an append only log of records. Each record either stores the
+ * data of one perspective or marks a perspective as removed. Opening the
+ * store only reads the small record headers to build an index of the
+ * perspectives - the perspective data is read from the memory mapped file
+ * when it is requested via read().
+ * Adding, changing or removing a perspective appends a single record, so
+ * the file is never rewritten completely. Records that have been replaced
+ * or removed are dropped by compact(), which is called automatically if
+ * more than half of the file is unused.
+ * An incomplete record at the end of the file, i.e. caused by a crash while
+ * writing, is ignored and overwritten by the next write.
+ * The index is built only once when the file is opened, so a store file
+ * must not be modified by anybody else while it is open. open() locks the
+ * file via a QLockFile with the suffix ".lock" - a file can only be opened
+ * by one store at a time, in the same or in another process.
+ */
+class ADS_EXPORT CPerspectiveStore
+{
+private:
+    Q_DISABLE_COPY(CPerspectiveStore)
+    PerspectiveStorePrivate* d; ///< private data (pimpl)
+    friend struct PerspectiveStorePrivate;
+
+public:
+    /**
+     * Default Constructor
+     */
+    CPerspectiveStore();
+
+    /**
+     * Virtual Destructor
+     */
+    virtual ~CPerspectiveStore();
+
+    /**
+     * Opens the store file with the given name. The file is created, if it
+     * does not exist. Returns false, if the file can not be opened, if it
+     * is not a perspective store file or if it is locked by another store.
+     */
+    bool open(const QString& FileName);
+
+    /**
+     * Closes the store file and releases its lock
+     */
+    void close();
+
+    /**
+     * Returns true, if the store file is open
+     */
+    bool isOpen() const;
+
+    /**
+     * Returns the name of the store file
+     */
+    QString fileName() const;
+
+    /**
+     * Returns the names of all perspectives in the store
+     */
+    QStringList names() const;
+
+    /**
+     * Returns true, if the store contains a perspective with the given name
+     */
+    bool contains(const QString& Name) const;
+
+    /**
+     * Reads the data of the perspective with the given name.
+     * Returns an empty byte array, if the perspective does not exist.
+     */
+    QByteArray read(const QString& Name) const;
+
+    /**
+     * Stores the data of the perspective with the given name.
+     * If the store already contains the same data for the perspective,
+     * nothing is written.
+     */
+    bool write(const QString& Name, const QByteArray& Data);
+
+    /**
+     * Removes the perspective with the given name from the store
+     */
+    bool remove(const QString& Name);
+
+    /**
+     * Rewrites the store file with the records of the current perspectives
+     * only
+     */
+    bool compact();
+
+    /**
+     * Returns the size of the store file in bytes
+     */
+    qint64 fileSize() const;
+
+    /**
+     * Returns the number of bytes in the store file that are used by
+     * replaced or removed perspective records
+     */
+    qint64 unusedSize() const;
+};
+
+}  // namespace ads
+
+//---------------------------------------------------------------------------
+#endif  // PerspectiveStoreH
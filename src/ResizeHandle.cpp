@@ -20,6 +20,7 @@
 
 #include "AutoHideDockContainer.h"
 #include "DockContainerWidget.h"
+#include "LiveResizeFreezer.h"
 #include "ads_globals.h"
 
 namespace ads
@@ -40,6 +41,8 @@ struct ResizeHandlePrivate
     bool OpaqueResize = false;
     int HandleWidth = 6;
     bool HasOverrideCursor = false;
+    bool FreezeContent = false;
+    CLiveResizeFreezer* Freezer = nullptr;
 
     /**
      * Private data constructor
@@ -71,6 +74,18 @@ struct ResizeHandlePrivate
     QRect doResizing(QMouseEvent* e, bool ForceResize = false);
 
 	QRect newGeometry(QMouseEvent* e, int& outRubberBandPos);
+
+    /**
+     * Freezes the content of the target widget for the current resize
+     * operation
+     */
+    void freezeTarget();
+
+    /**
+     * The layout of a frozen target is disabled, so the handle needs to be
+     * moved to the resized edge of the target manually
+     */
+    void moveToTargetEdge();
 };
 // struct ResizeHandlePrivate
 
@@ -119,7 +134,15 @@ QRect ResizeHandlePrivate::doResizing(QMouseEvent* e, bool ForceResize)
     }
     if (_this->opaqueResize() || ForceResize)
     {
+        if (FreezeContent && !ForceResize)
+        {
+            freezeTarget();
+        }
         Target->setGeometry(NewGeometry);
+        if (Freezer && Freezer->isFrozen())
+        {
+            moveToTargetEdge();
+        }
     }
     else
     {
@@ -128,6 +151,38 @@ QRect ResizeHandlePrivate::doResizing(QMouseEvent* e, bool ForceResize)
     return RetGeometry;
 }
 
+//============================================================================
+void ResizeHandlePrivate::freezeTarget()
+{
+    if (!Freezer)
+    {
+        Freezer = new CLiveResizeFreezer(_this);
+    }
+    if (!Freezer->isFrozen())
+    {
+        Freezer->freeze(Target);
+        _this->raise();
+    }
+}
+
+//============================================================================
+void ResizeHandlePrivate::moveToTargetEdge()
+{
+    switch (HandlePosition)
+    {
+    case Qt::RightEdge:
+        _this->move(Target->width() - _this->width(), _this->y());
+        break;
+
+    case Qt::BottomEdge:
+        _this->move(_this->x(), Target->height() - _this->height());
+        break;
+
+    default: break;
+    }
+}
+
+//============================================================================
 QRect ResizeHandlePrivate::newGeometry(QMouseEvent* e, int& outRubberBandPos)
 {
     int pos = pick(e->pos()) - MouseOffset;
@@ -193,7 +248,6 @@ CResizeHandle::CResizeHandle(Qt::Edge HandlePosition, QWidget* parent)
     d->Target = parent;
     setMinResizeSize(48);
     setHandlePosition(HandlePosition);
-    qApp->installEventFilter(this);
 }
 
 //============================================================================
@@ -246,6 +300,10 @@ void CResizeHandle::mouseReleaseEvent(QMouseEvent* e)
             d->HasOverrideCursor = false;
         }
     }
+    if (d->Freezer && e->button() == Qt::LeftButton)
+    {
+        d->Freezer->unfreeze();
+    }
     if (!opaqueResize() && e->button() == Qt::LeftButton)
     {
         if (d->RubberBand)
@@ -386,6 +444,18 @@ bool CResizeHandle::opaqueResize() const
 {
     return d->OpaqueResize;
 }
+
+//============================================================================
+void CResizeHandle::setFreezeContent(bool Freeze)
+{
+    d->FreezeContent = Freeze;
+}
+
+//============================================================================
+bool CResizeHandle::freezeContent() const
+{
+    return d->FreezeContent;
+}
 }  // namespace ads
 
 //---------------------------------------------------------------------------
@@ -34,6 +34,12 @@ protected:
     void mouseMoveEvent(QMouseEvent*) override;
     void mousePressEvent(QMouseEvent*) override;
     void mouseReleaseEvent(QMouseEvent*) override;
+
+    /**
+     * Updates the override cursor for application wide mouse moves.
+     * The auto hide container forwards the mouse moves via the input
+     * dispatcher of the dock manager while it is visible.
+     */
     bool eventFilter(QObject* receiver, QEvent* event) override;
 
 public:
@@ -98,6 +104,20 @@ public:
      * interactively moving the resize handle. Otherwise returns false.
      */
     bool opaqueResize() const;
+
+    /**
+     * Enable / disable freezing of the target content during opaque
+     * resizing. If enabled, the target only shows a stretched snapshot of
+     * its content while the handle is dragged and relayouts its content once,
+     * when the handle is released.
+     * \see CDockManager::FrozenLiveResize
+     */
+    void setFreezeContent(bool Freeze = true);
+
+    /**
+     * Returns true, if the target content is frozen during opaque resizing
+     */
+    bool freezeContent() const;
 };  // class name
 }  // namespace ads
 //-----------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include <QStyle>
 #include <QVariant>
 
+#include "DockInstrumentation.h"
 #include "DockManager.h"
 #include "DockSplitter.h"
 #include "IconProvider.h"
@@ -439,6 +440,7 @@ void repolishStyle(QWidget* w, eRepolishChildOptions Options)
     {
         return;
     }
+    ADS_TRACE_SCOPE("repolishStyle");
     w->style()->unpolish(w);
     w->style()->polish(w);
 
@@ -37,7 +37,10 @@ HEADERS += \
     DockManager.h \
     DockWidget.h \
     DockWidgetTab.h \ 
+    DockingStateBinaryFormat.h \
     DockingStateReader.h \
+    DockingStateWriter.h \
+    DockLayoutPlan.h \
     FloatingDockContainer.h \
     FloatingDragPreview.h \
     DockOverlay.h \
@@ -47,11 +50,18 @@ HEADERS += \
     ElidingLabel.h \
     IconProvider.h \
     DockComponentsFactory.h  \
+    DropOverlayUpdateScheduler.h \
+    DockInputDispatcher.h \
+    DockInstrumentation.h \
+    LiveResizeFreezer.h \
     DockFocusController.h \
     AutoHideDockContainer.h \
     AutoHideSideBar.h \
     AutoHideTab.h \
     PushButton.h \
+    PerspectiveStore.h \
+    DockStatePool.h \
+    LayoutJournal.h \
     ResizeHandle.h
 
 
@@ -62,7 +72,10 @@ SOURCES += \
     DockContainerWidget.cpp \
     DockManager.cpp \
     DockWidget.cpp \
+    DockingStateBinaryFormat.cpp \
     DockingStateReader.cpp \
+    DockingStateWriter.cpp \
+    DockLayoutPlan.cpp \
     DockWidgetTab.cpp \
     FloatingDockContainer.cpp \
     FloatingDragPreview.cpp \
@@ -72,11 +85,18 @@ SOURCES += \
     ElidingLabel.cpp \
     IconProvider.cpp \
     DockComponentsFactory.cpp \
+    DropOverlayUpdateScheduler.cpp \
+    DockInputDispatcher.cpp \
+    DockInstrumentation.cpp \
+    LiveResizeFreezer.cpp \
     DockFocusController.cpp \
     AutoHideDockContainer.cpp \
     AutoHideSideBar.cpp \
     AutoHideTab.cpp \
     PushButton.cpp \
+    PerspectiveStore.cpp \
+    DockStatePool.cpp \
+    LayoutJournal.cpp \
     ResizeHandle.cpp
 
 
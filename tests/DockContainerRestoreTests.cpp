@@ -0,0 +1,291 @@
+//============================================================================
+/// \file   DockContainerRestoreTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockContainerRestoreTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockContainerRestoreTests.h"
+
+#include <QLabel>
+#include <QLayout>
+#include <QMainWindow>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockAreaWidget.h"
+#include "DockManager.h"
+#include "DockSplitter.h"
+#include "DockWidget.h"
+#include "DockingStateBinaryFormat.h"
+#include "DockingStateReader.h"
+
+using namespace ads;
+
+namespace
+{
+/**
+ * Main window with a dock manager and the dock widgets A, B, C and D in a
+ * single dock area
+ */
+struct RestoreWindow
+{
+    std::unique_ptr<QMainWindow> MainWindow;
+    CDockManager* DockManager = nullptr;
+
+    RestoreWindow() : MainWindow(new QMainWindow())
+    {
+        DockManager = new CDockManager(MainWindow.get());
+        CDockAreaWidget* DockArea = nullptr;
+        for (auto Name : {"A", "B", "C", "D"})
+        {
+            auto DockWidget = new CDockWidget(Name);
+            DockWidget->setWidget(new QLabel(Name));
+            if (DockArea)
+            {
+                DockManager->addDockWidgetTabToArea(DockWidget, DockArea);
+            }
+            else
+            {
+                DockArea = DockManager->addDockWidget(LeftDockWidgetArea,
+                    DockWidget);
+            }
+        }
+        MainWindow->resize(1000, 800);
+        MainWindow->show();
+    }
+
+    /**
+     * Returns the only root splitter of the dock manager. Old root
+     * splitters must have been deleted after a restore.
+     */
+    CDockSplitter* rootSplitter() const
+    {
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        const auto Splitters = DockManager->findChildren<CDockSplitter*>(
+            QString(), Qt::FindDirectChildrenOnly);
+        return (Splitters.count() == 1) ? Splitters.first() : nullptr;
+    }
+};
+
+//============================================================================
+/**
+ * Returns a dock area node with the given dock widgets
+ */
+DockStateNode area(const QStringList& Names)
+{
+    DockStateNode Node;
+    Node.Type = DockStateNode::AreaNode;
+    for (const auto& Name : Names)
+    {
+        DockWidgetState WidgetState;
+        WidgetState.Name = Name;
+        Node.DockWidgets.append(WidgetState);
+    }
+    Node.CurrentDockWidget = Names.first();
+    return Node;
+}
+
+//============================================================================
+/**
+ * Returns a splitter node with the given children and equal sizes
+ */
+DockStateNode splitter(Qt::Orientation Orientation,
+    const std::vector<DockStateNode>& Children)
+{
+    DockStateNode Node;
+    Node.Type = DockStateNode::SplitterNode;
+    Node.Orientation = Orientation;
+    Node.Children = Children;
+    for (size_t i = 0; i < Children.size(); ++i)
+    {
+        Node.Sizes.append(100);
+    }
+    return Node;
+}
+
+//============================================================================
+/**
+ * Returns a binary state with the given root node of the main container.
+ * Dock widgets in FloatingNames are placed into a floating container.
+ */
+QByteArray state(const DockStateNode& RootNode,
+    const QStringList& FloatingNames = QStringList())
+{
+    DockingState State;
+    State.Version = 1;
+    State.HasUserVersion = true;
+    ContainerState Main;
+    Main.HasRootNode = true;
+    Main.RootNode = RootNode;
+    State.Containers.append(Main);
+    if (!FloatingNames.isEmpty())
+    {
+        QWidget Window;
+        ContainerState Floating;
+        Floating.Floating = true;
+        Floating.Geometry = Window.saveGeometry();
+        Floating.HasRootNode = true;
+        Floating.RootNode = splitter(Qt::Horizontal, {area(FloatingNames)});
+        State.Containers.append(Floating);
+    }
+    return CDockingStateBinaryFormat::write(State);
+}
+
+//============================================================================
+/**
+ * Describes the splitter tree below Widget, i.e. "H[V[A,B],C+D]" for a
+ * horizontal splitter with a vertical splitter and a dock area with the
+ * tabs C and D
+ */
+QString layoutShape(QWidget* Widget)
+{
+    auto DockArea = qobject_cast<CDockAreaWidget*>(Widget);
+    if (DockArea)
+    {
+        QStringList Names;
+        for (auto DockWidget : DockArea->dockWidgets())
+        {
+            Names.append(DockWidget->objectName());
+        }
+        return Names.join('+');
+    }
+
+    auto Splitter = qobject_cast<QSplitter*>(Widget);
+    if (!Splitter)
+    {
+        return QString("?");
+    }
+
+    QStringList Children;
+    for (int i = 0; i < Splitter->count(); ++i)
+    {
+        Children.append(layoutShape(Splitter->widget(i)));
+    }
+    return QString(Splitter->orientation() == Qt::Horizontal ? "H[" : "V[")
+        + Children.join(',') + "]";
+}
+
+//============================================================================
+/**
+ * Checks that the root splitter is installed in the layout of the dock
+ * manager, that it has the given shape and that there are no leftover
+ * splitters
+ */
+bool verifyLayout(const RestoreWindow& Window, const QString& Shape)
+{
+    auto RootSplitter = Window.rootSplitter();
+    if (!RootSplitter || Window.DockManager->layout()->indexOf(RootSplitter) < 0
+     || !RootSplitter->isVisible())
+    {
+        return false;
+    }
+
+    const QString RootShape = layoutShape(RootSplitter);
+    if (RootShape != Shape)
+    {
+        qWarning() << "Layout" << RootShape << "expected" << Shape;
+        return false;
+    }
+    return Window.DockManager->findChildren<QSplitter*>().count() == Shape.count('[');
+}
+}  // namespace
+
+//============================================================================
+void CDockContainerRestoreTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+//============================================================================
+void CDockContainerRestoreTests::reuseNestedSplitter()
+{
+    // The area with C and D is emptied while the state is restored. This
+    // must not collapse the old root splitter, because the nested splitter
+    // is reused
+    RestoreWindow Window;
+    const QByteArray Start = state(splitter(Qt::Horizontal, {
+        splitter(Qt::Vertical, {area({"A"}), area({"B"})}), area({"C", "D"})}));
+    QVERIFY(Window.DockManager->restoreState(Start));
+    QVERIFY(verifyLayout(Window, "H[V[A,B],C+D]"));
+    auto NestedSplitter = Window.rootSplitter()->widget(0);
+
+    QVERIFY(Window.DockManager->restoreState(state(splitter(Qt::Horizontal, {
+        splitter(Qt::Vertical, {area({"A"}), area({"B"})}), area({"C"}),
+        area({"D"})}))));
+    QVERIFY(verifyLayout(Window, "H[V[A,B],C,D]"));
+    QCOMPARE(Window.rootSplitter()->widget(0), NestedSplitter);
+
+    QVERIFY(Window.DockManager->restoreState(Start));
+    QVERIFY(verifyLayout(Window, "H[V[A,B],C+D]"));
+}
+
+//============================================================================
+void CDockContainerRestoreTests::removeCollapsedSplitter()
+{
+    RestoreWindow Window;
+    const QByteArray Start = state(splitter(Qt::Horizontal, {area({"A"}),
+        splitter(Qt::Vertical, {area({"B"}), splitter(Qt::Horizontal,
+            {area({"C"}), area({"D"})})})}));
+    QVERIFY(Window.DockManager->restoreState(Start));
+    QVERIFY(verifyLayout(Window, "H[A,V[B,H[C,D]]]"));
+    auto DockAreaA = Window.rootSplitter()->widget(0);
+
+    // The nested splitters lose all their dock areas
+    QVERIFY(Window.DockManager->restoreState(state(splitter(Qt::Horizontal,
+        {area({"A"}), area({"B", "C", "D"})}))));
+    QVERIFY(verifyLayout(Window, "H[A,B+C+D]"));
+    QCOMPARE(Window.rootSplitter()->widget(0), DockAreaA);
+
+    QVERIFY(Window.DockManager->restoreState(Start));
+    QVERIFY(verifyLayout(Window, "H[A,V[B,H[C,D]]]"));
+}
+
+//============================================================================
+void CDockContainerRestoreTests::reuseRootSplitterAsChild()
+{
+    // The old root splitter becomes a child of the new root splitter and
+    // is not part of the layout anymore when the new root is installed
+    RestoreWindow Window;
+    const QByteArray Start = state(splitter(Qt::Horizontal,
+        {area({"A"}), area({"B"})}), {"C", "D"});
+    QVERIFY(Window.DockManager->restoreState(Start));
+    QVERIFY(verifyLayout(Window, "H[A,B]"));
+    QCOMPARE(Window.DockManager->floatingWidgets().count(), 1);
+    auto OldRootSplitter = Window.rootSplitter();
+
+    QVERIFY(Window.DockManager->restoreState(state(splitter(Qt::Vertical, {
+        splitter(Qt::Horizontal, {area({"A"}), area({"B"})}),
+        area({"C", "D"})}))));
+    QVERIFY(verifyLayout(Window, "V[H[A,B],C+D]"));
+    QCOMPARE(Window.rootSplitter()->widget(0), OldRootSplitter);
+
+    QVERIFY(Window.DockManager->restoreState(Start));
+    QVERIFY(verifyLayout(Window, "H[A,B]"));
+}
+
+//============================================================================
+void CDockContainerRestoreTests::reuseRootSplitter()
+{
+    RestoreWindow Window;
+    const QByteArray Start = state(splitter(Qt::Horizontal,
+        {area({"A", "B"}), area({"C", "D"})}));
+    QVERIFY(Window.DockManager->restoreState(Start));
+    QVERIFY(verifyLayout(Window, "H[A+B,C+D]"));
+    auto RootSplitter = Window.rootSplitter();
+
+    // Only the sizes change, so the complete tree is reused
+    DockStateNode Resized = splitter(Qt::Horizontal,
+        {area({"A", "B"}), area({"C", "D"})});
+    Resized.Sizes = {300, 100};
+    QVERIFY(Window.DockManager->restoreState(state(Resized)));
+    QVERIFY(verifyLayout(Window, "H[A+B,C+D]"));
+    QCOMPARE(Window.rootSplitter(), RootSplitter);
+}
+
+//---------------------------------------------------------------------------
+// EOF DockContainerRestoreTests.cpp
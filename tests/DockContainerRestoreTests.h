@@ -0,0 +1,32 @@
+#ifndef DockContainerRestoreTestsH
+#define DockContainerRestoreTestsH
+//============================================================================
+/// \file   DockContainerRestoreTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockContainerRestoreTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+/**
+ * QtTest tests for restoring the state of a dock container with reused dock
+ * areas and splitters
+ */
+class CDockContainerRestoreTests : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void cleanup();
+
+    void reuseNestedSplitter();
+    void removeCollapsedSplitter();
+    void reuseRootSplitterAsChild();
+    void reuseRootSplitter();
+};
+
+//---------------------------------------------------------------------------
+#endif  // DockContainerRestoreTestsH
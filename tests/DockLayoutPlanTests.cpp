@@ -0,0 +1,110 @@
+//============================================================================
+/// \file   DockLayoutPlanTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockLayoutPlanTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockLayoutPlanTests.h"
+
+#include <QLabel>
+#include <QMainWindow>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockWidget.h"
+#include "DockingStateBinaryFormat.h"
+#include "DockingStateTestData.h"
+
+using namespace ads;
+
+namespace
+{
+/**
+ * Returns the parsed current state of the given dock manager
+ */
+DockingState currentState(CDockManager* DockManager)
+{
+    DockingState State;
+    CDockingStateBinaryFormat::read(DockManager->saveState(), State);
+    return State;
+}
+}  // namespace
+
+//============================================================================
+void CDockLayoutPlanTests::init()
+{
+    ConfigFlags = CDockManager::configFlags();
+    PerformanceFlags = CDockManager::performanceConfigFlags();
+    CDockManager::setConfigFlag(CDockManager::BinaryStateFormat, true);
+}
+
+//============================================================================
+void CDockLayoutPlanTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setConfigFlags(ConfigFlags);
+    CDockManager::setPerformanceConfigFlags(PerformanceFlags);
+}
+
+//============================================================================
+void CDockLayoutPlanTests::openPerspectiveFromPlan_data()
+{
+    QTest::addColumn<bool>("Pooled");
+    QTest::newRow("cached plan") << false;
+    QTest::newRow("pooled") << true;
+}
+
+//============================================================================
+void CDockLayoutPlanTests::openPerspectiveFromPlan()
+{
+    QFETCH(bool, Pooled);
+    CDockManager::setPerformanceConfigFlag(CDockManager::DeduplicatedPerspectives,
+        Pooled);
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    QList<CDockWidget*> DockWidgets;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(i));
+        DockWidget->setWidget(new QLabel(QString("Content %1").arg(i)));
+        DockManager->addDockWidget(i % 2 ? RightDockWidgetArea
+            : BottomDockWidgetArea, DockWidget);
+        DockWidgets.append(DockWidget);
+    }
+    MainWindow->resize(1000, 800);
+    MainWindow->show();
+
+    // "Snapshot" uses the saved layout as plan, "Data" is parsed from the
+    // state data. Both are pooled if the DeduplicatedPerspectives flag is set
+    DockWidgets[1]->toggleView(false);
+    const QByteArray Data = DockManager->saveState();
+    DockManager->addPerspective("Snapshot");
+    DockManager->addPerspective("Data", Data);
+
+    // The reference layout is restored from the state data
+    DockWidgets[1]->toggleView(true);
+    QVERIFY(DockManager->restoreState(Data));
+    const DockingState Expected = currentState(DockManager);
+    QCOMPARE(Expected.Containers.count(), 1);
+
+    for (const auto& Name : {"Snapshot", "Data"})
+    {
+        DockManager->addDockWidget(TopDockWidgetArea, DockWidgets[2]);
+        DockWidgets[1]->toggleView(true);
+        DockWidgets[3]->toggleView(false);
+        QVERIFY(!equalStates(currentState(DockManager), Expected));
+
+        DockManager->openPerspective(Name);
+        QVERIFY2(equalStates(currentState(DockManager), Expected), Name);
+        QVERIFY(DockWidgets[1]->isClosed());
+        QVERIFY(!DockWidgets[3]->isClosed());
+    }
+}
+
+//---------------------------------------------------------------------------
+// EOF DockLayoutPlanTests.cpp
@@ -0,0 +1,36 @@
+#ifndef DockLayoutPlanTestsH
+#define DockLayoutPlanTestsH
+//============================================================================
+/// \file   DockLayoutPlanTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockLayoutPlanTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest tests for the cached layout plans of the perspectives
+ */
+class CDockLayoutPlanTests : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::ConfigFlags ConfigFlags;
+    ads::CDockManager::PerformanceFlags PerformanceFlags;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void openPerspectiveFromPlan_data();
+    void openPerspectiveFromPlan();
+};
+
+//---------------------------------------------------------------------------
+#endif  // DockLayoutPlanTestsH
@@ -0,0 +1,264 @@
+//============================================================================
+/// \file   DockStatePoolTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockStatePoolTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockStatePoolTests.h"
+
+#include <QLabel>
+#include <QMainWindow>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockStatePool.h"
+#include "DockWidget.h"
+#include "DockingStateTestData.h"
+
+using namespace ads;
+
+namespace
+{
+// Chunks of createDockingState(): the state, two containers, three dock
+// areas and two splitters in the main container and one floating dock area
+const int StateChunkCount = 9;
+
+//============================================================================
+/**
+ * Returns the state of createDockingState() with changed sizes of the
+ * nested splitter. It only differs in the chunks of this splitter, of the
+ * root splitter, of the main container and of the state.
+ */
+DockingState createResizedState()
+{
+    DockingState State = createDockingState();
+    State.Containers[0].RootNode.Children[1].Sizes = {100, 400};
+    return State;
+}
+}  // namespace
+
+//============================================================================
+void CDockStatePoolTests::init()
+{
+    PerformanceFlags = CDockManager::performanceConfigFlags();
+}
+
+//============================================================================
+void CDockStatePoolTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setPerformanceConfigFlags(PerformanceFlags);
+}
+
+//============================================================================
+void CDockStatePoolTests::shareEqualNodes()
+{
+    CDockStatePool Pool;
+    Pool.insert("One", createDockingState(), 1000);
+    QCOMPARE(Pool.chunkCount(), StateChunkCount);
+
+    // An equal state does not add any chunk
+    Pool.insert("Two", createDockingState(), 1000);
+    QCOMPARE(Pool.chunkCount(), StateChunkCount);
+
+    Pool.insert("Three", createResizedState(), 1000);
+    QCOMPARE(Pool.chunkCount(), StateChunkCount + 4);
+    QCOMPARE(Pool.count(), 3);
+    QCOMPARE(Pool.fullSize(), qint64(3000));
+
+    DockingState State;
+    QVERIFY(Pool.state("One", State));
+    QVERIFY(equalStates(State, createDockingState()));
+    QVERIFY(Pool.state("Three", State));
+    QVERIFY(equalStates(State, createResizedState()));
+    QVERIFY(!Pool.state("Four", State));
+}
+
+//============================================================================
+void CDockStatePoolTests::removeState()
+{
+    CDockStatePool Pool;
+    Pool.insert("One", createDockingState(), 1000);
+    Pool.insert("Two", createResizedState(), 1000);
+    Pool.insert("Three", createDockingState(1), 1000);
+    QCOMPARE(Pool.chunkCount(), 2 * StateChunkCount + 4);
+
+    // Replacing a state releases the chunks that are not shared anymore
+    Pool.insert("Three", createDockingState(), 1000);
+    QCOMPARE(Pool.chunkCount(), StateChunkCount + 4);
+
+    QVERIFY(Pool.remove("One"));
+    QVERIFY(!Pool.remove("One"));
+    QCOMPARE(Pool.chunkCount(), StateChunkCount + 4);
+    QVERIFY(Pool.remove("Three"));
+    QCOMPARE(Pool.chunkCount(), StateChunkCount);
+    QCOMPARE(Pool.names(), QStringList({"Two"}));
+
+    DockingState State;
+    QVERIFY(Pool.state("Two", State));
+    QVERIFY(equalStates(State, createResizedState()));
+
+    Pool.clear();
+    QCOMPARE(Pool.count(), 0);
+    QCOMPARE(Pool.chunkCount(), 0);
+    QCOMPARE(Pool.memoryUsage(), qint64(0));
+}
+
+//============================================================================
+void CDockStatePoolTests::cacheData()
+{
+    CDockStatePool Pool;
+    Pool.insert("One", createDockingState(), 1000);
+    const qint64 MemoryUsage = Pool.memoryUsage();
+    Pool.setCachedData("One", QByteArray(100, 'x'));
+    Pool.setCachedData("Two", QByteArray(100, 'x'));
+    QCOMPARE(Pool.cachedData("One"), QByteArray(100, 'x'));
+    QVERIFY(Pool.cachedData("Two").isEmpty());
+    QCOMPARE(Pool.memoryUsage(), MemoryUsage + 100);
+
+    // Replacing the state drops the cached data
+    Pool.insert("One", createResizedState(), 1000);
+    QVERIFY(Pool.cachedData("One").isEmpty());
+}
+
+//============================================================================
+void CDockStatePoolTests::saveAndRestore()
+{
+    CDockStatePool Pool;
+    Pool.insert("One", createDockingState(), 1000);
+    Pool.insert("Two", createResizedState(), 2000);
+    Pool.setCachedData("One", QByteArray(100, 'x'));
+
+    CDockStatePool RestoredPool;
+    RestoredPool.insert("Three", createDockingState(1), 3000);
+    QCOMPARE(Pool.savedSize(), qint64(Pool.save().size()));
+    QVERIFY(RestoredPool.restore(Pool.save()));
+    QCOMPARE(RestoredPool.names(), QStringList({"One", "Two"}));
+    QCOMPARE(RestoredPool.chunkCount(), Pool.chunkCount());
+    QCOMPARE(RestoredPool.fullSize("One"), qint64(1000));
+    QCOMPARE(RestoredPool.fullSize("Two"), qint64(2000));
+    QVERIFY(RestoredPool.cachedData("One").isEmpty());
+
+    DockingState State;
+    QVERIFY(RestoredPool.state("One", State));
+    QVERIFY(equalStates(State, createDockingState()));
+    QVERIFY(RestoredPool.state("Two", State));
+    QVERIFY(equalStates(State, createResizedState()));
+
+    // Removing a restored state needs valid reference counts
+    QVERIFY(RestoredPool.remove("Two"));
+    QCOMPARE(RestoredPool.chunkCount(), StateChunkCount);
+}
+
+//============================================================================
+void CDockStatePoolTests::rejectTruncatedData()
+{
+    CDockStatePool Pool;
+    Pool.insert("One", createDockingState(), 1000);
+    Pool.insert("Two", createResizedState(), 2000);
+    const QByteArray Data = Pool.save();
+
+    // A failed restore keeps the current content of the pool
+    CDockStatePool RestoredPool;
+    RestoredPool.insert("Three", createDockingState(1), 3000);
+    for (int Size = 0; Size < Data.size(); ++Size)
+    {
+        QVERIFY2(!RestoredPool.restore(Data.left(Size)),
+            qPrintable(QString("Size %1").arg(Size)));
+    }
+    QCOMPARE(RestoredPool.names(), QStringList({"Three"}));
+    QCOMPARE(RestoredPool.chunkCount(), StateChunkCount);
+}
+
+//============================================================================
+void CDockStatePoolTests::restoreCorruptedData()
+{
+    // Chunks are rehashed while restoring, so a corrupted chunk is always
+    // rejected. A corrupted name or size may still be restored, but must
+    // never result in a state that references missing chunks.
+    CDockStatePool Pool;
+    Pool.insert("One", createDockingState(), 1000);
+    Pool.insert("Two", createResizedState(), 2000);
+    const QByteArray Data = Pool.save();
+    for (int i = 0; i < Data.size(); ++i)
+    {
+        QByteArray Corrupted = Data;
+        Corrupted[i] = char(Corrupted[i] ^ 0xFF);
+        CDockStatePool RestoredPool;
+        if (!RestoredPool.restore(Corrupted))
+        {
+            QCOMPARE(RestoredPool.count(), 0);
+            continue;
+        }
+
+        QCOMPARE(RestoredPool.count(), 2);
+        for (const auto& Name : RestoredPool.names())
+        {
+            DockingState State;
+            QVERIFY(RestoredPool.state(Name, State));
+        }
+    }
+}
+
+//============================================================================
+void CDockStatePoolTests::loadDeduplicatedPerspectives()
+{
+    CDockManager::setPerformanceConfigFlag(CDockManager::DeduplicatedPerspectives, true);
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    QList<CDockWidget*> DockWidgets;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(i));
+        DockWidget->setWidget(new QLabel(QString("Content %1").arg(i)));
+        DockManager->addDockWidget(i % 2 ? RightDockWidgetArea
+            : BottomDockWidgetArea, DockWidget);
+        DockWidgets.append(DockWidget);
+    }
+    MainWindow->show();
+
+    DockManager->addPerspective("One");
+    DockWidgets[0]->toggleView(false);
+    DockManager->addPerspective("Two");
+    const auto Usage = DockManager->perspectiveStorageUsage();
+    QCOMPARE(Usage.PerspectiveCount, 2);
+    QVERIFY(Usage.UniqueNodeCount > 0);
+    QVERIFY(Usage.FullSize > 0);
+
+    QTemporaryDir Dir;
+    QSettings Settings(Dir.filePath("perspectives.ini"), QSettings::IniFormat);
+    DockManager->savePerspectives(Settings);
+    QVERIFY(Settings.contains("PerspectivePool"));
+
+    DockManager->removePerspectives(DockManager->perspectiveNames());
+    DockManager->loadPerspectives(Settings);
+    QCOMPARE(DockManager->perspectiveNames(), QStringList({"One", "Two"}));
+    DockManager->openPerspective("One");
+    QVERIFY(!DockWidgets[0]->isClosed());
+    DockManager->openPerspective("Two");
+    QVERIFY(DockWidgets[0]->isClosed());
+
+    // Without the flag, all perspectives are written as separate entries
+    // that versions without a perspective pool can read
+    CDockManager::setPerformanceConfigFlag(CDockManager::DeduplicatedPerspectives, false);
+    DockManager->savePerspectives(Settings);
+    QVERIFY(!Settings.contains("PerspectivePool"));
+    QCOMPARE(Settings.beginReadArray("Perspectives"), 2);
+    Settings.endArray();
+
+    // A corrupted pool is ignored
+    Settings.remove("Perspectives");
+    Settings.setValue("PerspectivePool", QByteArray("ADSD corrupted"));
+    DockManager->loadPerspectives(Settings);
+    QVERIFY(DockManager->perspectiveNames().isEmpty());
+}
+
+//---------------------------------------------------------------------------
+// EOF DockStatePoolTests.cpp
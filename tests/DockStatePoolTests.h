@@ -0,0 +1,41 @@
+#ifndef DockStatePoolTestsH
+#define DockStatePoolTestsH
+//============================================================================
+/// \file   DockStatePoolTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockStatePoolTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest tests for the structural sharing, the serialization and the
+ * error handling of the deduplicated perspective pool
+ */
+class CDockStatePoolTests : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::PerformanceFlags PerformanceFlags;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void shareEqualNodes();
+    void removeState();
+    void cacheData();
+    void saveAndRestore();
+    void rejectTruncatedData();
+    void restoreCorruptedData();
+    void loadDeduplicatedPerspectives();
+};
+
+//---------------------------------------------------------------------------
+#endif  // DockStatePoolTestsH
@@ -0,0 +1,151 @@
+//============================================================================
+/// \file   DockingStateBinaryFormatTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockingStateBinaryFormatTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingStateBinaryFormatTests.h"
+
+#include <QLabel>
+#include <QMainWindow>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockWidget.h"
+#include "DockingStateBinaryFormat.h"
+#include "DockingStateTestData.h"
+
+using namespace ads;
+
+//============================================================================
+void CDockingStateBinaryFormatTests::init()
+{
+    ConfigFlags = CDockManager::configFlags();
+    AutoHideFlags = CDockManager::autoHideConfigFlags();
+    // The binary format drops side bars if auto hide is disabled
+    CDockManager::setAutoHideConfigFlags(CDockManager::DefaultAutoHideConfig);
+}
+
+//============================================================================
+void CDockingStateBinaryFormatTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setConfigFlags(ConfigFlags);
+    CDockManager::setAutoHideConfigFlags(AutoHideFlags);
+}
+
+//============================================================================
+void CDockingStateBinaryFormatTests::roundTrip()
+{
+    const DockingState State = createDockingState();
+    const QByteArray Data = CDockingStateBinaryFormat::write(State);
+    QVERIFY(CDockingStateBinaryFormat::isBinaryState(Data));
+
+    DockingState ReadState;
+    QVERIFY(CDockingStateBinaryFormat::read(Data, ReadState));
+    QVERIFY(equalStates(State, ReadState));
+    QCOMPARE(CDockingStateBinaryFormat::write(ReadState), Data);
+}
+
+//============================================================================
+void CDockingStateBinaryFormatTests::rejectXmlState()
+{
+    const QByteArray Xml = "<?xml version=\"1.0\"?><QtAdvancedDockingSystem/>";
+    QVERIFY(!CDockingStateBinaryFormat::isBinaryState(Xml));
+    QVERIFY(!CDockingStateBinaryFormat::isBinaryState(QByteArray("ADS")));
+
+    DockingState State;
+    QVERIFY(!CDockingStateBinaryFormat::read(Xml, State));
+    QVERIFY(!CDockingStateBinaryFormat::read(QByteArray(), State));
+}
+
+//============================================================================
+void CDockingStateBinaryFormatTests::rejectTruncatedState()
+{
+    // Each field is required, so every prefix of a valid state is invalid
+    const QByteArray Data = CDockingStateBinaryFormat::write(createDockingState());
+    for (int Size = 0; Size < Data.size(); ++Size)
+    {
+        DockingState State;
+        QVERIFY2(!CDockingStateBinaryFormat::read(Data.left(Size), State),
+            qPrintable(QString("Size %1").arg(Size)));
+    }
+}
+
+//============================================================================
+void CDockingStateBinaryFormatTests::rejectNewerFormatVersion()
+{
+    // The format version follows the four bytes of the magic number
+    QByteArray Data = CDockingStateBinaryFormat::write(createDockingState());
+    Data[4] = char(CDockingStateBinaryFormat::CurrentFormatVersion + 1);
+    QVERIFY(CDockingStateBinaryFormat::isBinaryState(Data));
+
+    DockingState State;
+    QVERIFY(!CDockingStateBinaryFormat::read(Data, State));
+}
+
+//============================================================================
+void CDockingStateBinaryFormatTests::readCorruptedState()
+{
+    // A corrupted byte may still result in a valid state, but it must never
+    // crash the reader or produce a splitter with mismatching sizes
+    const QByteArray Data = CDockingStateBinaryFormat::write(createDockingState());
+    for (int i = 0; i < Data.size(); ++i)
+    {
+        QByteArray Corrupted = Data;
+        Corrupted[i] = char(Corrupted[i] ^ 0xFF);
+        DockingState State;
+        if (!CDockingStateBinaryFormat::read(Corrupted, State))
+        {
+            continue;
+        }
+
+        for (const auto& Container : State.Containers)
+        {
+            if (Container.HasRootNode
+             && Container.RootNode.Type == DockStateNode::SplitterNode)
+            {
+                QCOMPARE(Container.RootNode.Sizes.count(),
+                    int(Container.RootNode.Children.size()));
+            }
+        }
+    }
+}
+
+//============================================================================
+void CDockingStateBinaryFormatTests::restoreBinaryState()
+{
+    CDockManager::setConfigFlag(CDockManager::BinaryStateFormat, true);
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    QList<CDockWidget*> DockWidgets;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(i));
+        DockWidget->setWidget(new QLabel(QString("Content %1").arg(i)));
+        DockManager->addDockWidget(i % 2 ? RightDockWidgetArea
+            : BottomDockWidgetArea, DockWidget);
+        DockWidgets.append(DockWidget);
+    }
+    MainWindow->show();
+
+    DockWidgets[1]->toggleView(false);
+    const QByteArray Data = DockManager->saveState();
+    QVERIFY(CDockingStateBinaryFormat::isBinaryState(Data));
+
+    DockWidgets[1]->toggleView(true);
+    DockWidgets[2]->toggleView(false);
+    QVERIFY(DockManager->restoreState(Data));
+    QVERIFY(!DockWidgets[0]->isClosed());
+    QVERIFY(DockWidgets[1]->isClosed());
+    QVERIFY(!DockWidgets[2]->isClosed());
+    QVERIFY(!DockWidgets[3]->isClosed());
+}
+
+//---------------------------------------------------------------------------
+// EOF DockingStateBinaryFormatTests.cpp
@@ -0,0 +1,41 @@
+#ifndef DockingStateBinaryFormatTestsH
+#define DockingStateBinaryFormatTestsH
+//============================================================================
+/// \file   DockingStateBinaryFormatTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockingStateBinaryFormatTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest tests for the round trip and for the error handling of the binary
+ * docking state format
+ */
+class CDockingStateBinaryFormatTests : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::ConfigFlags ConfigFlags;
+    ads::CDockManager::AutoHideFlags AutoHideFlags;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void roundTrip();
+    void rejectXmlState();
+    void rejectTruncatedState();
+    void rejectNewerFormatVersion();
+    void readCorruptedState();
+    void restoreBinaryState();
+};
+
+//---------------------------------------------------------------------------
+#endif  // DockingStateBinaryFormatTestsH
@@ -0,0 +1,71 @@
+//============================================================================
+/// \file   DockingStateReaderTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CDockingStateReaderTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingStateReaderTests.h"
+
+#include <QLabel>
+#include <QMainWindow>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockWidget.h"
+
+using namespace ads;
+
+//============================================================================
+void CDockingStateReaderTests::init()
+{
+    ConfigFlags = CDockManager::configFlags();
+    CDockManager::setConfigFlag(CDockManager::XmlCompressionEnabled, false);
+    CDockManager::setConfigFlag(CDockManager::BinaryStateFormat, false);
+}
+
+//============================================================================
+void CDockingStateReaderTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setConfigFlags(ConfigFlags);
+}
+
+//============================================================================
+void CDockingStateReaderTests::rejectInvalidSplitterCount_data()
+{
+    QTest::addColumn<QString>("Count");
+    QTest::newRow("negative") << "-1";
+    QTest::newRow("huge") << "2147483647";
+    QTest::newRow("text") << "two";
+}
+
+//============================================================================
+void CDockingStateReaderTests::rejectInvalidSplitterCount()
+{
+    QFETCH(QString, Count);
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    for (int i = 0; i < 2; ++i)
+    {
+        auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(i));
+        DockWidget->setWidget(new QLabel(QString("Content %1").arg(i)));
+        DockManager->addDockWidget(RightDockWidgetArea, DockWidget);
+    }
+
+    const QByteArray State = DockManager->saveState();
+    QVERIFY(State.contains("Count=\"2\""));
+    QByteArray InvalidState = State;
+    InvalidState.replace("Count=\"2\"", "Count=\"" + Count.toLatin1() + "\"");
+
+    // An invalid state is rejected without changing the layout
+    QVERIFY(!DockManager->restoreState(InvalidState));
+    QCOMPARE(DockManager->saveState(), State);
+}
+
+//---------------------------------------------------------------------------
+// EOF DockingStateReaderTests.cpp
@@ -0,0 +1,35 @@
+#ifndef DockingStateReaderTestsH
+#define DockingStateReaderTestsH
+//============================================================================
+/// \file   DockingStateReaderTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CDockingStateReaderTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest tests for the validation of XML docking states
+ */
+class CDockingStateReaderTests : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::ConfigFlags ConfigFlags;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void rejectInvalidSplitterCount_data();
+    void rejectInvalidSplitterCount();
+};
+
+//---------------------------------------------------------------------------
+#endif  // DockingStateReaderTestsH
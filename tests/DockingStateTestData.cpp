@@ -0,0 +1,172 @@
+//============================================================================
+/// \file   DockingStateTestData.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of the docking states shared by the tests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingStateTestData.h"
+
+using namespace ads;
+
+namespace
+{
+//============================================================================
+DockStateNode createAreaNode(const QString& Prefix, int WidgetCount)
+{
+    DockStateNode Node;
+    Node.Type = DockStateNode::AreaNode;
+    for (int i = 0; i < WidgetCount; ++i)
+    {
+        DockWidgetState WidgetState;
+        WidgetState.Name = QString("%1 Widget %2").arg(Prefix).arg(i);
+        WidgetState.Closed = (i == WidgetCount - 1);
+        Node.DockWidgets.append(WidgetState);
+    }
+    Node.CurrentDockWidget = Node.DockWidgets.first().Name;
+    Node.AllowedAreas = AllDockAreas;
+    Node.Flags = 0;
+    return Node;
+}
+
+//============================================================================
+bool equalWidgets(const QList<DockWidgetState>& Widgets1,
+    const QList<DockWidgetState>& Widgets2)
+{
+    if (Widgets1.count() != Widgets2.count())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < Widgets1.count(); ++i)
+    {
+        if (Widgets1[i].Name != Widgets2[i].Name
+         || Widgets1[i].Closed != Widgets2[i].Closed
+         || Widgets1[i].Size != Widgets2[i].Size)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+//============================================================================
+DockingState createDockingState(int Index)
+{
+    const QString Prefix = QString("State %1").arg(Index);
+    DockingState State;
+    State.Version = 1;
+    State.HasUserVersion = true;
+    State.UserVersion = 42 + Index;
+
+    DockStateNode Vertical;
+    Vertical.Type = DockStateNode::SplitterNode;
+    Vertical.Orientation = Qt::Vertical;
+    Vertical.Children.push_back(createAreaNode(Prefix + " Top", 3));
+    Vertical.Children.push_back(createAreaNode(Prefix + " Bottom", 1));
+    Vertical.Sizes = {300, 200};
+
+    ContainerState Main;
+    Main.HasRootNode = true;
+    Main.RootNode.Type = DockStateNode::SplitterNode;
+    Main.RootNode.Orientation = Qt::Horizontal;
+    Main.RootNode.Children.push_back(createAreaNode(Prefix + " Left", 2));
+    Main.RootNode.Children.push_back(Vertical);
+    Main.RootNode.Sizes = {250, 750};
+
+    SideBarState SideBar;
+    SideBar.Area = SideBarLeft;
+    DockWidgetState AutoHideWidget;
+    AutoHideWidget.Name = Prefix + " Auto Hide Widget";
+    AutoHideWidget.Size = 120;
+    SideBar.DockWidgets.append(AutoHideWidget);
+    Main.SideBars.append(SideBar);
+    State.Containers.append(Main);
+
+    ContainerState Floating;
+    Floating.Floating = true;
+    Floating.Geometry = QByteArray("floating geometry ") + QByteArray::number(Index);
+    Floating.HasRootNode = true;
+    Floating.RootNode = createAreaNode(Prefix + " Floating", 2);
+    State.Containers.append(Floating);
+    return State;
+}
+
+//============================================================================
+bool equalNodes(const DockStateNode& Node1, const DockStateNode& Node2)
+{
+    if (Node1.Type != Node2.Type)
+    {
+        return false;
+    }
+
+    if (Node1.Type == DockStateNode::AreaNode)
+    {
+        return Node1.CurrentDockWidget == Node2.CurrentDockWidget
+            && Node1.AllowedAreas == Node2.AllowedAreas
+            && Node1.Flags == Node2.Flags
+            && equalWidgets(Node1.DockWidgets, Node2.DockWidgets);
+    }
+
+    if (Node1.Orientation != Node2.Orientation || Node1.Sizes != Node2.Sizes
+     || Node1.Children.size() != Node2.Children.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < Node1.Children.size(); ++i)
+    {
+        if (!equalNodes(Node1.Children[i], Node2.Children[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//============================================================================
+bool equalStates(const DockingState& State1, const DockingState& State2)
+{
+    if (State1.Version != State2.Version
+     || State1.HasUserVersion != State2.HasUserVersion
+     || State1.UserVersion != State2.UserVersion
+     || State1.CentralWidget != State2.CentralWidget
+     || State1.Containers.count() != State2.Containers.count())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < State1.Containers.count(); ++i)
+    {
+        const auto& Container1 = State1.Containers[i];
+        const auto& Container2 = State2.Containers[i];
+        if (Container1.Independent != Container2.Independent
+         || Container1.Floating != Container2.Floating
+         || Container1.Geometry != Container2.Geometry
+         || Container1.HasRootNode != Container2.HasRootNode
+         || (Container1.HasRootNode
+             && !equalNodes(Container1.RootNode, Container2.RootNode))
+         || Container1.SideBars.count() != Container2.SideBars.count())
+        {
+            return false;
+        }
+
+        for (int j = 0; j < Container1.SideBars.count(); ++j)
+        {
+            if (Container1.SideBars[j].Area != Container2.SideBars[j].Area
+             || !equalWidgets(Container1.SideBars[j].DockWidgets,
+                    Container2.SideBars[j].DockWidgets))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------
+// EOF DockingStateTestData.cpp
@@ -0,0 +1,34 @@
+#ifndef DockingStateTestDataH
+#define DockingStateTestDataH
+//============================================================================
+/// \file   DockingStateTestData.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of the docking states shared by the tests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockingStateReader.h"
+
+/**
+ * Returns a docking state with a main container that contains nested
+ * splitters, dock areas and an auto hide side bar and with a floating
+ * container. Index is part of the object names, so states with different
+ * indices do not share any names.
+ */
+ads::DockingState createDockingState(int Index = 0);
+
+/**
+ * Returns true, if both dock state nodes and all of their children are equal
+ */
+bool equalNodes(const ads::DockStateNode& Node1, const ads::DockStateNode& Node2);
+
+/**
+ * Returns true, if both docking states are equal
+ */
+bool equalStates(const ads::DockingState& State1, const ads::DockingState& State2);
+
+//---------------------------------------------------------------------------
+#endif  // DockingStateTestDataH
@@ -0,0 +1,287 @@
+//============================================================================
+/// \file   LayoutJournalTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CLayoutJournalTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "LayoutJournalTests.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QLabel>
+#include <QMainWindow>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockWidget.h"
+#include "DockingStateTestData.h"
+#include "LayoutJournal.h"
+
+using namespace ads;
+
+namespace
+{
+//============================================================================
+qint64 fileSize(const QString& FileName)
+{
+    return QFileInfo(FileName).size();
+}
+
+//============================================================================
+/**
+ * Appends records for all mutation types to the given Journal and applies
+ * the same mutations to State
+ */
+void appendRecords(CLayoutJournal& Journal, DockingState& State)
+{
+    const ContainerState Floating = createDockingState(1).Containers[1];
+    Journal.appendContainer(2, Floating);
+    State.Containers.append(Floating);
+
+    Journal.appendSplitterSizes(0, {1}, {100, 400});
+    State.Containers[0].RootNode.Children[1].Sizes = {100, 400};
+
+    const DockStateNode Area = createDockingState(2).Containers[1].RootNode;
+    Journal.appendDockArea(0, {1, 0}, Area);
+    State.Containers[0].RootNode.Children[1].Children[0] = Area;
+
+    Journal.appendRemoveContainer(1);
+    State.Containers.removeAt(1);
+}
+}  // namespace
+
+//============================================================================
+void CLayoutJournalTests::init()
+{
+    AutoHideFlags = CDockManager::autoHideConfigFlags();
+    // The binary snapshot drops side bars if auto hide is disabled
+    CDockManager::setAutoHideConfigFlags(CDockManager::DefaultAutoHideConfig);
+}
+
+//============================================================================
+void CLayoutJournalTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setAutoHideConfigFlags(AutoHideFlags);
+}
+
+//============================================================================
+void CLayoutJournalTests::replaySnapshot()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("layout.adsj");
+    CLayoutJournal Journal;
+    QVERIFY(Journal.open(FileName, createDockingState()));
+    QVERIFY(Journal.isOpen());
+    QCOMPARE(Journal.fileName(), FileName);
+    QCOMPARE(Journal.snapshotSize(), fileSize(FileName));
+    QCOMPARE(Journal.journalSize(), qint64(0));
+
+    DockingState State;
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, createDockingState()));
+}
+
+//============================================================================
+void CLayoutJournalTests::replayRecords()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("layout.adsj");
+    DockingState Expected = createDockingState();
+    CLayoutJournal Journal;
+    QVERIFY(Journal.open(FileName, Expected));
+    appendRecords(Journal, Expected);
+    QVERIFY(Journal.flush());
+    QVERIFY(Journal.journalSize() > 0);
+    QCOMPARE(Journal.snapshotSize() + Journal.journalSize(), fileSize(FileName));
+
+    DockingState State;
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, Expected));
+}
+
+//============================================================================
+void CLayoutJournalTests::writePendingRecordsOnFlush()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("layout.adsj");
+    DockingState Expected = createDockingState();
+    CLayoutJournal Journal;
+    QVERIFY(Journal.open(FileName, Expected));
+    appendRecords(Journal, Expected);
+    QVERIFY(Journal.hasPendingRecords());
+    QCOMPARE(Journal.snapshotSize(), fileSize(FileName));
+
+    DockingState State;
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, createDockingState()));
+
+    // Closing the journal writes the pending records
+    Journal.close();
+    QVERIFY(!Journal.isOpen());
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, Expected));
+}
+
+//============================================================================
+void CLayoutJournalTests::ignoreTornRecord()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("layout.adsj");
+    DockingState Expected = createDockingState();
+    CLayoutJournal Journal;
+    QVERIFY(Journal.open(FileName, Expected));
+    Journal.appendSplitterSizes(0, {}, {400, 600});
+    Expected.Containers[0].RootNode.Sizes = {400, 600};
+    QVERIFY(Journal.flush());
+    const qint64 ValidSize = fileSize(FileName);
+    Journal.appendSplitterSizes(0, {}, {500, 500});
+    Journal.close();
+
+    // Simulate a crash while the last record has been written
+    QFile File(FileName);
+    for (qint64 Size = ValidSize; Size < fileSize(FileName); ++Size)
+    {
+        QFile TornFile(Dir.filePath("torn.adsj"));
+        QVERIFY(File.open(QIODevice::ReadOnly));
+        const QByteArray Data = File.read(Size);
+        File.close();
+        QVERIFY(TornFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        TornFile.write(Data);
+        TornFile.close();
+
+        DockingState State;
+        QVERIFY(CLayoutJournal::replay(TornFile.fileName(), State));
+        QVERIFY2(equalStates(State, Expected),
+            qPrintable(QString("Size %1").arg(Size)));
+    }
+
+    // A corrupted payload of the last record fails the checksum
+    QVERIFY(File.open(QIODevice::ReadWrite));
+    QByteArray Data = File.readAll();
+    Data[Data.size() - 1] = char(Data[Data.size() - 1] ^ 0xFF);
+    QVERIFY(File.seek(0));
+    File.write(Data);
+    File.close();
+
+    DockingState State;
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, Expected));
+}
+
+//============================================================================
+void CLayoutJournalTests::stopAtInvalidRecord()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("layout.adsj");
+    DockingState Expected = createDockingState();
+    CLayoutJournal Journal;
+    QVERIFY(Journal.open(FileName, Expected));
+    Journal.appendSplitterSizes(0, {}, {400, 600});
+    Expected.Containers[0].RootNode.Sizes = {400, 600};
+    // The path of this record addresses a dock area instead of a splitter,
+    // so this record and all following records are ignored
+    Journal.appendSplitterSizes(0, {0}, {100, 100});
+    Journal.appendRemoveContainer(1);
+    QVERIFY(Journal.flush());
+
+    DockingState State;
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, Expected));
+}
+
+//============================================================================
+void CLayoutJournalTests::compact()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("layout.adsj");
+    DockingState Expected = createDockingState();
+    CLayoutJournal Journal;
+    QVERIFY(Journal.open(FileName, Expected));
+    appendRecords(Journal, Expected);
+    QVERIFY(Journal.flush());
+    Journal.appendRemoveContainer(0);
+
+    // Pending records are dropped, because the snapshot replaces them
+    QVERIFY(Journal.compact(Expected));
+    QVERIFY(Journal.isOpen());
+    QVERIFY(!Journal.hasPendingRecords());
+    QCOMPARE(Journal.journalSize(), qint64(0));
+    QCOMPARE(Journal.snapshotSize(), fileSize(FileName));
+
+    DockingState State;
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, Expected));
+
+    // Records are appended to the compacted journal
+    Journal.appendSplitterSizes(0, {}, {400, 600});
+    Expected.Containers[0].RootNode.Sizes = {400, 600};
+    QVERIFY(Journal.flush());
+    QVERIFY(CLayoutJournal::replay(FileName, State));
+    QVERIFY(equalStates(State, Expected));
+}
+
+//============================================================================
+void CLayoutJournalTests::rejectInvalidFile()
+{
+    QTemporaryDir Dir;
+    DockingState State;
+    QVERIFY(!CLayoutJournal::replay(Dir.filePath("missing.adsj"), State));
+
+    const QString FileName = Dir.filePath("layout.adsj");
+    QFile File(FileName);
+    QVERIFY(File.open(QIODevice::WriteOnly));
+    File.write("<?xml version=\"1.0\"?>");
+    File.close();
+    QVERIFY(!CLayoutJournal::replay(FileName, State));
+
+    // A journal without a complete snapshot can not be replayed
+    CLayoutJournal Journal;
+    QVERIFY(Journal.open(FileName, createDockingState()));
+    Journal.close();
+    QVERIFY(File.resize(fileSize(FileName) - 1));
+    QVERIFY(!CLayoutJournal::replay(FileName, State));
+}
+
+//============================================================================
+void CLayoutJournalTests::restoreLayoutJournal()
+{
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    QList<CDockWidget*> DockWidgets;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(i));
+        DockWidget->setWidget(new QLabel(QString("Content %1").arg(i)));
+        DockManager->addDockWidget(i % 2 ? RightDockWidgetArea
+            : BottomDockWidgetArea, DockWidget);
+        DockWidgets.append(DockWidget);
+    }
+    MainWindow->show();
+
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("layout.adsj");
+    QVERIFY(DockManager->openLayoutJournal(FileName));
+    DockWidgets[1]->toggleView(false);
+    QVERIFY(DockManager->flushLayoutJournal());
+    QVERIFY(DockManager->layoutJournal()->journalSize() > 0);
+    DockManager->closeLayoutJournal();
+    QVERIFY(!DockManager->layoutJournal());
+
+    DockWidgets[1]->toggleView(true);
+    DockWidgets[2]->toggleView(false);
+    QVERIFY(DockManager->restoreLayoutJournal(FileName));
+    QVERIFY(!DockWidgets[0]->isClosed());
+    QVERIFY(DockWidgets[1]->isClosed());
+    QVERIFY(!DockWidgets[2]->isClosed());
+    QVERIFY(!DockWidgets[3]->isClosed());
+}
+
+//---------------------------------------------------------------------------
+// EOF LayoutJournalTests.cpp
@@ -0,0 +1,42 @@
+#ifndef LayoutJournalTestsH
+#define LayoutJournalTestsH
+//============================================================================
+/// \file   LayoutJournalTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CLayoutJournalTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest tests for the replay, the compaction and the crash recovery of
+ * the layout journal
+ */
+class CLayoutJournalTests : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::AutoHideFlags AutoHideFlags;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void replaySnapshot();
+    void replayRecords();
+    void writePendingRecordsOnFlush();
+    void ignoreTornRecord();
+    void stopAtInvalidRecord();
+    void compact();
+    void rejectInvalidFile();
+    void restoreLayoutJournal();
+};
+
+//---------------------------------------------------------------------------
+#endif  // LayoutJournalTestsH
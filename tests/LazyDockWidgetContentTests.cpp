@@ -0,0 +1,148 @@
+//============================================================================
+/// \file   LazyDockWidgetContentTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CLazyDockWidgetContentTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "LazyDockWidgetContentTests.h"
+
+#include <QLabel>
+#include <QMainWindow>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockAreaWidget.h"
+#include "DockWidget.h"
+
+using namespace ads;
+
+namespace
+{
+const int AreaCount = 3;
+const int TabsPerArea = 4;
+
+//============================================================================
+/**
+ * Creates a dock widget that creates its content via a widget factory
+ */
+CDockWidget* createFactoryDockWidget(int Index)
+{
+    auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(Index));
+    DockWidget->setWidgetFactory([Index](QWidget* Parent)
+    {
+        return new QLabel(QString("Content %1").arg(Index), Parent);
+    });
+    return DockWidget;
+}
+
+//============================================================================
+/**
+ * Returns a saved state with AreaCount dock areas with TabsPerArea tabs.
+ * The current tab of area i is the tab with index i.
+ */
+QByteArray createTabbedState()
+{
+    QMainWindow MainWindow;
+    auto DockManager = new CDockManager(&MainWindow);
+    for (int i = 0; i < AreaCount; ++i)
+    {
+        CDockAreaWidget* DockArea = nullptr;
+        for (int j = 0; j < TabsPerArea; ++j)
+        {
+            auto DockWidget = new CDockWidget(
+                QString("Dock Widget %1").arg(i * TabsPerArea + j));
+            DockWidget->setWidget(new QLabel(DockWidget->objectName()));
+            if (DockArea)
+            {
+                DockManager->addDockWidgetTabToArea(DockWidget, DockArea);
+            }
+            else
+            {
+                DockArea = DockManager->addDockWidget(RightDockWidgetArea,
+                    DockWidget);
+            }
+        }
+        DockArea->setCurrentIndex(i);
+    }
+    return DockManager->saveState();
+}
+}  // namespace
+
+//============================================================================
+void CLazyDockWidgetContentTests::init()
+{
+    PerformanceFlags = CDockManager::performanceConfigFlags();
+    CDockManager::setPerformanceConfigFlag(CDockManager::LazyDockWidgetContent, true);
+}
+
+//============================================================================
+void CLazyDockWidgetContentTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setPerformanceConfigFlags(PerformanceFlags);
+}
+
+//============================================================================
+void CLazyDockWidgetContentTests::restoreCreatesCurrentContentOnly()
+{
+    const QByteArray State = createTabbedState();
+
+    // Each dock widget gets its own dock area, so nothing is shown before
+    // the state is restored
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    QList<CDockWidget*> DockWidgets;
+    for (int i = 0; i < AreaCount * TabsPerArea; ++i)
+    {
+        auto DockWidget = createFactoryDockWidget(i);
+        DockManager->addDockWidget(BottomDockWidgetArea, DockWidget);
+        DockWidgets.append(DockWidget);
+    }
+
+    QVERIFY(DockManager->restoreState(State));
+    MainWindow->show();
+    for (int i = 0; i < AreaCount; ++i)
+    {
+        for (int j = 0; j < TabsPerArea; ++j)
+        {
+            auto DockWidget = DockWidgets[i * TabsPerArea + j];
+            QVERIFY(!DockWidget->isClosed());
+            QCOMPARE(DockWidget->widget() != nullptr, j == i);
+        }
+    }
+
+    // The content of another tab is created when it becomes current
+    auto DockWidget = DockWidgets[1];
+    DockWidget->dockAreaWidget()->setCurrentDockWidget(DockWidget);
+    QVERIFY(DockWidget->widget());
+}
+
+//============================================================================
+void CLazyDockWidgetContentTests::releaseContentFromEventLoop()
+{
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    DockManager->setLazyContentBudget(0);
+    auto DockWidget1 = createFactoryDockWidget(1);
+    auto DockWidget2 = createFactoryDockWidget(2);
+    auto DockArea = DockManager->addDockWidget(RightDockWidgetArea, DockWidget1);
+    DockManager->addDockWidgetTabToArea(DockWidget2, DockArea);
+    MainWindow->show();
+    DockArea->setCurrentDockWidget(DockWidget1);
+    QVERIFY(DockWidget1->widget());
+
+    // The hidden content is not released while the Hide event is handled
+    DockArea->setCurrentDockWidget(DockWidget2);
+    QVERIFY(DockWidget2->widget());
+    QVERIFY(DockWidget1->widget());
+    QTRY_VERIFY(!DockWidget1->widget());
+    QVERIFY(DockWidget2->widget());
+}
+
+//---------------------------------------------------------------------------
+// EOF LazyDockWidgetContentTests.cpp
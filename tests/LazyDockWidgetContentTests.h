@@ -0,0 +1,36 @@
+#ifndef LazyDockWidgetContentTestsH
+#define LazyDockWidgetContentTestsH
+//============================================================================
+/// \file   LazyDockWidgetContentTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CLazyDockWidgetContentTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest tests for the lazy creation and the release of factory created
+ * dock widget content
+ */
+class CLazyDockWidgetContentTests : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::PerformanceFlags PerformanceFlags;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void restoreCreatesCurrentContentOnly();
+    void releaseContentFromEventLoop();
+};
+
+//---------------------------------------------------------------------------
+#endif  // LazyDockWidgetContentTestsH
@@ -0,0 +1,225 @@
+//============================================================================
+/// \file   PerspectiveStoreTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CPerspectiveStoreTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "PerspectiveStoreTests.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QLabel>
+#include <QMainWindow>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockManager.h"
+#include "DockWidget.h"
+#include "PerspectiveStore.h"
+
+using namespace ads;
+
+namespace
+{
+//============================================================================
+QByteArray perspectiveData(int Index, int Size = 1024)
+{
+    return QByteArray(Size, char('a' + Index % 26));
+}
+
+//============================================================================
+qint64 fileSize(const QString& FileName)
+{
+    return QFileInfo(FileName).size();
+}
+}  // namespace
+
+//============================================================================
+void CPerspectiveStoreTests::writeAndRead()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("perspectives.adsp");
+    {
+        CPerspectiveStore Store;
+        QVERIFY(Store.open(FileName));
+        QVERIFY(Store.isOpen());
+        QVERIFY(Store.names().isEmpty());
+        QVERIFY(Store.write("One", perspectiveData(1)));
+        QVERIFY(Store.write("Two", perspectiveData(2)));
+        QVERIFY(Store.write("One", perspectiveData(3, 100)));
+        QCOMPARE(Store.read("One"), perspectiveData(3, 100));
+        QCOMPARE(Store.read("Two"), perspectiveData(2));
+        QVERIFY(Store.read("Three").isEmpty());
+        QCOMPARE(Store.fileSize(), fileSize(FileName));
+    }
+
+    CPerspectiveStore Store;
+    QVERIFY(Store.open(FileName));
+    QCOMPARE(Store.names(), QStringList({"One", "Two"}));
+    QCOMPARE(Store.read("One"), perspectiveData(3, 100));
+    QCOMPARE(Store.read("Two"), perspectiveData(2));
+    QVERIFY(Store.unusedSize() > 0);
+}
+
+//============================================================================
+void CPerspectiveStoreTests::skipUnchangedWrite()
+{
+    QTemporaryDir Dir;
+    CPerspectiveStore Store;
+    QVERIFY(Store.open(Dir.filePath("perspectives.adsp")));
+    QVERIFY(Store.write("One", perspectiveData(1)));
+    const qint64 Size = Store.fileSize();
+    QVERIFY(Store.write("One", perspectiveData(1)));
+    QCOMPARE(Store.fileSize(), Size);
+    QCOMPARE(Store.unusedSize(), qint64(0));
+}
+
+//============================================================================
+void CPerspectiveStoreTests::removePerspective()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("perspectives.adsp");
+    {
+        CPerspectiveStore Store;
+        QVERIFY(Store.open(FileName));
+        QVERIFY(Store.write("One", perspectiveData(1)));
+        QVERIFY(Store.write("Two", perspectiveData(2)));
+        QVERIFY(Store.remove("One"));
+        QVERIFY(!Store.remove("One"));
+        QVERIFY(!Store.contains("One"));
+        QVERIFY(Store.read("One").isEmpty());
+    }
+
+    CPerspectiveStore Store;
+    QVERIFY(Store.open(FileName));
+    QCOMPARE(Store.names(), QStringList({"Two"}));
+    QCOMPARE(Store.read("Two"), perspectiveData(2));
+}
+
+//============================================================================
+void CPerspectiveStoreTests::compact()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("perspectives.adsp");
+    CPerspectiveStore Store;
+    QVERIFY(Store.open(FileName));
+    QVERIFY(Store.write("Removed", perspectiveData(0)));
+    for (int i = 0; i < 5; ++i)
+    {
+        QVERIFY(Store.write("One", perspectiveData(i)));
+        QVERIFY(Store.write("Two", perspectiveData(i + 10)));
+    }
+    QVERIFY(Store.remove("Removed"));
+
+    const qint64 UsedSize = Store.fileSize() - Store.unusedSize();
+    QVERIFY(Store.compact());
+    QVERIFY(Store.isOpen());
+    QCOMPARE(Store.unusedSize(), qint64(0));
+    QCOMPARE(Store.fileSize(), UsedSize);
+    QCOMPARE(fileSize(FileName), UsedSize);
+    QCOMPARE(Store.names(), QStringList({"One", "Two"}));
+    QCOMPARE(Store.read("One"), perspectiveData(4));
+    QCOMPARE(Store.read("Two"), perspectiveData(14));
+
+    // The store stays usable after the file has been replaced
+    QVERIFY(Store.write("Three", perspectiveData(3)));
+    Store.close();
+    QVERIFY(Store.open(FileName));
+    QCOMPARE(Store.names(), QStringList({"One", "Three", "Two"}));
+    QCOMPARE(Store.read("Three"), perspectiveData(3));
+}
+
+//============================================================================
+void CPerspectiveStoreTests::ignoreTruncatedRecord()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("perspectives.adsp");
+    {
+        CPerspectiveStore Store;
+        QVERIFY(Store.open(FileName));
+        QVERIFY(Store.write("One", perspectiveData(1)));
+        QVERIFY(Store.write("Two", perspectiveData(2)));
+    }
+
+    // Simulate a crash while the last record has been written
+    QFile File(FileName);
+    QVERIFY(File.resize(fileSize(FileName) - 10));
+
+    CPerspectiveStore Store;
+    QVERIFY(Store.open(FileName));
+    QCOMPARE(Store.names(), QStringList({"One"}));
+    QCOMPARE(Store.read("One"), perspectiveData(1));
+    QVERIFY(Store.fileSize() < fileSize(FileName));
+
+    // The next write replaces the incomplete record
+    QVERIFY(Store.write("Three", perspectiveData(3)));
+    QCOMPARE(Store.fileSize(), fileSize(FileName));
+    Store.close();
+    QVERIFY(Store.open(FileName));
+    QCOMPARE(Store.names(), QStringList({"One", "Three"}));
+    QCOMPARE(Store.read("Three"), perspectiveData(3));
+}
+
+//============================================================================
+void CPerspectiveStoreTests::rejectInvalidFile()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("perspectives.adsp");
+    QFile File(FileName);
+    QVERIFY(File.open(QIODevice::WriteOnly));
+    File.write("<?xml version=\"1.0\"?>");
+    File.close();
+
+    CPerspectiveStore Store;
+    QVERIFY(!Store.open(FileName));
+    QVERIFY(!Store.isOpen());
+    QVERIFY(!Store.write("One", perspectiveData(1)));
+    QCOMPARE(fileSize(FileName), qint64(21));
+}
+
+//============================================================================
+void CPerspectiveStoreTests::lockOpenFile()
+{
+    QTemporaryDir Dir;
+    const QString FileName = Dir.filePath("perspectives.adsp");
+    CPerspectiveStore Store1;
+    CPerspectiveStore Store2;
+    QVERIFY(Store1.open(FileName));
+    QVERIFY(!Store2.open(FileName));
+    QVERIFY(!Store2.isOpen());
+
+    Store1.close();
+    QVERIFY(Store2.open(FileName));
+    QVERIFY(!Store1.open(FileName));
+}
+
+//============================================================================
+void CPerspectiveStoreTests::readPerspectiveData()
+{
+    QTemporaryDir Dir;
+    std::unique_ptr<QMainWindow> MainWindow(new QMainWindow());
+    auto DockManager = new CDockManager(MainWindow.get());
+    auto DockWidget = new CDockWidget("Dock Widget");
+    DockWidget->setWidget(new QLabel("Content"));
+    DockManager->addDockWidget(LeftDockWidgetArea, DockWidget);
+    DockManager->addPerspective("One", perspectiveData(1));
+    DockManager->addPerspective("Two", perspectiveData(2));
+
+    // The perspectives are moved into the store and read one by one
+    QVERIFY(DockManager->openPerspectiveStore(Dir.filePath("perspectives.adsp")));
+    QCOMPARE(DockManager->perspectiveNames(), QStringList({"One", "Two"}));
+    QCOMPARE(DockManager->perspectiveData("One"), perspectiveData(1));
+    QCOMPARE(DockManager->perspectiveData("Two"), perspectiveData(2));
+    QVERIFY(DockManager->perspectiveData("Three").isEmpty());
+    QCOMPARE(DockManager->perspectives().value("Two"), perspectiveData(2));
+    DockManager->closePerspectiveStore();
+}
+
+//---------------------------------------------------------------------------
+// EOF PerspectiveStoreTests.cpp
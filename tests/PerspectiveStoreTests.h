@@ -0,0 +1,34 @@
+#ifndef PerspectiveStoreTestsH
+#define PerspectiveStoreTestsH
+//============================================================================
+/// \file   PerspectiveStoreTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CPerspectiveStoreTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+/**
+ * QtTest tests for the file format, the compaction, the recovery and the
+ * locking of the perspective store and for its use in the dock manager
+ */
+class CPerspectiveStoreTests : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void writeAndRead();
+    void skipUnchangedWrite();
+    void removePerspective();
+    void compact();
+    void ignoreTruncatedRecord();
+    void rejectInvalidFile();
+    void lockOpenFile();
+    void readPerspectiveData();
+};
+
+//---------------------------------------------------------------------------
+#endif  // PerspectiveStoreTestsH
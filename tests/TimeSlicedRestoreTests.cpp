@@ -0,0 +1,175 @@
+//============================================================================
+/// \file   TimeSlicedRestoreTests.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Implementation of CTimeSlicedRestoreTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "TimeSlicedRestoreTests.h"
+
+#include <QLabel>
+#include <QMainWindow>
+#include <QSignalSpy>
+#include <QtTest>
+
+#include <memory>
+
+#include "DockWidget.h"
+#include "DockingStateBinaryFormat.h"
+#include "DockingStateTestData.h"
+
+using namespace ads;
+
+namespace
+{
+/**
+ * Main window with a dock manager and four dock widgets
+ */
+struct RestoreWindow
+{
+    std::unique_ptr<QMainWindow> MainWindow;
+    CDockManager* DockManager = nullptr;
+    QList<CDockWidget*> DockWidgets;
+
+    RestoreWindow() : MainWindow(new QMainWindow())
+    {
+        DockManager = new CDockManager(MainWindow.get());
+        for (int i = 0; i < 4; ++i)
+        {
+            auto DockWidget = new CDockWidget(QString("Dock Widget %1").arg(i));
+            DockWidget->setWidget(new QLabel(QString("Content %1").arg(i)));
+            DockManager->addDockWidget(i % 2 ? RightDockWidgetArea
+                : BottomDockWidgetArea, DockWidget);
+            DockWidgets.append(DockWidget);
+        }
+        MainWindow->resize(1000, 800);
+        MainWindow->show();
+    }
+
+    /**
+     * Changes the layout, so that it differs from the saved layout
+     */
+    void changeLayout()
+    {
+        DockManager->addDockWidget(TopDockWidgetArea, DockWidgets[2]);
+        DockWidgets[1]->toggleView(true);
+        DockWidgets[3]->toggleView(false);
+    }
+};
+
+//============================================================================
+/**
+ * Clears the splitter sizes of the given node and all its children.
+ * The sizes depend on the pending layout requests of the splitters and not
+ * on the restored state.
+ */
+void clearSizes(DockStateNode& Node)
+{
+    Node.Sizes.clear();
+    for (auto& Child : Node.Children)
+    {
+        clearSizes(Child);
+    }
+}
+
+//============================================================================
+/**
+ * Returns the parsed state data without the splitter sizes
+ */
+DockingState layout(const QByteArray& Data)
+{
+    DockingState State;
+    CDockingStateBinaryFormat::read(Data, State);
+    for (auto& Container : State.Containers)
+    {
+        clearSizes(Container.RootNode);
+    }
+    return State;
+}
+}  // namespace
+
+//============================================================================
+void CTimeSlicedRestoreTests::init()
+{
+    ConfigFlags = CDockManager::configFlags();
+    CDockManager::setConfigFlag(CDockManager::BinaryStateFormat, true);
+}
+
+//============================================================================
+void CTimeSlicedRestoreTests::cleanup()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    CDockManager::setConfigFlags(ConfigFlags);
+}
+
+//============================================================================
+void CTimeSlicedRestoreTests::restoreSameLayout()
+{
+    RestoreWindow Window;
+    auto DockManager = Window.DockManager;
+    Window.DockWidgets[1]->toggleView(false);
+    const QByteArray Data = DockManager->saveState();
+
+    Window.changeLayout();
+    QVERIFY(DockManager->restoreState(Data));
+    const DockingState Expected = layout(DockManager->saveState());
+
+    // A time slice of 0 runs a single restore step per event loop iteration
+    Window.changeLayout();
+    QVERIFY(!equalStates(layout(DockManager->saveState()), Expected));
+    DockManager->setRestoreTimeSlice(0);
+    QSignalSpy RestoredSpy(DockManager, &CDockManager::stateRestored);
+    QSignalSpy ProgressSpy(DockManager, &CDockManager::stateRestoreProgress);
+    QVERIFY(DockManager->restoreStateTimeSliced(Data));
+    QVERIFY(RestoredSpy.wait(5000));
+    QVERIFY(ProgressSpy.count() > 2);
+    QVERIFY(equalStates(layout(DockManager->saveState()), Expected));
+    QVERIFY(Window.DockWidgets[1]->isClosed());
+    QVERIFY(!Window.DockWidgets[3]->isClosed());
+}
+
+//============================================================================
+void CTimeSlicedRestoreTests::rejectSaveAndRestoreWhileRunning()
+{
+    RestoreWindow Window;
+    auto DockManager = Window.DockManager;
+    Window.DockWidgets[1]->toggleView(false);
+    const QByteArray Data = DockManager->saveState();
+    DockManager->addPerspective("Saved");
+    Window.changeLayout();
+
+    DockManager->setRestoreTimeSlice(0);
+    QSignalSpy RestoredSpy(DockManager, &CDockManager::stateRestored);
+    QSignalSpy OpenedSpy(DockManager, &CDockManager::perspectiveOpened);
+    QVERIFY(DockManager->restoreStateTimeSliced(Data));
+    QVERIFY(DockManager->isRestoringState());
+
+    // The partially restored layout can not be saved and a second restore
+    // is rejected
+    QVERIFY(DockManager->saveState().isEmpty());
+    QVERIFY(!DockManager->restoreState(Data));
+    QVERIFY(!DockManager->restoreStateTimeSliced(Data));
+    DockManager->openPerspective("Saved");
+    QCOMPARE(OpenedSpy.count(), 0);
+    DockManager->addPerspective("Partial");
+    QVERIFY(!DockManager->perspectiveNames().contains("Partial"));
+
+    // The asynchronous save takes its snapshot after the restore
+    QByteArray AsyncData;
+    DockManager->saveStateAsync([&AsyncData](const QByteArray& State)
+    {
+        AsyncData = State;
+    });
+
+    QVERIFY(RestoredSpy.wait(5000));
+    QCOMPARE(RestoredSpy.count(), 1);
+    QVERIFY(!DockManager->isRestoringState());
+    QTRY_VERIFY(!AsyncData.isEmpty());
+    QVERIFY(equalStates(layout(AsyncData), layout(DockManager->saveState())));
+}
+
+//---------------------------------------------------------------------------
+// EOF TimeSlicedRestoreTests.cpp
@@ -0,0 +1,35 @@
+#ifndef TimeSlicedRestoreTestsH
+#define TimeSlicedRestoreTestsH
+//============================================================================
+/// \file   TimeSlicedRestoreTests.h
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Declaration of CTimeSlicedRestoreTests
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "DockManager.h"
+
+/**
+ * QtTest tests for restoring the state in time slices
+ */
+class CTimeSlicedRestoreTests : public QObject
+{
+    Q_OBJECT
+private:
+    ads::CDockManager::ConfigFlags ConfigFlags;
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void restoreSameLayout();
+    void rejectSaveAndRestoreWhileRunning();
+};
+
+//---------------------------------------------------------------------------
+#endif  // TimeSlicedRestoreTestsH
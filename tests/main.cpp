@@ -0,0 +1,65 @@
+//============================================================================
+/// \file   main.cpp
+/// \author ADS contributors
+/// \date   16.10.2026
+/// \brief  Runs the tests of the docking system
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QApplication>
+#include <QtTest>
+
+#include "DockContainerRestoreTests.h"
+#include "DockLayoutPlanTests.h"
+#include "DockStatePoolTests.h"
+#include "DockingStateBinaryFormatTests.h"
+#include "DockingStateReaderTests.h"
+#include "LayoutJournalTests.h"
+#include "LazyDockWidgetContentTests.h"
+#include "PerspectiveStoreTests.h"
+#include "TimeSlicedRestoreTests.h"
+
+//============================================================================
+/**
+ * Runs the tests of the given test class and returns the number of failed
+ * tests
+ */
+template <class TestClass>
+static int runTests(int argc, char* argv[])
+{
+    TestClass Tests;
+    return QTest::qExec(&Tests, argc, argv);
+}
+
+//============================================================================
+/**
+ * Usage: ads_tests [QtTest options]
+ * The options are passed to each test class.
+ */
+int main(int argc, char* argv[])
+{
+    // Run headless by default, so the tests also run on CI machines
+    // without a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication App(argc, argv);
+
+    int FailedCount = 0;
+    FailedCount += runTests<CDockingStateBinaryFormatTests>(argc, argv);
+    FailedCount += runTests<CDockingStateReaderTests>(argc, argv);
+    FailedCount += runTests<CPerspectiveStoreTests>(argc, argv);
+    FailedCount += runTests<CDockStatePoolTests>(argc, argv);
+    FailedCount += runTests<CLayoutJournalTests>(argc, argv);
+    FailedCount += runTests<CLazyDockWidgetContentTests>(argc, argv);
+    FailedCount += runTests<CDockContainerRestoreTests>(argc, argv);
+    FailedCount += runTests<CDockLayoutPlanTests>(argc, argv);
+    FailedCount += runTests<CTimeSlicedRestoreTests>(argc, argv);
+    return FailedCount ? 1 : 0;
+}
+
+//---------------------------------------------------------------------------
+// EOF main.cpp